@@ -12,7 +12,8 @@ IFS=$'\n\t'
 # the build artifacts into the `poco_bin` directory.
 #
 # Usage:
-#   ./make_poco.sh [--clean] [--build-type Release|Debug] [--generator <CMakeGenerator>] [--jobs N] [--sanitize]
+#   ./make_poco.sh [--clean] [--build-type Release|Debug] [--generator <CMakeGenerator>] [--jobs N] [--sanitize | --tsan]
+#                  [--pgo [--march ARCH] [--pgo-compare]]
 #
 # Notes:
 # - This script attempts to enable all known Poco components via CMake flags.
@@ -28,6 +29,20 @@ IFS=$'\n\t'
 #   (UBSAN) are enabled. This is useful for detecting memory errors and undefined
 #   behavior, but increases build time and binary size. It's recommended to use
 #   --build-type Debug with --sanitize for best results.
+# - When using --tsan, ThreadSanitizer (TSAN) is enabled instead. TSAN cannot
+#   be combined with ASAN, so --tsan and --sanitize are mutually exclusive.
+#   Use it together with the bench_json_mt_tsan target (configure the app
+#   with -DPOCO_TEST_TSAN=ON) to check concurrent parse/stringify.
+# - --pgo builds an optimized Release in three steps: Poco instrumented with
+#   -fprofile-generate, a JSON training run (test_example, bench_json,
+#   bench_json_mt and bench_http of this repo, built against the
+#   instrumented libraries) and a rebuild with -fprofile-use plus LTO.
+#   Profiles and the training build live in `poco_pgo`. GCC and Clang are
+#   supported; Clang additionally needs llvm-profdata (or $LLVM_PROFDATA).
+#   Boost must already be built (./make_boost.sh), since the training run
+#   builds the test app. --march ARCH adds -march=ARCH to both builds.
+#   --pgo-compare first builds and benchmarks a plain Release and writes a
+#   before/after table of bench_json throughput to poco_pgo/compare.txt.
 
 SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
 POCO_SRC_DIR="${SCRIPT_DIR}/poco"
@@ -39,6 +54,11 @@ BUILD_TYPE="Release"
 GENERATOR=""
 JOBS=""
 SANITIZE=0
+TSAN=0
+PGO=0
+PGO_COMPARE=0
+MARCH=""
+PGO_DIR="${SCRIPT_DIR}/poco_pgo"
 
 while [[ $# -gt 0 ]]; do
   case "$1" in
@@ -62,6 +82,23 @@ while [[ $# -gt 0 ]]; do
       SANITIZE=1
       shift
       ;;
+    --tsan)
+      TSAN=1
+      shift
+      ;;
+    --pgo)
+      PGO=1
+      shift
+      ;;
+    --pgo-compare)
+      PGO=1
+      PGO_COMPARE=1
+      shift
+      ;;
+    --march)
+      MARCH="${2:-}"
+      shift 2
+      ;;
     *)
       echo "Unknown option: $1" >&2
       exit 1
@@ -75,9 +112,24 @@ if [[ ! -d "${POCO_SRC_DIR}" ]]; then
   exit 1
 fi
 
+if [[ ${SANITIZE} -eq 1 ]] && [[ ${TSAN} -eq 1 ]]; then
+  echo "Error: --sanitize (ASAN+UBSAN) and --tsan cannot be used together." >&2
+  exit 1
+fi
+
+if [[ ${PGO} -eq 1 ]] && { [[ ${SANITIZE} -eq 1 ]] || [[ ${TSAN} -eq 1 ]]; }; then
+  echo "Error: --pgo cannot be combined with --sanitize or --tsan." >&2
+  exit 1
+fi
+
+if [[ ${PGO} -eq 1 ]] && [[ "${BUILD_TYPE}" != "Release" ]]; then
+  echo "Warning: --pgo always builds Release; ignoring --build-type ${BUILD_TYPE}."
+  BUILD_TYPE="Release"
+fi
+
 if [[ ${CLEAN} -eq 1 ]]; then
   echo "Cleaning previous build and install directories..."
-  rm -rf "${BUILD_DIR}" "${INSTALL_DIR}"
+  rm -rf "${BUILD_DIR}" "${INSTALL_DIR}" "${PGO_DIR}"
 fi
 
 mkdir -p "${BUILD_DIR}" "${INSTALL_DIR}"
@@ -98,6 +150,9 @@ fi
 if [[ ${SANITIZE} -eq 1 ]] && [[ "${BUILD_TYPE}" == "Release" ]]; then
   echo "Warning: Sanitizers work best with Debug build. Consider using --build-type Debug with --sanitize."
 fi
+if [[ ${TSAN} -eq 1 ]] && [[ "${BUILD_TYPE}" == "Release" ]]; then
+  echo "Warning: Sanitizers work best with Debug build. Consider using --build-type Debug with --tsan."
+fi
 
 SANITIZE_FLAGS=""
 if [[ ${SANITIZE} -eq 1 ]]; then
@@ -108,6 +163,13 @@ if [[ ${SANITIZE} -eq 1 ]]; then
   # -g: Include debug information (required for meaningful sanitizer output)
   SANITIZE_FLAGS="-fsanitize=address -fsanitize=undefined -fno-omit-frame-pointer -g"
   echo "Configuring Poco (BUILD_TYPE=${BUILD_TYPE}, JOBS=${JOBS}, SANITIZE=ASAN+UBSAN)..."
+elif [[ ${TSAN} -eq 1 ]]; then
+  # Enable ThreadSanitizer
+  # -fsanitize=thread: Enable ThreadSanitizer (detects data races)
+  # -fno-omit-frame-pointer: Keep frame pointers for better stack traces
+  # -g: Include debug information (required for meaningful sanitizer output)
+  SANITIZE_FLAGS="-fsanitize=thread -fno-omit-frame-pointer -g"
+  echo "Configuring Poco (BUILD_TYPE=${BUILD_TYPE}, JOBS=${JOBS}, SANITIZE=TSAN)..."
 else
   echo "Configuring Poco (BUILD_TYPE=${BUILD_TYPE}, JOBS=${JOBS})..."
 fi
@@ -124,17 +186,6 @@ CMAKE_OPTS=(
   -DENABLE_SAMPLES=OFF
 )
 
-# Add sanitizer flags if enabled
-if [[ ${SANITIZE} -eq 1 ]]; then
-  # Append sanitizer flags to CMAKE_CXX_FLAGS
-  # This ensures all targets are built with sanitizers
-  CMAKE_OPTS+=(-DCMAKE_CXX_FLAGS="${SANITIZE_FLAGS}")
-  CMAKE_OPTS+=(-DCMAKE_C_FLAGS="${SANITIZE_FLAGS}")
-  # Also set linker flags for sanitizers
-  CMAKE_OPTS+=(-DCMAKE_EXE_LINKER_FLAGS="${SANITIZE_FLAGS}")
-  CMAKE_OPTS+=(-DCMAKE_SHARED_LINKER_FLAGS="${SANITIZE_FLAGS}")
-fi
-
 # Attempt to enable all known Poco components. Adjust as needed if configuration fails.
 CMAKE_ENABLE_ALL=(
   -DPOCO_ENABLE_FOUNDATION=ON
@@ -172,32 +223,165 @@ else
   CMAKE_GEN=()
 fi
 
-cmake "${CMAKE_OPTS[@]}" "${CMAKE_ENABLE_ALL[@]}" "${CMAKE_GEN[@]}"
+# Configures, builds and installs Poco into INSTALL_DIR.
+# $1 - compiler flags, $2 - linker flags, the rest - extra CMake options.
+# Empty flags are not passed as empty values: their cache entries are removed
+# instead, so CMake takes them from CXXFLAGS/CFLAGS/LDFLAGS again and a
+# reconfigure of the same build directory (the PGO steps) does not keep flags
+# of the previous step.
+build_poco() {
+  local flags="$1"
+  local link_flags="$2"
+  shift 2
+
+  local flag_opts=()
+  if [[ -n "${flags}" ]]; then
+    flag_opts+=(-DCMAKE_CXX_FLAGS="${flags}" -DCMAKE_C_FLAGS="${flags}")
+  else
+    flag_opts+=(-UCMAKE_CXX_FLAGS -UCMAKE_C_FLAGS)
+  fi
+  if [[ -n "${link_flags}" ]]; then
+    flag_opts+=(-DCMAKE_EXE_LINKER_FLAGS="${link_flags}" -DCMAKE_SHARED_LINKER_FLAGS="${link_flags}")
+  else
+    flag_opts+=(-UCMAKE_EXE_LINKER_FLAGS -UCMAKE_SHARED_LINKER_FLAGS)
+  fi
+
+  cmake "${CMAKE_OPTS[@]}" "${CMAKE_ENABLE_ALL[@]}" "${CMAKE_GEN[@]}" \
+    "${flag_opts[@]}" \
+    "$@"
+
+  echo "Building Poco..."
+
+  # Detect if generator is multi-config (e.g., Visual Studio). If so, pass --config.
+  local generator_name
+  generator_name=$(cmake -B "${BUILD_DIR}" -LA 2>/dev/null | sed -n 's/^CMAKE_GENERATOR:INTERNAL=//p' || true)
+  if [[ -z "${generator_name}" && -f "${BUILD_DIR}/CMakeCache.txt" ]]; then
+    generator_name=$(sed -n 's/^CMAKE_GENERATOR:INTERNAL=//p' "${BUILD_DIR}/CMakeCache.txt" || true)
+  fi
+
+  local build_args=(--build "${BUILD_DIR}" --parallel "${JOBS}")
+  local install_args=(--target install)
+
+  case "${generator_name}" in
+    *"Visual Studio"*|*"Xcode"*)
+      build_args+=(--config "${BUILD_TYPE}")
+      ;;
+    *)
+      : # single-config generators do not need --config
+      ;;
+  esac
+
+  cmake "${build_args[@]}"
+  cmake "${build_args[@]}" "${install_args[@]}"
+}
+
+# Builds the test app against the Poco currently installed in INSTALL_DIR
+build_app() {
+  cmake -S "${SCRIPT_DIR}" -B "${PGO_DIR}/build_app" -DCMAKE_BUILD_TYPE=Release "${CMAKE_GEN[@]}"
+  cmake --build "${PGO_DIR}/build_app" --parallel "${JOBS}" \
+    --target test_example bench_json bench_json_mt bench_http
+}
 
-echo "Building Poco..."
+# JSON training workload for the instrumented libraries: the unit tests and
+# short runs of the benchmarks (parse, stringify, query, projection,
+# templates, multi-threaded use and the HTTP echo service)
+run_training() {
+  local bin="${PGO_DIR}/build_app/test"
+  local out="${PGO_DIR}/training"
+  mkdir -p "${out}"
+  (
+    cd "${out}"
+    "${bin}/test_example" --log_level=nothing --report_level=no
+    "${bin}/bench_json" --quick --output "${out}/bench_json.tsv" >/dev/null
+    "${bin}/bench_json_mt" --quick --threads 2 --output "${out}/bench_json_mt.tsv" >/dev/null
+    "${bin}/bench_http" --quick --server-threads 2 --requests 100 --output "${out}/bench_http.tsv" >/dev/null
+  )
+}
 
-# Detect if generator is multi-config (e.g., Visual Studio). If so, pass --config.
-GENERATOR_NAME=$(cmake -B "${BUILD_DIR}" -LA 2>/dev/null | sed -n 's/^CMAKE_GENERATOR:INTERNAL=//p' || true)
-if [[ -z "${GENERATOR_NAME}" && -f "${BUILD_DIR}/CMakeCache.txt" ]]; then
-  GENERATOR_NAME=$(sed -n 's/^CMAKE_GENERATOR:INTERNAL=//p' "${BUILD_DIR}/CMakeCache.txt" || true)
+# Runs bench_json on the installed Poco and stores its TSV report in $1
+run_bench() {
+  build_app
+  echo "Running bench_json into $1..."
+  "${PGO_DIR}/build_app/test/bench_json" --output "$1" >/dev/null
+}
+
+# Per-case throughput of the plain and the PGO+LTO build
+write_comparison() {
+  # Columns of bench_json output: name bytes iterations mb_per_s ...
+  awk -F '\t' '
+    FNR == 1 { next }
+    NR == FNR { before[$1] = $4; next }
+    ($1 in before) {
+      change = before[$1] > 0 ? ($4 / before[$1] - 1) * 100 : 0
+      printf "%-40s %12.2f %12.2f %+9.1f%%\n", $1, before[$1], $4, change
+    }
+  ' "${PGO_DIR}/bench_before.tsv" "${PGO_DIR}/bench_after.tsv" > "${PGO_DIR}/compare.body"
+  {
+    printf '%-40s %12s %12s %10s\n' "case" "before MB/s" "after MB/s" "change"
+    cat "${PGO_DIR}/compare.body"
+  } > "${PGO_DIR}/compare.txt"
+  rm -f "${PGO_DIR}/compare.body"
+  cat "${PGO_DIR}/compare.txt"
+}
+
+if [[ ${PGO} -eq 0 ]]; then
+  build_poco "${SANITIZE_FLAGS}" "${SANITIZE_FLAGS}" -DCMAKE_INTERPROCEDURAL_OPTIMIZATION=OFF
+  echo "Poco installed to: ${INSTALL_DIR}"
+  echo "Done."
+  exit 0
 fi
 
-BUILD_ARGS=(--build "${BUILD_DIR}" --parallel "${JOBS}")
-INSTALL_ARGS=(--target install)
+# Profile-guided build. GCC writes one .gcda per object file into
+# PROFILE_DIR, named after the object path, so all steps reuse the same
+# build directory; Clang writes .profraw files that are merged into one
+# .profdata.
+CXX_COMPILER="${CXX:-c++}"
+PROFILE_DIR="${PGO_DIR}/profile"
+ARCH_FLAGS=""
+if [[ -n "${MARCH}" ]]; then
+  ARCH_FLAGS="-march=${MARCH}"
+fi
 
-case "${GENERATOR_NAME}" in
-  *"Visual Studio"*|*"Xcode"*)
-    BUILD_ARGS+=(--config "${BUILD_TYPE}")
-    ;;
-  *)
-    : # single-config generators do not need --config
-    ;;
-esac
+if "${CXX_COMPILER}" --version 2>/dev/null | grep -qi clang; then
+  COMPILER_KIND="clang"
+  PROFDATA="${LLVM_PROFDATA:-$(command -v llvm-profdata || true)}"
+  if [[ -z "${PROFDATA}" ]]; then
+    echo "Error: llvm-profdata not found; set LLVM_PROFDATA to its path." >&2
+    exit 1
+  fi
+  PROFILE_USE_FLAGS="-fprofile-use=${PROFILE_DIR}/poco.profdata -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date"
+else
+  COMPILER_KIND="gcc"
+  PROFILE_USE_FLAGS="-fprofile-use=${PROFILE_DIR} -fprofile-correction -Wno-missing-profile"
+fi
 
-cmake "${BUILD_ARGS[@]}"
-cmake "${BUILD_ARGS[@]}" "${INSTALL_ARGS[@]}"
+if [[ ${PGO_COMPARE} -eq 1 ]]; then
+  echo "PGO step 0/3: plain Release build for comparison..."
+  build_poco "${ARCH_FLAGS}" "" -DCMAKE_INTERPROCEDURAL_OPTIMIZATION=OFF
+  run_bench "${PGO_DIR}/bench_before.tsv"
+fi
 
-echo "Poco installed to: ${INSTALL_DIR}"
-echo "Done."
+echo "PGO step 1/3: instrumented build (${COMPILER_KIND})..."
+rm -rf "${PROFILE_DIR}"
+mkdir -p "${PROFILE_DIR}"
+# Training includes multi-threaded cases: counters are updated atomically
+GENERATE_FLAGS="-fprofile-generate=${PROFILE_DIR} -fprofile-update=atomic ${ARCH_FLAGS}"
+build_poco "${GENERATE_FLAGS}" "-fprofile-generate=${PROFILE_DIR}" -DCMAKE_INTERPROCEDURAL_OPTIMIZATION=OFF
+
+echo "PGO step 2/3: JSON training run..."
+build_app
+run_training
+if [[ "${COMPILER_KIND}" == "clang" ]]; then
+  "${PROFDATA}" merge -output="${PROFILE_DIR}/poco.profdata" "${PROFILE_DIR}"/*.profraw
+fi
 
+echo "PGO step 3/3: optimized build with the profile and LTO..."
+build_poco "${PROFILE_USE_FLAGS} ${ARCH_FLAGS}" "" -DCMAKE_INTERPROCEDURAL_OPTIMIZATION=ON
 
+if [[ ${PGO_COMPARE} -eq 1 ]]; then
+  run_bench "${PGO_DIR}/bench_after.tsv"
+  write_comparison
+fi
+
+echo "Poco (PGO + LTO) installed to: ${INSTALL_DIR}"
+echo "Done."
@@ -12,7 +12,23 @@ IFS=$'\n\t'
 # This script is designed for Linux only.
 #
 # Usage:
-#   ./test.sh [--build-type Release|Debug] [--jobs N]
+#   ./test.sh [--build-type Release|Debug] [--jobs N] [--profile]
+#             [--bench] [--bench-runs N] [--bench-threshold PCT]
+#             [--bench-baseline FILE] [--update-baseline]
+#
+# Notes:
+# - With --bench, after the unit tests pass the JSON benchmark (bench_json)
+#   is run several times. The median and variance of the throughput of every
+#   case are compared against the committed baseline (test/bench_baseline.tsv
+#   by default), and the script fails if any case is slower than the baseline
+#   by more than the threshold (percent, default: 10), if a baseline case did
+#   not run, if a benchmark run fails, or if the baseline has no cases.
+# - --update-baseline stores the aggregated results as the new baseline
+#   instead of comparing against it.
+# - --profile builds the tests and benchmarks with JSON stage profiling
+#   (POCO_TEST_PROFILE): every binary prints a per-stage summary of time and
+#   allocations to stderr on exit. Profiled timings are not comparable with
+#   the baseline, so it cannot be combined with --bench.
 #
 
 SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
@@ -23,6 +39,13 @@ BOOST_BIN_DIR="${SCRIPT_DIR}/boost_bin"
 
 BUILD_TYPE="Release"
 JOBS=""
+BENCH=0
+BENCH_RUNS=5
+BENCH_THRESHOLD=10
+BENCH_BASELINE="${SCRIPT_DIR}/test/bench_baseline.tsv"
+BENCH_SUMMARY="${SCRIPT_DIR}/bench_output.txt"
+UPDATE_BASELINE=0
+PROFILE=0
 
 while [[ $# -gt 0 ]]; do
   case "$1" in
@@ -34,6 +57,31 @@ while [[ $# -gt 0 ]]; do
       JOBS="${2:-}"
       shift 2
       ;;
+    --profile)
+      PROFILE=1
+      shift
+      ;;
+    --bench)
+      BENCH=1
+      shift
+      ;;
+    --bench-runs)
+      BENCH_RUNS="${2:-5}"
+      shift 2
+      ;;
+    --bench-threshold)
+      BENCH_THRESHOLD="${2:-10}"
+      shift 2
+      ;;
+    --bench-baseline)
+      BENCH_BASELINE="${2:-}"
+      shift 2
+      ;;
+    --update-baseline)
+      BENCH=1
+      UPDATE_BASELINE=1
+      shift
+      ;;
     *)
       echo "Unknown option: $1" >&2
       exit 1
@@ -50,6 +98,123 @@ if [[ -z "${JOBS}" ]]; then
   fi
 fi
 
+if [[ ${PROFILE} -eq 1 ]] && [[ ${BENCH} -eq 1 ]]; then
+  echo "Error: --profile cannot be combined with --bench or --update-baseline." >&2
+  exit 1
+fi
+
+if [[ ${BENCH} -eq 1 ]] && { ! [[ "${BENCH_RUNS}" =~ ^[0-9]+$ ]] || [[ ${BENCH_RUNS} -lt 1 ]]; }; then
+  echo "Error: --bench-runs expects a positive integer, got '${BENCH_RUNS}'." >&2
+  exit 1
+fi
+
+# Runs bench_json BENCH_RUNS times, aggregates the median and variance of
+# the throughput (MB/s) per case into BENCH_SUMMARY and either compares it
+# with BENCH_BASELINE or replaces the baseline (--update-baseline).
+run_benchmarks() {
+  local bench_exe="${BUILD_DIR}/test/bench_json"
+  local runs_dir="${BUILD_DIR}/bench_runs"
+
+  if [[ ! -x "${bench_exe}" ]]; then
+    echo "Error: benchmark executable not found at ${bench_exe}" >&2
+    return 1
+  fi
+
+  rm -rf "${runs_dir}"
+  mkdir -p "${runs_dir}"
+
+  local run
+  for (( run = 1; run <= BENCH_RUNS; run++ )); do
+    echo "Benchmark run ${run}/${BENCH_RUNS}..."
+    # run_benchmarks is called from an if, where set -e does not apply
+    if ! "${bench_exe}" --output "${runs_dir}/run_${run}.tsv" >/dev/null; then
+      echo "Error: benchmark run ${run} failed: ${bench_exe}" >&2
+      return 1
+    fi
+    if [[ $(tail -n +2 "${runs_dir}/run_${run}.tsv" | grep -c .) -eq 0 ]]; then
+      echo "Error: benchmark run ${run} produced no results" >&2
+      return 1
+    fi
+  done
+
+  # Columns of bench_json output: name bytes iterations mb_per_s docs_per_s p50_us p99_us allocs_per_doc
+  {
+    printf 'name\truns\tmedian_mb_per_s\tvariance\tcv_pct\n'
+    tail -q -n +2 "${runs_dir}"/run_*.tsv \
+      | sort -t $'\t' -k1,1 -k4,4g \
+      | awk -F '\t' '
+          function flush(   median, mean, variance, cv) {
+            if (n == 0) return
+            median = (n % 2) ? v[(n + 1) / 2] : (v[n / 2] + v[n / 2 + 1]) / 2
+            mean = sum / n
+            variance = (n > 1) ? (sumsq - n * mean * mean) / (n - 1) : 0
+            if (variance < 0) variance = 0
+            cv = (mean > 0) ? sqrt(variance) / mean * 100 : 0
+            printf "%s\t%d\t%.3f\t%.3f\t%.2f\n", name, n, median, variance, cv
+          }
+          $1 != name { flush(); name = $1; n = 0; sum = 0; sumsq = 0 }
+          { v[++n] = $4; sum += $4; sumsq += $4 * $4 }
+          END { flush() }'
+  } > "${BENCH_SUMMARY}" || {
+    echo "Error: failed to aggregate benchmark results" >&2
+    return 1
+  }
+
+  echo "Benchmark summary written to ${BENCH_SUMMARY}"
+
+  if [[ ${UPDATE_BASELINE} -eq 1 ]]; then
+    cp "${BENCH_SUMMARY}" "${BENCH_BASELINE}"
+    echo "Baseline updated: ${BENCH_BASELINE}"
+    return 0
+  fi
+
+  if [[ ! -f "${BENCH_BASELINE}" ]]; then
+    echo "Error: baseline file not found: ${BENCH_BASELINE}" >&2
+    echo "Create it with: ./test.sh --update-baseline" >&2
+    return 1
+  fi
+
+  if [[ $(grep -v -e '^#' -e '^name' "${BENCH_BASELINE}" | grep -c .) -eq 0 ]]; then
+    echo "Error: baseline ${BENCH_BASELINE} contains no cases, so nothing can be compared" >&2
+    echo "Record it on the reference machine with: ./test.sh --update-baseline" >&2
+    return 1
+  fi
+
+  echo "Comparing against ${BENCH_BASELINE} (threshold: ${BENCH_THRESHOLD}%)"
+  awk -F '\t' -v threshold="${BENCH_THRESHOLD}" '
+    FNR == NR {
+      if ($0 ~ /^#/ || $1 == "name" || NF < 3) next
+      base[$1] = $3
+      next
+    }
+    $1 == "name" { next }
+    {
+      seen[$1] = 1
+      if (!($1 in base)) {
+        printf "  %-10s %-36s %10.2f MB/s (no baseline)\n", "NEW", $1, $3
+        next
+      }
+      change = (base[$1] > 0) ? ($3 - base[$1]) / base[$1] * 100 : 0
+      status = (change < -threshold) ? "REGRESSION" : "OK"
+      if (status == "REGRESSION") failed++
+      printf "  %-10s %-36s %10.2f MB/s (baseline %.2f, %+.1f%%, cv %.1f%%)\n", status, $1, $3, base[$1], change, $5
+    }
+    END {
+      for (name in base)
+        if (!(name in seen)) {
+          printf "  %-10s %-36s (present in baseline only)\n", "MISSING", name
+          missing++
+        }
+      if (failed > 0)
+        printf "%d case(s) regressed by more than %s%%\n", failed, threshold
+      if (missing > 0)
+        printf "%d baseline case(s) did not run; update the baseline if they were removed on purpose\n", missing
+      if (failed > 0 || missing > 0)
+        exit 1
+      print "No throughput regressions."
+    }' "${BENCH_BASELINE}" "${BENCH_SUMMARY}"
+}
+
 # Check if Poco is built, if not, build it
 if [[ ! -d "${POCO_BIN_DIR}/lib/cmake/Poco" ]] || [[ ! -f "${POCO_BIN_DIR}/lib/cmake/Poco/PocoConfig.cmake" ]]; then
   echo "Poco library not found in ${POCO_BIN_DIR}. Building Poco..."
@@ -100,7 +265,8 @@ cd "${BUILD_DIR}"
 cmake \
   -S "${SOURCE_DIR}" \
   -B "${BUILD_DIR}" \
-  -DCMAKE_BUILD_TYPE="${BUILD_TYPE}"
+  -DCMAKE_BUILD_TYPE="${BUILD_TYPE}" \
+  -DPOCO_TEST_PROFILE="$([[ ${PROFILE} -eq 1 ]] && echo ON || echo OFF)"
 
 echo "Building project..."
 if cmake --build "${BUILD_DIR}" --parallel "${JOBS}"; then
@@ -110,15 +276,21 @@ if cmake --build "${BUILD_DIR}" --parallel "${JOBS}"; then
   # Look for poco-test-app or any executable in test directory
   TEST_EXECUTABLE=""
   
-  # First, try to find poco-test-app in test directory
-  if [[ -f "${BUILD_DIR}/test/poco-test-app" ]] && [[ -x "${BUILD_DIR}/test/poco-test-app" ]]; then
+  # First, try to find the unit test executable in test directory
+  if [[ -f "${BUILD_DIR}/test/test_example" ]] && [[ -x "${BUILD_DIR}/test/test_example" ]]; then
+    TEST_EXECUTABLE="${BUILD_DIR}/test/test_example"
+  elif [[ -f "${BUILD_DIR}/test/poco-test-app" ]] && [[ -x "${BUILD_DIR}/test/poco-test-app" ]]; then
     TEST_EXECUTABLE="${BUILD_DIR}/test/poco-test-app"
   # If not found, look for any executable in test directory
   elif [[ -d "${BUILD_DIR}/test" ]]; then
     # Enable nullglob to handle cases when no files match
     shopt -s nullglob
-    # Find first executable file in test directory (non-directory, executable)
+    # Find first executable file in test directory (non-directory, executable),
+    # skipping benchmark binaries
     for exec_file in "${BUILD_DIR}"/test/*; do
+      if [[ "$(basename "${exec_file}")" == bench_* ]]; then
+        continue
+      fi
       if [[ -f "${exec_file}" ]] && [[ -x "${exec_file}" ]]; then
         TEST_EXECUTABLE="${exec_file}"
         break
@@ -142,6 +314,13 @@ if cmake --build "${BUILD_DIR}" --parallel "${JOBS}"; then
     EXIT_CODE=$?
     echo "---"
     echo "Executable finished with exit code: ${EXIT_CODE}"
+    if [[ ${EXIT_CODE} -eq 0 ]] && [[ ${BENCH} -eq 1 ]]; then
+      if run_benchmarks; then
+        exit 0
+      fi
+      echo "Benchmark check failed!"
+      exit 1
+    fi
     exit ${EXIT_CODE}
   else
     echo "Warning: No test executable found to run."
@@ -0,0 +1,122 @@
+// Замена глобальных operator new/delete со счётчиками выделений.
+// Разделяемые библиотеки Poco при загрузке связываются с этими символами
+// исполняемого файла, поэтому учитываются и выделения внутри Poco.
+
+#include "alloc_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local std::size_t tlAllocations = 0;
+thread_local std::size_t tlBytes = 0;
+thread_local std::size_t tlDeallocations = 0;
+
+void* countedAlloc(std::size_t size) {
+    ++tlAllocations;
+    tlBytes += size;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    ++tlAllocations;
+    tlBytes += size;
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc требует размер, кратный выравниванию
+    const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+    void* p = std::aligned_alloc(align, rounded);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void countedFree(void* p) {
+    if (p) {
+        ++tlDeallocations;
+        std::free(p);
+    }
+}
+
+} // namespace
+
+namespace pocotest {
+
+AllocationStats threadAllocations() {
+    AllocationStats stats;
+    stats.allocations = tlAllocations;
+    stats.bytes = tlBytes;
+    stats.deallocations = tlDeallocations;
+    return stats;
+}
+
+} // namespace pocotest
+
+void* operator new(std::size_t size) {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size) {
+    return countedAlloc(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAlloc(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAlloc(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* p) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p) noexcept {
+    countedFree(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    countedFree(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    countedFree(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    countedFree(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    countedFree(p);
+}
@@ -0,0 +1,46 @@
+#ifndef POCO_TEST_APP_ALLOC_COUNTER_H
+#define POCO_TEST_APP_ALLOC_COUNTER_H
+
+// Подсчёт выделений и освобождений памяти через замену глобальных
+// operator new/delete (реализация в alloc_counter.cpp). Счётчики ведутся
+// отдельно для каждого потока, поэтому замер вокруг одного вызова не
+// искажается работой других потоков. Цели, которым нужен подсчёт,
+// добавляют alloc_counter.cpp в свой список исходников; в остальных
+// используется стандартный аллокатор.
+
+#include <cstddef>
+
+namespace pocotest {
+
+struct AllocationStats {
+    std::size_t allocations = 0;
+    std::size_t bytes = 0;
+    std::size_t deallocations = 0;   // освобождения в этом потоке (не nullptr)
+};
+
+// Накопленные счётчики текущего потока
+AllocationStats threadAllocations();
+
+// Замер выделений текущего потока от создания объекта до вызова delta()
+class AllocationScope {
+public:
+    AllocationScope()
+        : start_(threadAllocations()) {
+    }
+
+    AllocationStats delta() const {
+        AllocationStats now = threadAllocations();
+        AllocationStats result;
+        result.allocations = now.allocations - start_.allocations;
+        result.bytes = now.bytes - start_.bytes;
+        result.deallocations = now.deallocations - start_.deallocations;
+        return result;
+    }
+
+private:
+    AllocationStats start_;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_ALLOC_COUNTER_H
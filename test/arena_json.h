@@ -0,0 +1,532 @@
+#ifndef POCO_TEST_APP_ARENA_JSON_H
+#define POCO_TEST_APP_ARENA_JSON_H
+
+// Разбор JSON в дерево, целиком размещённое в одной арене.
+//
+// Обычный путь (ParseHandler) делает отдельное выделение памяти на каждый
+// Object, Array, ключ и значение Dynamic::Var. ArenaHandler получает те же
+// события от Poco::JSON::Parser, но складывает узлы, ключи и строки в
+// монотонную арену документа (std::pmr::monotonic_buffer_resource). Всё
+// дерево освобождается одним действием при уничтожении ArenaDocument.
+// Размер первого блока арены подстраивается под предыдущий документ, так что
+// для потока однотипных запросов на документ приходится одно-два выделения.
+//
+// Узлы дерева неизменяемы. Для передачи в код, ожидающий Poco::JSON,
+// есть ArenaValue::toVar().
+//
+// С общим KeyPool (setKeyPool) ключи объектов не копируются в арену, а
+// указывают в пул; документ держит пул живым. find() по ключу, полученному
+// из того же пула, сравнивает указатели, а не строки. Документы одной схемы
+// приходят с ключами в одном и том же порядке, поэтому обработчик помнит
+// последовательность ключей предыдущего документа: совпавший с ней ключ
+// берётся без хеширования и блокировки пула (в KeyPool::stats() такие
+// попадания не учитываются).
+
+#include <Poco/JSON/Handler.h>
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Exception.h>
+
+#include "key_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pocotest {
+
+struct ArenaMember;
+
+// Узел дерева. Тривиально копируемый; данные контейнеров и строк лежат в
+// арене документа и живут, пока жив документ
+class ArenaValue {
+public:
+    enum class Type : unsigned char {
+        Null,
+        Bool,
+        Integer,
+        Unsigned,
+        Double,
+        String,
+        Array,
+        Object
+    };
+
+    ArenaValue()
+        : type_(Type::Null)
+        , size_(0) {
+        data_.i = 0;
+    }
+
+    static ArenaValue makeBool(bool b) {
+        ArenaValue v(Type::Bool);
+        v.data_.b = b;
+        return v;
+    }
+
+    static ArenaValue makeInteger(Poco::Int64 i) {
+        ArenaValue v(Type::Integer);
+        v.data_.i = i;
+        return v;
+    }
+
+    static ArenaValue makeUnsigned(Poco::UInt64 u) {
+        ArenaValue v(Type::Unsigned);
+        v.data_.u = u;
+        return v;
+    }
+
+    static ArenaValue makeDouble(double d) {
+        ArenaValue v(Type::Double);
+        v.data_.d = d;
+        return v;
+    }
+
+    static ArenaValue makeString(std::string_view s) {
+        ArenaValue v(Type::String);
+        v.data_.str = s.data();
+        v.size_ = s.size();
+        return v;
+    }
+
+    static ArenaValue makeArray(const ArenaValue* items, std::size_t count) {
+        ArenaValue v(Type::Array);
+        v.data_.items = items;
+        v.size_ = count;
+        return v;
+    }
+
+    static ArenaValue makeObject(const ArenaMember* members, std::size_t count) {
+        ArenaValue v(Type::Object);
+        v.data_.members = members;
+        v.size_ = count;
+        return v;
+    }
+
+    Type type() const { return type_; }
+    bool isNull() const { return type_ == Type::Null; }
+    bool isBool() const { return type_ == Type::Bool; }
+    bool isString() const { return type_ == Type::String; }
+    bool isArray() const { return type_ == Type::Array; }
+    bool isObject() const { return type_ == Type::Object; }
+
+    bool isNumber() const {
+        return type_ == Type::Integer || type_ == Type::Unsigned || type_ == Type::Double;
+    }
+
+    bool asBool() const {
+        check(type_ == Type::Bool, "bool");
+        return data_.b;
+    }
+
+    Poco::Int64 asInt64() const {
+        switch (type_) {
+            case Type::Integer:
+                return data_.i;
+            case Type::Unsigned:
+                if (data_.u > static_cast<Poco::UInt64>(std::numeric_limits<Poco::Int64>::max())) {
+                    throw Poco::RangeException("Value does not fit into Int64");
+                }
+                return static_cast<Poco::Int64>(data_.u);
+            case Type::Double:
+                return static_cast<Poco::Int64>(data_.d);
+            default:
+                check(false, "number");
+                return 0;
+        }
+    }
+
+    double asDouble() const {
+        switch (type_) {
+            case Type::Integer: return static_cast<double>(data_.i);
+            case Type::Unsigned: return static_cast<double>(data_.u);
+            case Type::Double: return data_.d;
+            default:
+                check(false, "number");
+                return 0.0;
+        }
+    }
+
+    std::string_view asString() const {
+        check(type_ == Type::String, "string");
+        return std::string_view(data_.str, size_);
+    }
+
+    // Число элементов массива или членов объекта
+    std::size_t size() const {
+        return (type_ == Type::Array || type_ == Type::Object) ? size_ : 0;
+    }
+
+    // Элемент массива
+    const ArenaValue& at(std::size_t index) const {
+        check(type_ == Type::Array, "array");
+        if (index >= size_) {
+            throw Poco::RangeException("Array index out of range");
+        }
+        return data_.items[index];
+    }
+
+    // Член объекта по ключу; nullptr, если ключа нет. При повторяющихся
+    // ключах, как и в Poco::JSON::Object, действует последний. Ключ из того
+    // же KeyPool, что у документа, совпадает уже по указателю
+    inline const ArenaValue* find(std::string_view key) const;
+
+    inline std::string_view keyAt(std::size_t index) const;
+    inline const ArenaValue& valueAt(std::size_t index) const;
+
+    // Копия узла в виде дерева Poco::JSON (Object::Ptr/Array::Ptr/скаляр)
+    inline Poco::Dynamic::Var toVar() const;
+
+private:
+    explicit ArenaValue(Type type)
+        : type_(type)
+        , size_(0) {
+        data_.i = 0;
+    }
+
+    void check(bool ok, const char* expected) const {
+        if (!ok) {
+            throw Poco::BadCastException(std::string("ArenaValue is not a ") + expected);
+        }
+    }
+
+    Type type_;
+    std::size_t size_;
+    union {
+        bool b;
+        Poco::Int64 i;
+        Poco::UInt64 u;
+        double d;
+        const char* str;
+        const ArenaValue* items;
+        const ArenaMember* members;
+    } data_;
+};
+
+struct ArenaMember {
+    std::string_view key;
+    ArenaValue value;
+};
+
+inline const ArenaValue* ArenaValue::find(std::string_view key) const {
+    check(type_ == Type::Object, "object");
+    for (std::size_t i = size_; i > 0; --i) {
+        const std::string_view member = data_.members[i - 1].key;
+        if ((member.data() == key.data() && member.size() == key.size()) || member == key) {
+            return &data_.members[i - 1].value;
+        }
+    }
+    return nullptr;
+}
+
+inline std::string_view ArenaValue::keyAt(std::size_t index) const {
+    check(type_ == Type::Object, "object");
+    if (index >= size_) {
+        throw Poco::RangeException("Member index out of range");
+    }
+    return data_.members[index].key;
+}
+
+inline const ArenaValue& ArenaValue::valueAt(std::size_t index) const {
+    check(type_ == Type::Object, "object");
+    if (index >= size_) {
+        throw Poco::RangeException("Member index out of range");
+    }
+    return data_.members[index].value;
+}
+
+inline Poco::Dynamic::Var ArenaValue::toVar() const {
+    switch (type_) {
+        case Type::Null:
+            return Poco::Dynamic::Var();
+        case Type::Bool:
+            return data_.b;
+        case Type::Integer:
+            return data_.i;
+        case Type::Unsigned:
+            return data_.u;
+        case Type::Double:
+            return data_.d;
+        case Type::String:
+            return std::string(data_.str, size_);
+        case Type::Array: {
+            Poco::JSON::Array::Ptr arr = new Poco::JSON::Array();
+            for (std::size_t i = 0; i < size_; ++i) {
+                arr->add(data_.items[i].toVar());
+            }
+            return arr;
+        }
+        case Type::Object: {
+            Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+            for (std::size_t i = 0; i < size_; ++i) {
+                obj->set(std::string(data_.members[i].key), data_.members[i].value.toVar());
+            }
+            return obj;
+        }
+    }
+    return Poco::Dynamic::Var();
+}
+
+// Разобранный документ: корневой узел и арена, в которой лежит всё дерево
+class ArenaDocument {
+public:
+    ArenaDocument() = default;
+    ArenaDocument(ArenaDocument&&) = default;
+    ArenaDocument& operator=(ArenaDocument&&) = default;
+
+    const ArenaValue& root() const {
+        return root_;
+    }
+
+    // Сколько байт дерева размещено в арене
+    std::size_t arenaBytes() const {
+        return bytes_;
+    }
+
+private:
+    friend class ArenaHandler;
+
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;
+    KeyPool::Ptr keyPool_;        // пул, в который указывают ключи, если задан
+    ArenaValue root_;
+    std::size_t bytes_ = 0;
+};
+
+// Обработчик событий Poco::JSON::Parser, строящий ArenaDocument.
+// Дочерние узлы незакрытых контейнеров копятся во внутренних стеках,
+// ёмкость которых сохраняется между документами, и переносятся в арену
+// одним блоком при закрытии контейнера
+class ArenaHandler : public Poco::JSON::Handler {
+public:
+    using Ptr = Poco::SharedPtr<ArenaHandler>;
+
+    explicit ArenaHandler(std::size_t initialArenaSize = 4096)
+        : initialArenaSize_(initialArenaSize)
+        , nextArenaSize_(initialArenaSize) {
+    }
+
+    // Общий пул ключей для следующих документов; nullptr - ключи копируются
+    // в арену документа
+    void setKeyPool(const KeyPool::Ptr& keyPool) {
+        keyPool_ = keyPool;
+        keyTrace_.clear();
+        previousTrace_.clear();
+    }
+
+    const KeyPool::Ptr& getKeyPool() const {
+        return keyPool_;
+    }
+
+    void reset() override {
+        doc_ = ArenaDocument();
+        frames_.clear();
+        values_.clear();
+        members_.clear();
+        key_ = std::string_view();
+        keyTrace_.clear();
+    }
+
+    void startObject() override {
+        frames_.push_back(Frame{true, members_.size(), key_});
+    }
+
+    void endObject() override {
+        const Frame frame = popFrame(true);
+        const std::size_t count = members_.size() - frame.start;
+        ArenaMember* members = allocateArray<ArenaMember>(count);
+        std::uninitialized_copy(members_.begin() + frame.start, members_.end(), members);
+        members_.resize(frame.start);
+        key_ = frame.key;
+        emit(ArenaValue::makeObject(members, count));
+    }
+
+    void startArray() override {
+        frames_.push_back(Frame{false, values_.size(), key_});
+    }
+
+    void endArray() override {
+        const Frame frame = popFrame(false);
+        const std::size_t count = values_.size() - frame.start;
+        ArenaValue* items = allocateArray<ArenaValue>(count);
+        std::uninitialized_copy(values_.begin() + frame.start, values_.end(), items);
+        values_.resize(frame.start);
+        key_ = frame.key;
+        emit(ArenaValue::makeArray(items, count));
+    }
+
+    void key(const std::string& k) override {
+        if (!keyPool_.isNull()) {
+            const std::size_t position = keyTrace_.size();
+            if (position < previousTrace_.size() && previousTrace_[position] == k) {
+                key_ = previousTrace_[position];
+            } else {
+                key_ = keyPool_->intern(k);
+            }
+            if (key_.data() != nullptr) {
+                if (doc_.keyPool_.isNull()) {
+                    doc_.keyPool_ = keyPool_;
+                }
+                keyTrace_.push_back(key_);
+                return;
+            }
+            keyTrace_.push_back(std::string_view());
+        }
+        key_ = copyString(k);
+    }
+
+    void null() override {
+        emit(ArenaValue());
+    }
+
+    void value(int v) override {
+        emit(ArenaValue::makeInteger(v));
+    }
+
+    void value(unsigned v) override {
+        emit(ArenaValue::makeUnsigned(v));
+    }
+
+#if defined(POCO_HAVE_INT64)
+    void value(Poco::Int64 v) override {
+        emit(ArenaValue::makeInteger(v));
+    }
+
+    void value(Poco::UInt64 v) override {
+        emit(ArenaValue::makeUnsigned(v));
+    }
+#endif
+
+    void value(const std::string& s) override {
+        emit(ArenaValue::makeString(copyString(s)));
+    }
+
+    void value(double d) override {
+        emit(ArenaValue::makeDouble(d));
+    }
+
+    void value(bool b) override {
+        emit(ArenaValue::makeBool(b));
+    }
+
+    // Забирает готовый документ; обработчик готов к следующему
+    ArenaDocument release() {
+        if (!frames_.empty()) {
+            throw Poco::InvalidAccessException("JSON document is not complete");
+        }
+        ArenaDocument doc = std::move(doc_);
+        // Следующая арена сразу получает блок по размеру этого документа
+        nextArenaSize_ = std::max(initialArenaSize_, doc.bytes_ + doc.bytes_ / 4);
+        previousTrace_.swap(keyTrace_);
+        reset();
+        return doc;
+    }
+
+private:
+    struct Frame {
+        bool object;
+        std::size_t start;        // начало дочерних узлов во внутреннем стеке
+        std::string_view key;     // ключ контейнера в родительском объекте
+    };
+
+    Frame popFrame(bool object) {
+        if (frames_.empty() || frames_.back().object != object) {
+            throw Poco::InvalidAccessException("Unbalanced JSON container events");
+        }
+        Frame frame = frames_.back();
+        frames_.pop_back();
+        return frame;
+    }
+
+    void emit(const ArenaValue& value) {
+        if (frames_.empty()) {
+            doc_.root_ = value;
+        } else if (frames_.back().object) {
+            members_.push_back(ArenaMember{key_, value});
+        } else {
+            values_.push_back(value);
+        }
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        if (!doc_.arena_) {
+            doc_.arena_.reset(new std::pmr::monotonic_buffer_resource(nextArenaSize_));
+        }
+        doc_.bytes_ += bytes;
+        return doc_.arena_->allocate(bytes, alignment);
+    }
+
+    template <typename T>
+    T* allocateArray(std::size_t count) {
+        if (count == 0) {
+            return nullptr;
+        }
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    std::string_view copyString(const std::string& s) {
+        if (s.empty()) {
+            return std::string_view();
+        }
+        char* p = static_cast<char*>(allocate(s.size(), 1));
+        std::memcpy(p, s.data(), s.size());
+        return std::string_view(p, s.size());
+    }
+
+    std::size_t initialArenaSize_;
+    std::size_t nextArenaSize_;
+    KeyPool::Ptr keyPool_;
+    std::vector<std::string_view> keyTrace_;        // ключи текущего документа из пула
+    std::vector<std::string_view> previousTrace_;   // то же для предыдущего документа
+    ArenaDocument doc_;
+    std::vector<Frame> frames_;
+    std::vector<ArenaValue> values_;
+    std::vector<ArenaMember> members_;
+    std::string_view key_;
+};
+
+// Парсер в режиме арены: Poco::JSON::Parser с ArenaHandler
+class ArenaParser {
+public:
+    explicit ArenaParser(std::size_t initialArenaSize = 4096)
+        : handler_(new ArenaHandler(initialArenaSize))
+        , parser_(handler_) {
+    }
+
+    ArenaParser(const ArenaParser&) = delete;
+    ArenaParser& operator=(const ArenaParser&) = delete;
+
+    void setKeyPool(const KeyPool::Ptr& keyPool) {
+        handler_->setKeyPool(keyPool);
+    }
+
+    const KeyPool::Ptr& getKeyPool() const {
+        return handler_->getKeyPool();
+    }
+
+    ArenaDocument parse(const std::string& json) {
+        parser_.reset();
+        try {
+            parser_.parse(json);
+        } catch (...) {
+            parser_.reset();
+            throw;
+        }
+        return handler_->release();
+    }
+
+private:
+    ArenaHandler::Ptr handler_;
+    Poco::JSON::Parser parser_;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_ARENA_JSON_H
@@ -0,0 +1,254 @@
+#ifndef POCO_TEST_APP_BENCH_CORPUS_H
+#define POCO_TEST_APP_BENCH_CORPUS_H
+
+// Фиксированный корпус сгенерированных JSON-документов для бенчмарков.
+// Генератор детерминирован (фиксированный seed), поэтому результаты
+// разных запусков и разных сборок Poco сравнимы между собой.
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Dynamic/Var.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct CorpusDocument {
+    std::string name;
+    std::string json;           // текстовое представление
+    Poco::Dynamic::Var tree;    // то же самое, разобранное Poco::JSON::Parser
+};
+
+inline std::string randomWord(std::mt19937& rng, std::size_t minLen, std::size_t maxLen) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz";
+    std::uniform_int_distribution<std::size_t> len(minLen, maxLen);
+    std::uniform_int_distribution<int> ch(0, 25);
+    std::string word(len(rng), ' ');
+    for (auto& c : word) {
+        c = alphabet[ch(rng)];
+    }
+    return word;
+}
+
+// Текст сообщения лога; изредка содержит символы, требующие экранирования
+inline std::string randomMessage(std::mt19937& rng, std::size_t words) {
+    std::string message;
+    std::uniform_int_distribution<int> special(0, 19);
+    for (std::size_t i = 0; i < words; ++i) {
+        if (i > 0) {
+            message += ' ';
+        }
+        message += randomWord(rng, 2, 10);
+        switch (special(rng)) {
+            case 0: message += "\t"; break;
+            case 1: message += "\"quoted\""; break;
+            case 2: message += "C:\\path\\file"; break;
+            case 3: message += "\n  at frame"; break;
+            default: break;
+        }
+    }
+    return message;
+}
+
+// Плоский объект из скаляров разных типов
+inline Poco::JSON::Object::Ptr makeFlatObject(std::mt19937& rng, int keys) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    std::uniform_int_distribution<int> kind(0, 4);
+    std::uniform_int_distribution<Poco::Int64> integer(-1000000, 1000000);
+    std::uniform_real_distribution<double> real(-1e6, 1e6);
+    for (int i = 0; i < keys; ++i) {
+        std::string key = "field_" + std::to_string(i);
+        switch (kind(rng)) {
+            case 0: obj->set(key, randomWord(rng, 4, 24)); break;
+            case 1: obj->set(key, integer(rng)); break;
+            case 2: obj->set(key, real(rng)); break;
+            case 3: obj->set(key, (i % 2) == 0); break;
+            default: obj->set(key, Poco::Dynamic::Var()); break;
+        }
+    }
+    return obj;
+}
+
+// Глубоко вложенная структура: объекты и массивы чередуются
+inline Poco::JSON::Object::Ptr makeDeepNesting(int depth) {
+    Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+    Poco::JSON::Object::Ptr current = root;
+    for (int level = 0; level < depth; ++level) {
+        current->set("level", level);
+        current->set("name", "node_" + std::to_string(level));
+        Poco::JSON::Array::Ptr children = new Poco::JSON::Array();
+        Poco::JSON::Object::Ptr child = new Poco::JSON::Object();
+        children->add(level);
+        children->add(child);
+        current->set("children", children);
+        current = child;
+    }
+    current->set("leaf", true);
+    return root;
+}
+
+// Массив чисел: целые и числа с плавающей точкой вперемешку
+inline Poco::JSON::Array::Ptr makeNumberArray(std::mt19937& rng, int count) {
+    Poco::JSON::Array::Ptr arr = new Poco::JSON::Array();
+    std::uniform_int_distribution<Poco::Int64> integer(-1000000000LL, 1000000000LL);
+    std::uniform_real_distribution<double> real(-1e9, 1e9);
+    for (int i = 0; i < count; ++i) {
+        if (i % 2 == 0) {
+            arr->add(integer(rng));
+        } else {
+            arr->add(real(rng));
+        }
+    }
+    return arr;
+}
+
+// Записи лога с длинными строковыми сообщениями
+inline Poco::JSON::Array::Ptr makeStringLogs(std::mt19937& rng, int records) {
+    static const char* levels[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+    Poco::JSON::Array::Ptr logs = new Poco::JSON::Array();
+    std::uniform_int_distribution<int> level(0, 4);
+    std::uniform_int_distribution<std::size_t> words(20, 80);
+    for (int i = 0; i < records; ++i) {
+        Poco::JSON::Object::Ptr record = new Poco::JSON::Object();
+        record->set("ts", "2025-01-01T00:00:" + std::to_string(i % 60) + "Z");
+        record->set("level", levels[level(rng)]);
+        record->set("logger", "com.example." + randomWord(rng, 4, 12));
+        record->set("thread", "worker-" + std::to_string(i % 16));
+        record->set("message", randomMessage(rng, words(rng)));
+        logs->add(record);
+    }
+    return logs;
+}
+
+// Документ размером в несколько мегабайт из записей смешанной структуры
+inline Poco::JSON::Array::Ptr makeLargeDocument(std::mt19937& rng, int records) {
+    Poco::JSON::Array::Ptr root = new Poco::JSON::Array();
+    std::uniform_real_distribution<double> real(0.0, 1000.0);
+    for (int i = 0; i < records; ++i) {
+        Poco::JSON::Object::Ptr record = new Poco::JSON::Object();
+        record->set("id", i);
+        record->set("name", randomWord(rng, 8, 32));
+        Poco::JSON::Array::Ptr tags = new Poco::JSON::Array();
+        for (int t = 0; t < 4; ++t) {
+            tags->add(randomWord(rng, 3, 8));
+        }
+        record->set("tags", tags);
+        Poco::JSON::Object::Ptr metrics = new Poco::JSON::Object();
+        metrics->set("cpu", real(rng));
+        metrics->set("mem", real(rng));
+        metrics->set("rps", static_cast<int>(real(rng)));
+        record->set("metrics", metrics);
+        record->set("attributes", makeFlatObject(rng, 8));
+        record->set("description", randomMessage(rng, 16));
+        root->add(record);
+    }
+    return root;
+}
+
+// count документов одной схемы (записи large_document) в виде текста:
+// поток однотипных запросов
+inline std::vector<std::string> makeSchemaDocuments(std::mt19937& rng, int count) {
+    std::vector<std::string> documents;
+    documents.reserve(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        std::ostringstream ss;
+        Poco::JSON::Stringifier::condense(makeLargeDocument(rng, 1)->get(0), ss);
+        documents.push_back(ss.str());
+    }
+    return documents;
+}
+
+// Широкий объект: fields разделов "section_<i>" со структурой записи
+// large_document. Для выборочного разбора (нужны единицы процентов полей),
+// в общий корпус не входит
+inline Poco::JSON::Object::Ptr makeWideDocument(std::mt19937& rng, int fields) {
+    Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+    const Poco::JSON::Array::Ptr records = makeLargeDocument(rng, fields);
+    for (int i = 0; i < fields; ++i) {
+        root->set("section_" + std::to_string(i), records->get(static_cast<unsigned>(i)));
+    }
+    return root;
+}
+
+// Одна запись XML-фида товаров с отступами: атрибуты, префикс
+// пространства имён, сущности, CDATA и смешанное содержимое
+inline void appendXmlFeedItem(std::mt19937& rng, std::size_t id, std::string& out) {
+    static const char* const currencies[] = {"EUR", "USD", "GBP"};
+    std::uniform_int_distribution<int> currency(0, 2);
+    std::uniform_int_distribution<int> cents(100, 999999);
+    std::uniform_int_distribution<int> kind(0, 3);
+    std::uniform_int_distribution<std::size_t> words(8, 40);
+
+    const int price = cents(rng);
+    out += "  <item id=\"" + std::to_string(id) + "\" g:status=\"" + (id % 7 == 0 ? "out_of_stock" : "in_stock")
+        + "\">\n    <title>" + randomWord(rng, 4, 12) + ' ' + randomWord(rng, 4, 12) + "</title>\n"
+        + "    <price currency=\"" + currencies[currency(rng)] + "\">" + std::to_string(price / 100) + '.'
+        + std::to_string(price % 100 / 10) + std::to_string(price % 10) + "</price>\n";
+    switch (kind(rng)) {
+        case 0:
+            out += "    <description><![CDATA[" + randomMessage(rng, words(rng)) + " <b>& more</b>]]></description>\n";
+            break;
+        case 1:
+            out += "    <description>Size &lt; 10 &amp; weight &gt; 2, caf\xC3\xA9 &#x2014; "
+                + randomMessage(rng, words(rng)) + "</description>\n";
+            break;
+        default:
+            out += "    <description>" + randomMessage(rng, words(rng)) + " <em>"
+                + randomWord(rng, 3, 8) + "</em> " + randomWord(rng, 3, 8) + "</description>\n";
+            break;
+    }
+    out += "    <tags><tag>" + randomWord(rng, 3, 8) + "</tag><tag>" + randomWord(rng, 3, 8) + "</tag></tags>\n";
+    out += "    <!-- item " + std::to_string(id) + " -->\n  </item>\n";
+}
+
+inline const char* xmlFeedHeader() {
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<feed xmlns:g=\"http://base.google.com/ns/1.0\" updated=\"2025-01-01T00:00:00Z\">\n";
+}
+
+inline const char* xmlFeedFooter() {
+    return "</feed>\n";
+}
+
+// XML-фид из items записей
+inline std::string makeXmlFeed(std::mt19937& rng, std::size_t items) {
+    std::string xml = xmlFeedHeader();
+    for (std::size_t i = 0; i < items; ++i) {
+        appendXmlFeedItem(rng, i, xml);
+    }
+    xml += xmlFeedFooter();
+    return xml;
+}
+
+inline CorpusDocument makeDocument(const std::string& name, const Poco::Dynamic::Var& tree) {
+    CorpusDocument doc;
+    doc.name = name;
+    std::ostringstream ss;
+    Poco::JSON::Stringifier::condense(tree, ss);
+    doc.json = ss.str();
+    Poco::JSON::Parser parser;
+    doc.tree = parser.parse(doc.json);
+    return doc;
+}
+
+// Полный корпус: плоские объекты, глубокая вложенность, числовые массивы,
+// строковые логи и документ размером в несколько мегабайт
+inline std::vector<CorpusDocument> buildCorpus() {
+    std::mt19937 rng(20250101u);
+    std::vector<CorpusDocument> corpus;
+    corpus.push_back(makeDocument("flat_object", makeFlatObject(rng, 64)));
+    corpus.push_back(makeDocument("deep_nesting", makeDeepNesting(64)));
+    corpus.push_back(makeDocument("number_array", makeNumberArray(rng, 20000)));
+    corpus.push_back(makeDocument("string_logs", makeStringLogs(rng, 2000)));
+    corpus.push_back(makeDocument("large_document", makeLargeDocument(rng, 16000)));
+    return corpus;
+}
+
+} // namespace bench
+
+#endif // POCO_TEST_APP_BENCH_CORPUS_H
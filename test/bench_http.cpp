@@ -0,0 +1,381 @@
+// JSON API через Poco::Net::HTTPServer на loopback.
+//
+// Поднимает HTTPServer на 127.0.0.1 с обработчиком, который разбирает тело
+// POST-запроса JsonPushParser по мере чтения из сокета и отвечает
+// сериализованным JSON ({"ok": true, "bytes": N, "echo": <тело>}).
+// Встроенный генератор нагрузки открывает заданное число соединений
+// HTTPClientSession, каждое в своём потоке, и для разных HTTPServerParams
+// (размер пула потоков, длина очереди соединений, keep-alive) печатает
+// запросы в секунду и перцентили задержки. Внешняя сеть не нужна.
+//
+// Нагрузка и сервер делят процессор, поэтому абсолютные числа ниже, чем у
+// отдельного сервера; сравнивать имеет смысл конфигурации между собой.
+
+#include "bench_util.h"
+#include "bench_corpus.h"
+#include "alloc_counter.h"
+#include "json_push_parser.h"
+#include "json_writer.h"
+
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/Net/HTTPServerParams.h>
+#include <Poco/Net/HTTPRequestHandler.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/ThreadPool.h>
+#include <Poco/Timespan.h>
+#include <Poco/Exception.h>
+
+#include <atomic>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+
+using namespace Poco::JSON;
+
+namespace {
+
+// Счётчики сервера, общие для всех потоков пула
+struct ServerStats {
+    std::atomic<std::size_t> requests{0};
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> badRequests{0};
+
+    void clear() {
+        requests = 0;
+        allocations = 0;
+        badRequests = 0;
+    }
+};
+
+class JsonEchoHandler : public Poco::Net::HTTPRequestHandler {
+public:
+    static constexpr std::size_t READ_SIZE = 16 * 1024;
+
+    explicit JsonEchoHandler(ServerStats& stats)
+        : stats_(stats) {
+    }
+
+    void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override {
+        // Обработчик создаётся на каждый запрос; разборщик и буферы живут в
+        // потоке пула и переиспользуются между запросами
+        thread_local pocotest::JsonPushParser parser;
+        thread_local std::string chunk(READ_SIZE, '\0');
+        thread_local std::string out;
+
+        const pocotest::AllocationScope scope;
+        std::istream& in = request.stream();
+        std::size_t bytes = 0;
+        Poco::Dynamic::Var body;
+        try {
+            parser.reset();
+            while (in) {
+                in.read(&chunk[0], static_cast<std::streamsize>(chunk.size()));
+                const std::size_t got = static_cast<std::size_t>(in.gcount());
+                parser.feed(chunk.data(), got);
+                bytes += got;
+            }
+            body = parser.finish();
+        } catch (const Poco::Exception& e) {
+            // Любая ошибка Poco при разборе или чтении тела - ответ 400, а
+            // не исключение в поток пула. Остаток тела дочитывается, иначе
+            // соединение нельзя использовать для следующего запроса
+            in.ignore(std::numeric_limits<std::streamsize>::max());
+            ++stats_.badRequests;
+            Object::Ptr error = new Object();
+            error->set("ok", false);
+            error->set("error", e.message().empty() ? e.displayText() : e.message());
+            reply(response, Poco::Net::HTTPResponse::HTTP_BAD_REQUEST, error, out);
+            return;
+        }
+
+        Object::Ptr result = new Object();
+        result->set("ok", true);
+        result->set("bytes", bytes);
+        result->set("echo", body);
+        reply(response, Poco::Net::HTTPResponse::HTTP_OK, result, out);
+
+        ++stats_.requests;
+        stats_.allocations += scope.delta().allocations;
+    }
+
+private:
+    static void reply(Poco::Net::HTTPServerResponse& response, Poco::Net::HTTPResponse::HTTPStatus status,
+                      const Object::Ptr& value, std::string& out) {
+        pocotest::stringifyTo(value, out);
+        response.setStatus(status);
+        response.setContentType("application/json");
+        response.setContentLength(static_cast<std::streamsize>(out.size()));
+        response.sendBuffer(out.data(), out.size());
+    }
+
+    ServerStats& stats_;
+};
+
+class JsonEchoHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory {
+public:
+    explicit JsonEchoHandlerFactory(ServerStats& stats)
+        : stats_(stats) {
+    }
+
+    Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest&) override {
+        return new JsonEchoHandler(stats_);
+    }
+
+private:
+    ServerStats& stats_;
+};
+
+// Конфигурация сервера и нагрузки для одного случая
+struct LoadCase {
+    int threads = 1;         // HTTPServerParams::setMaxThreads
+    int queued = 64;         // HTTPServerParams::setMaxQueued
+    bool keepAlive = true;   // сервер и клиенты держат соединение
+    unsigned connections = 1;
+
+    std::string name() const {
+        return std::to_string(threads) + "t_q" + std::to_string(queued) + "_" +
+               std::to_string(connections) + "c_" + (keepAlive ? "ka" : "close");
+    }
+};
+
+// Результат одного клиента: задержки успешных запросов и число ошибок
+struct ClientResult {
+    std::vector<double> latencies;
+    std::size_t errors = 0;
+};
+
+// Один клиент: requests запросов подряд. Без keep-alive каждый запрос
+// открывает новое соединение, как делает клиент без пула
+void runClient(const Poco::Net::SocketAddress& address, const std::string& body, bool keepAlive,
+               std::size_t requests, ClientResult& result) {
+    std::unique_ptr<Poco::Net::HTTPClientSession> session;
+    std::string reply;
+    result.latencies.reserve(requests);
+    for (std::size_t i = 0; i < requests; ++i) {
+        const bench::Clock::time_point t0 = bench::Clock::now();
+        try {
+            if (!session) {
+                session.reset(new Poco::Net::HTTPClientSession(address));
+                session->setKeepAlive(keepAlive);
+                session->setTimeout(Poco::Timespan(30, 0));
+            }
+            Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_POST, "/echo",
+                                           Poco::Net::HTTPMessage::HTTP_1_1);
+            request.setContentType("application/json");
+            request.setContentLength(static_cast<std::streamsize>(body.size()));
+            request.setKeepAlive(keepAlive);
+            session->sendRequest(request).write(body.data(), static_cast<std::streamsize>(body.size()));
+
+            Poco::Net::HTTPResponse response;
+            std::istream& in = session->receiveResponse(response);
+            reply.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            const bench::Clock::time_point t1 = bench::Clock::now();
+            if (!keepAlive) {
+                session.reset();
+            }
+            if (response.getStatus() != Poco::Net::HTTPResponse::HTTP_OK) {
+                ++result.errors;
+                continue;
+            }
+            result.latencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        } catch (const Poco::Exception&) {
+            // Соединение отклонено (очередь сервера заполнена) или разорвано
+            ++result.errors;
+            session.reset();
+        }
+    }
+}
+
+// Запускает сервер с параметрами loadCase и прогоняет нагрузку:
+// connections клиентов по requests запросов, все стартуют одновременно
+bench::Result runCase(const std::string& name, const std::string& body, const LoadCase& loadCase,
+                      std::size_t requests, ServerStats& stats, std::size_t& errors, double& p999) {
+    Poco::Net::HTTPServerParams::Ptr params = new Poco::Net::HTTPServerParams();
+    params->setMaxThreads(loadCase.threads);
+    params->setMaxQueued(loadCase.queued);
+    params->setKeepAlive(loadCase.keepAlive);
+    params->setKeepAliveTimeout(Poco::Timespan(5, 0));
+    params->setMaxKeepAliveRequests(0);
+
+    Poco::ThreadPool pool(loadCase.threads, loadCase.threads);
+    Poco::Net::ServerSocket socket(Poco::Net::SocketAddress("127.0.0.1", 0), 1024);
+    const Poco::Net::SocketAddress address("127.0.0.1", socket.address().port());
+    Poco::Net::HTTPServer server(new JsonEchoHandlerFactory(stats), pool, socket, params);
+    server.start();
+
+    // Прогрев отдельным клиентом: соединения нагрузки, ожидающие в очереди,
+    // не должны ждать потоков, занятых прогревом
+    ClientResult warmup;
+    runClient(address, body, loadCase.keepAlive, 32, warmup);
+    stats.clear();
+
+    std::vector<ClientResult> results(loadCase.connections);
+    std::atomic<unsigned> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> clients;
+    clients.reserve(loadCase.connections);
+    for (unsigned c = 0; c < loadCase.connections; ++c) {
+        clients.emplace_back([&, c]() {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            runClient(address, body, loadCase.keepAlive, requests, results[c]);
+        });
+    }
+    while (ready.load() < loadCase.connections) {
+        std::this_thread::yield();
+    }
+    const bench::Clock::time_point start = bench::Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& client : clients) {
+        client.join();
+    }
+    const bench::Clock::time_point stop = bench::Clock::now();
+    server.stopAll(true);
+
+    std::vector<double> all;
+    errors = 0;
+    for (const auto& result : results) {
+        all.insert(all.end(), result.latencies.begin(), result.latencies.end());
+        errors += result.errors;
+    }
+
+    bench::Result result;
+    result.name = name;
+    result.bytes = body.size();
+    result.iterations = all.size();
+    result.totalSeconds = std::chrono::duration<double>(stop - start).count();
+    result.p50Us = bench::percentile(all, 50.0);
+    result.p99Us = bench::percentile(all, 99.0);
+    const std::size_t served = stats.requests.load();
+    result.allocsPerDoc = served > 0 ? static_cast<double>(stats.allocations.load()) / served : 0.0;
+    p999 = bench::percentile(all, 99.9);
+    return result;
+}
+
+// Случаи для одного тела запроса: масштабирование пула при числе
+// соединений, равном числу потоков, затем перегрузка в четыре раза больше
+// соединений - с keep-alive (поток занят соединением до его закрытия), без
+// него и с короткой очередью, которая отклоняет соединения
+std::vector<LoadCase> loadCases(int maxThreads, unsigned connections) {
+    std::vector<LoadCase> cases;
+    for (int threads : bench::threadCounts(maxThreads)) {
+        LoadCase c;
+        c.threads = threads;
+        c.connections = connections != 0 ? connections : static_cast<unsigned>(threads);
+        cases.push_back(c);
+    }
+    const unsigned overload = connections != 0 ? connections : static_cast<unsigned>(maxThreads) * 4;
+    for (const auto& [queued, keepAlive] : {std::make_pair(64, true), std::make_pair(64, false), std::make_pair(4, false)}) {
+        LoadCase c;
+        c.threads = maxThreads;
+        c.queued = queued;
+        c.keepAlive = keepAlive;
+        c.connections = overload;
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    options.output = "bench_http_output.txt";
+    int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency() / 2));
+    unsigned connections = 0;
+    std::size_t requests = 2000;
+
+    std::vector<std::string> rest = bench::parseOptions(argc, argv, options);
+    if (options.quick) {
+        requests = 200;
+    }
+    for (std::size_t i = 0; i < rest.size();) {
+        if (rest[i] == "--server-threads" && i + 1 < rest.size()) {
+            maxThreads = std::max(1, std::atoi(rest[i + 1].c_str()));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--connections" && i + 1 < rest.size()) {
+            connections = static_cast<unsigned>(std::max(1, std::atoi(rest[i + 1].c_str())));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--requests" && i + 1 < rest.size()) {
+            requests = static_cast<std::size_t>(std::max(1, std::atoi(rest[i + 1].c_str())));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else {
+            ++i;
+        }
+    }
+    if (!rest.empty()) {
+        std::ostream& out = rest.front() == "--help" ? std::cout : std::cerr;
+        out << "Usage: " << argv[0]
+            << " [--quick] [--server-threads N] [--connections N] [--requests N] [--output FILE] [--filter SUBSTR]\n"
+            << "  --quick            short run (200 requests per connection)\n"
+            << "  --server-threads N maximum server thread pool size (default: nproc / 2)\n"
+            << "  --connections N    client connections for every case (default: one per server thread,\n"
+            << "                     four per thread in the overload cases)\n"
+            << "  --requests N       requests per connection (default: 2000)\n"
+            << "  --output FILE      machine-readable TSV report (default: bench_http_output.txt)\n"
+            << "  --filter SUBSTR    run only cases whose name contains SUBSTR\n";
+        return rest.front() == "--help" ? 0 : 1;
+    }
+
+    try {
+        // Тела запросов: одна запись large_document (типичный запрос API) и
+        // пакет из 64 таких записей
+        std::mt19937 rng(20250101u);
+        const std::vector<std::string> records = bench::makeSchemaDocuments(rng, 64);
+        std::string batch = "[";
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            batch += i == 0 ? "" : ",";
+            batch += records[i];
+        }
+        batch += "]";
+        const std::vector<std::pair<std::string, std::string>> bodies = {
+            {"record", records.front()},
+            {"batch", batch},
+        };
+
+        ServerStats stats;
+        bench::Report report;
+        bench::Report::printHeader(std::cout);
+        for (const auto& [bodyName, body] : bodies) {
+            for (const LoadCase& loadCase : loadCases(maxThreads, connections)) {
+                const std::string name = "http_echo/" + bodyName + "/" + loadCase.name();
+                if (!options.selected(name)) {
+                    continue;
+                }
+                std::size_t errors = 0;
+                double p999 = 0.0;
+                bench::Result r = runCase(name, body, loadCase, requests, stats, errors, p999);
+                report.add(r);
+                std::cout << "    " << std::fixed << std::setprecision(0) << r.docsPerSec() << " req/s, p99.9 "
+                          << std::setprecision(2) << p999 << " us, " << errors << " errors\n";
+                std::cout.unsetf(std::ios::floatfield);
+            }
+        }
+
+        if (!report.writeTSV(options.output)) {
+            std::cerr << "Failed to write " << options.output << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << options.output << std::endl;
+    } catch (const Poco::Exception& e) {
+        std::cerr << "Benchmark failed: " << e.displayText() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
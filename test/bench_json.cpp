@@ -0,0 +1,912 @@
+// Бенчмарк пропускной способности Poco::JSON::Parser::parse и Object::stringify
+// на фиксированном корпусе сгенерированных документов.
+//
+// Результаты печатаются таблицей и сохраняются в TSV (по умолчанию
+// bench_output.txt) для сравнения между сборками Poco.
+
+#include "bench_util.h"
+#include "bench_corpus.h"
+#include "reusable_parser.h"
+#include "arena_json.h"
+#include "json_reader.h"
+#include "json_push_parser.h"
+#include "json_writer.h"
+#include "query_plan.h"
+#include "json_projection.h"
+#include "flat_object.h"
+#include "key_pool.h"
+#include "json_number.h"
+#include "msgpack.h"
+#include "json_clone.h"
+#include "json_template.h"
+#include "json_binding.h"
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Query.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/Template.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Exception.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <typeinfo>
+
+using namespace Poco::JSON;
+
+namespace {
+
+// Разбор документа новым парсером - так же, как это делают тесты и сервисы
+void runParseSuite(const std::vector<bench::CorpusDocument>& corpus,
+                   const bench::Options& options, bench::Report& report) {
+    for (const auto& doc : corpus) {
+        const std::string name = "parse/" + doc.name;
+        if (!options.selected(name)) {
+            continue;
+        }
+        report.add(bench::measure(name, doc.json.size(), options.iterationsFor(doc.json.size()), [&]() {
+            Parser parser;
+            Poco::Dynamic::Var result = parser.parse(doc.json);
+            bench::doNotOptimize(result);
+        }));
+    }
+}
+
+// Разбор одним переиспользуемым парсером: без создания Parser и
+// ParseHandler на каждый документ
+void runParseReuseSuite(const std::vector<bench::CorpusDocument>& corpus,
+                        const bench::Options& options, bench::Report& report) {
+    pocotest::ReusableParser parser;
+    for (const auto& doc : corpus) {
+        const std::string name = "parse_reuse/" + doc.name;
+        if (!options.selected(name)) {
+            continue;
+        }
+        report.add(bench::measure(name, doc.json.size(), options.iterationsFor(doc.json.size()), [&]() {
+            Poco::Dynamic::Var result = parser.parse(doc.json);
+            bench::doNotOptimize(result);
+        }));
+    }
+}
+
+// Разбор в дерево, размещённое в арене (ArenaParser). Сравнивается с
+// parse/* и parse_reuse/* по латентности и числу выделений на документ
+void runParseArenaSuite(const std::vector<bench::CorpusDocument>& corpus,
+                        const bench::Options& options, bench::Report& report) {
+    pocotest::ArenaParser parser;
+    for (const auto& doc : corpus) {
+        const std::string name = "parse_arena/" + doc.name;
+        if (!options.selected(name)) {
+            continue;
+        }
+        report.add(bench::measure(name, doc.json.size(), options.iterationsFor(doc.json.size()), [&]() {
+            pocotest::ArenaDocument result = parser.parse(doc.json);
+            bench::doNotOptimize(result);
+        }));
+    }
+}
+
+// Разбор JsonReader прямо из буфера документа, без копирования в
+// std::string, которого требует Parser::parse
+void runReaderSuite(const std::string& prefix, const std::vector<bench::CorpusDocument>& corpus,
+                    const bench::Options& options, bench::Report& report) {
+    pocotest::JsonReader reader;
+    for (const auto& doc : corpus) {
+        const std::string name = prefix + doc.name;
+        if (!options.selected(name)) {
+            continue;
+        }
+        report.add(bench::measure(name, doc.json.size(), options.iterationsFor(doc.json.size()), [&]() {
+            Poco::Dynamic::Var result = reader.parse(doc.json.data(), doc.json.size());
+            bench::doNotOptimize(result);
+        }));
+    }
+}
+
+void runParseViewSuite(const std::vector<bench::CorpusDocument>& corpus,
+                       const bench::Options& options, bench::Report& report) {
+    runReaderSuite("parse_view/", corpus, options, report);
+}
+
+// То же, что parse_view/*, но со скалярным сканированием: разница с
+// parse_view/* - выигрыш от SSE4.2/AVX2 в json_scan.h
+void runParseViewScalarSuite(const std::vector<bench::CorpusDocument>& corpus,
+                             const bench::Options& options, bench::Report& report) {
+    const pocotest::scan::Level previous = pocotest::scan::activeLevel();
+    pocotest::scan::setLevel(pocotest::scan::Level::Scalar);
+    runReaderSuite("parse_view_scalar/", corpus, options, report);
+    pocotest::scan::setLevel(previous);
+}
+
+// Разбор JsonPushParser кусками фиксированного размера, как тело запроса
+// приходит из сокета: 1460 байт - полезная нагрузка одного TCP-сегмента
+void runParsePushSuite(const std::vector<bench::CorpusDocument>& corpus,
+                       const bench::Options& options, bench::Report& report) {
+    pocotest::JsonPushParser parser;
+    for (std::size_t chunk : {std::size_t(1460), std::size_t(16384)}) {
+        for (const auto& doc : corpus) {
+            const std::string name = "parse_push_" + std::to_string(chunk) + "/" + doc.name;
+            if (!options.selected(name)) {
+                continue;
+            }
+            report.add(bench::measure(name, doc.json.size(), options.iterationsFor(doc.json.size()), [&]() {
+                for (std::size_t offset = 0; offset < doc.json.size(); offset += chunk) {
+                    parser.feed(doc.json.data() + offset, std::min(chunk, doc.json.size() - offset));
+                }
+                Poco::Dynamic::Var result = parser.finish();
+                bench::doNotOptimize(result);
+            }));
+        }
+    }
+}
+
+// Сериализация ранее разобранного дерева в компактный JSON
+void runStringifySuite(const std::vector<bench::CorpusDocument>& corpus,
+                       const bench::Options& options, bench::Report& report) {
+    for (const auto& doc : corpus) {
+        const std::string name = "stringify/" + doc.name;
+        if (!options.selected(name)) {
+            continue;
+        }
+        report.add(bench::measure(name, doc.json.size(), options.iterationsFor(doc.json.size()), [&]() {
+            std::ostringstream ss;
+            Stringifier::stringify(doc.tree, ss);
+            std::string json = ss.str();
+            bench::doNotOptimize(json);
+        }));
+    }
+}
+
+// Сериализация в переиспользуемый std::string без ostream и копии ss.str()
+void runWriterSuite(const std::string& prefix, const std::vector<bench::CorpusDocument>& corpus,
+                    const bench::Options& options, bench::Report& report) {
+    std::string buffer;
+    for (const auto& doc : corpus) {
+        const std::string name = prefix + doc.name;
+        if (!options.selected(name)) {
+            continue;
+        }
+        report.add(bench::measure(name, doc.json.size(), options.iterationsFor(doc.json.size()), [&]() {
+            pocotest::stringifyTo(doc.tree, buffer);
+            bench::doNotOptimize(buffer);
+        }));
+    }
+}
+
+void runStringifyBufferSuite(const std::vector<bench::CorpusDocument>& corpus,
+                             const bench::Options& options, bench::Report& report) {
+    runWriterSuite("stringify_buffer/", corpus, options, report);
+}
+
+// То же со скалярным поиском участков строк без экранирования
+void runStringifyBufferScalarSuite(const std::vector<bench::CorpusDocument>& corpus,
+                                   const bench::Options& options, bench::Report& report) {
+    const pocotest::scan::Level previous = pocotest::scan::activeLevel();
+    pocotest::scan::setLevel(pocotest::scan::Level::Scalar);
+    runWriterSuite("stringify_buffer_scalar/", corpus, options, report);
+    pocotest::scan::setLevel(previous);
+}
+
+// Поиск по пути в каждой записи large_document: Query::find против
+// скомпилированного один раз QueryPlan. Итерация - все записи документа,
+// после строки отчёта печатается задержка одного поиска
+void runQuerySuite(const std::vector<bench::CorpusDocument>& corpus,
+                   const bench::Options& options, bench::Report& report) {
+    static const char* const paths[] = {"name", "metrics.cpu", "tags[2]", "attributes.field_5"};
+    for (const auto& doc : corpus) {
+        if (doc.name != "large_document") {
+            continue;
+        }
+        const Array::Ptr records = doc.tree.extract<Array::Ptr>();
+        const std::vector<Poco::Dynamic::Var> roots(records->begin(), records->end());
+        const std::size_t iterations = options.iterationsFor(doc.json.size());
+        const auto printLatency = [&](const bench::Result& r) {
+            std::cout << "    " << std::fixed << std::setprecision(1)
+                      << r.p50Us * 1000.0 / roots.size() << " ns/lookup\n";
+            std::cout.unsetf(std::ios::floatfield);
+        };
+
+        for (const char* path : paths) {
+            const std::string queryName = std::string("query/") + path;
+            if (options.selected(queryName)) {
+                bench::Result r = bench::measure(queryName, doc.json.size(), iterations, [&]() {
+                    for (const auto& root : roots) {
+                        Query query(root);
+                        Poco::Dynamic::Var value = query.find(path);
+                        bench::doNotOptimize(value);
+                    }
+                });
+                report.add(r);
+                printLatency(r);
+            }
+
+            const std::string planName = std::string("query_plan/") + path;
+            if (options.selected(planName)) {
+                const pocotest::QueryPlan plan(path);
+                bench::Result r = bench::measure(planName, doc.json.size(), iterations, [&]() {
+                    for (const auto& root : roots) {
+                        Poco::Dynamic::Var value = plan.find(root);
+                        bench::doNotOptimize(value);
+                    }
+                });
+                report.add(r);
+                printLatency(r);
+            }
+        }
+    }
+}
+
+// Выборочный разбор широкого объекта: Parser::parse всего документа и
+// поиск нужных полей против JsonProjection, который разбирает только их.
+// Запрашивается 1% и 5% разделов, из каждого - одно вложенное поле
+void runProjectionSuite(const bench::Options& options, bench::Report& report) {
+    std::mt19937 rng(20250102u);
+    for (int fields : {500, 5000}) {
+        const bench::CorpusDocument doc =
+            bench::makeDocument("wide_" + std::to_string(fields), bench::makeWideDocument(rng, fields));
+        const std::size_t iterations = options.iterationsFor(doc.json.size());
+
+        for (int percent : {1, 5}) {
+            std::vector<std::string> paths;
+            const int step = 100 / percent;
+            for (int i = step / 2; i < fields; i += step) {
+                paths.push_back("section_" + std::to_string(i) + (i % 2 == 0 ? ".metrics.cpu" : ".tags[1]"));
+            }
+            const std::string suffix = doc.name + "_" + std::to_string(percent) + "pct";
+
+            const std::string fullName = "project_full/" + suffix;
+            if (options.selected(fullName)) {
+                std::vector<pocotest::QueryPlan> plans;
+                for (const auto& path : paths) {
+                    plans.emplace_back(path);
+                }
+                report.add(bench::measure(fullName, doc.json.size(), iterations, [&]() {
+                    Parser parser;
+                    const Poco::Dynamic::Var root = parser.parse(doc.json);
+                    for (const auto& plan : plans) {
+                        Poco::Dynamic::Var value = plan.find(root);
+                        bench::doNotOptimize(value);
+                    }
+                }));
+            }
+
+            const std::string projectName = "project/" + suffix;
+            if (options.selected(projectName)) {
+                pocotest::JsonProjection projection(paths);
+                std::vector<Poco::Dynamic::Var> values;
+                report.add(bench::measure(projectName, doc.json.size(), iterations, [&]() {
+                    projection.parse(doc.json.data(), doc.json.size(), values);
+                    bench::doNotOptimize(values);
+                }));
+            }
+        }
+    }
+}
+
+// Объекты с 8, 100 и 1000 ключами: Object, Object с JSON_PRESERVE_KEY_ORDER
+// и FlatObject. Итерация - вставка, поиск всех ключей в случайном порядке
+// или обход в порядке вставки; после строки отчёта печатается время на ключ
+void runObjectSuite(const bench::Options& options, bench::Report& report) {
+    std::mt19937 rng(20250103u);
+    for (int size : {8, 100, 1000}) {
+        std::vector<std::string> keys;
+        std::vector<Poco::Dynamic::Var> values;
+        for (int i = 0; i < size; ++i) {
+            keys.push_back("field_" + bench::randomWord(rng, 4, 12) + "_" + std::to_string(i));
+            values.push_back(static_cast<Poco::Int64>(i));
+        }
+        std::vector<std::string> lookups = keys;
+        std::shuffle(lookups.begin(), lookups.end(), rng);
+
+        Object plain;
+        Object ordered(Poco::JSON_PRESERVE_KEY_ORDER);
+        pocotest::FlatObject flat;
+        for (int i = 0; i < size; ++i) {
+            plain.set(keys[i], values[i]);
+            ordered.set(keys[i], values[i]);
+            flat.set(keys[i], values[i]);
+        }
+        std::ostringstream ss;
+        plain.stringify(ss);
+        const std::size_t bytes = ss.str().size();
+        const std::size_t iterations = options.iterationsFor(bytes);
+        const std::string suffix = "_" + std::to_string(size);
+        const auto run = [&](const std::string& name, auto&& fn) {
+            if (!options.selected(name)) {
+                return;
+            }
+            bench::Result r = bench::measure(name, bytes, iterations, fn);
+            report.add(r);
+            std::cout << "    " << std::fixed << std::setprecision(1)
+                      << r.p50Us * 1000.0 / size << " ns/key\n";
+            std::cout.unsetf(std::ios::floatfield);
+        };
+
+        run("object_insert/poco" + suffix, [&]() {
+            Object object;
+            for (int i = 0; i < size; ++i) {
+                object.set(keys[i], values[i]);
+            }
+            bench::doNotOptimize(object);
+        });
+        run("object_insert/poco_ordered" + suffix, [&]() {
+            Object object(Poco::JSON_PRESERVE_KEY_ORDER);
+            for (int i = 0; i < size; ++i) {
+                object.set(keys[i], values[i]);
+            }
+            bench::doNotOptimize(object);
+        });
+        run("object_insert/flat" + suffix, [&]() {
+            pocotest::FlatObject object;
+            object.reserve(keys.size());
+            for (int i = 0; i < size; ++i) {
+                object.set(keys[i], values[i]);
+            }
+            bench::doNotOptimize(object);
+        });
+
+        run("object_lookup/poco" + suffix, [&]() {
+            Poco::Int64 sum = 0;
+            for (const auto& key : lookups) {
+                sum += plain.getValue<Poco::Int64>(key);
+            }
+            bench::doNotOptimize(sum);
+        });
+        run("object_lookup/flat" + suffix, [&]() {
+            Poco::Int64 sum = 0;
+            for (const auto& key : lookups) {
+                sum += flat.find(key)->extract<Poco::Int64>();
+            }
+            bench::doNotOptimize(sum);
+        });
+
+        run("object_iterate/poco" + suffix, [&]() {
+            Poco::Int64 sum = 0;
+            for (const auto& member : plain) {
+                sum += member.second.extract<Poco::Int64>();
+            }
+            bench::doNotOptimize(sum);
+        });
+        // Порядок вставки у Object - только через getNames() и get()
+        run("object_iterate/poco_ordered" + suffix, [&]() {
+            Poco::Int64 sum = 0;
+            for (const auto& name : ordered.getNames()) {
+                sum += ordered.get(name).extract<Poco::Int64>();
+            }
+            bench::doNotOptimize(sum);
+        });
+        run("object_iterate/flat" + suffix, [&]() {
+            Poco::Int64 sum = 0;
+            for (const auto& member : flat) {
+                sum += member.second.extract<Poco::Int64>();
+            }
+            bench::doNotOptimize(sum);
+        });
+    }
+}
+
+// 100k документов одной схемы в ArenaParser: ключи копируются в арену
+// каждого документа против общего KeyPool. Итерация разбирает все документы
+// и держит деревья до конца итерации; после строки отчёта печатается объём
+// арен всех документов и экономия от пула
+void runKeyPoolSuite(const bench::Options& options, bench::Report& report) {
+    const bool copySelected = options.selected("key_pool/arena_copy");
+    const bool internSelected = options.selected("key_pool/arena_interned");
+    if (!copySelected && !internSelected) {
+        return;
+    }
+    std::mt19937 rng(20250104u);
+    const std::vector<std::string> documents = bench::makeSchemaDocuments(rng, 100000);
+    std::size_t bytes = 0;
+    for (const auto& json : documents) {
+        bytes += json.size();
+    }
+    const std::size_t iterations = options.iterationsFor(bytes);
+
+    const auto parseAll = [&](pocotest::ArenaParser& parser) {
+        std::vector<pocotest::ArenaDocument> trees;
+        trees.reserve(documents.size());
+        for (const auto& json : documents) {
+            trees.push_back(parser.parse(json));
+        }
+        return trees;
+    };
+    const auto arenaBytes = [](const std::vector<pocotest::ArenaDocument>& trees) {
+        std::size_t total = 0;
+        for (const auto& tree : trees) {
+            total += tree.arenaBytes();
+        }
+        return total;
+    };
+
+    // Первый блок арены - по размеру предыдущего документа, так что
+    // начальный размер мал, чтобы не мерить запас блока
+    std::size_t copiedBytes = 0;
+    double copiedSpeed = 0.0;
+    if (copySelected) {
+        pocotest::ArenaParser parser(256);
+        copiedBytes = arenaBytes(parseAll(parser));
+        bench::Result r = bench::measure("key_pool/arena_copy", bytes, iterations, [&]() {
+            std::vector<pocotest::ArenaDocument> trees = parseAll(parser);
+            bench::doNotOptimize(trees);
+        });
+        copiedSpeed = r.mbPerSec();
+        report.add(r);
+        std::cout << "    arenas: " << copiedBytes / 1024 << " KB\n";
+    }
+
+    if (internSelected) {
+        pocotest::KeyPool::Ptr pool = new pocotest::KeyPool();
+        pocotest::ArenaParser parser(256);
+        parser.setKeyPool(pool);
+        const std::size_t internedBytes = arenaBytes(parseAll(parser));
+        bench::Result r = bench::measure("key_pool/arena_interned", bytes, iterations, [&]() {
+            std::vector<pocotest::ArenaDocument> trees = parseAll(parser);
+            bench::doNotOptimize(trees);
+        });
+        report.add(r);
+        const pocotest::KeyPoolStats stats = pool->stats();
+        std::cout << "    arenas: " << internedBytes / 1024 << " KB, pool: " << stats.keys
+                  << " keys in " << stats.bytes << " bytes";
+        if (copiedBytes > 0) {
+            std::cout << ", saved " << (copiedBytes - internedBytes) / 1024 << " KB ("
+                      << std::fixed << std::setprecision(1)
+                      << 100.0 * (copiedBytes - internedBytes) / copiedBytes << "%)"
+                      << ", speedup x" << std::setprecision(2) << r.mbPerSec() / copiedSpeed;
+            std::cout.unsetf(std::ios::floatfield);
+        }
+        std::cout << '\n';
+    }
+}
+
+// Числа number_array по отдельности: разбор текста NumberParser против
+// json_number.h, форматирование double через Dynamic::Var против
+// formatDouble и извлечение double из Var через convert против
+// convertValue. Итерация - все числа документа; после строки отчёта
+// печатается время на число
+void runNumberSuite(const std::vector<bench::CorpusDocument>& corpus,
+                    const bench::Options& options, bench::Report& report) {
+    for (const auto& doc : corpus) {
+        if (doc.name != "number_array") {
+            continue;
+        }
+        const Array::Ptr numbers = doc.tree.extract<Array::Ptr>();
+        const std::vector<Poco::Dynamic::Var> values(numbers->begin(), numbers->end());
+        std::vector<std::string> texts;
+        std::vector<bool> integers;
+        std::vector<double> doubles;
+        std::size_t textBytes = 0;
+        for (const auto& value : values) {
+            texts.push_back(value.convert<std::string>());
+            integers.push_back(value.type() != typeid(double));
+            textBytes += texts.back().size();
+            if (value.type() == typeid(double)) {
+                doubles.push_back(value.extract<double>());
+            }
+        }
+        const std::size_t iterations = options.iterationsFor(textBytes);
+        const auto run = [&](const std::string& name, std::size_t count, auto&& fn) {
+            if (!options.selected(name)) {
+                return;
+            }
+            bench::Result r = bench::measure(name, textBytes, iterations, fn);
+            report.add(r);
+            std::cout << "    " << std::fixed << std::setprecision(1)
+                      << r.p50Us * 1000.0 / count << " ns/number\n";
+            std::cout.unsetf(std::ios::floatfield);
+        };
+
+        // Как разбирал числа JsonReader до json_number.h
+        run("number_parse/poco", texts.size(), [&]() {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < texts.size(); ++i) {
+                Poco::Int64 value = 0;
+                if (integers[i] && Poco::NumberParser::tryParse64(texts[i], value)) {
+                    sum += static_cast<double>(value);
+                } else {
+                    sum += Poco::NumberParser::parseFloat(texts[i]);
+                }
+            }
+            bench::doNotOptimize(sum);
+        });
+        run("number_parse/fast", texts.size(), [&]() {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < texts.size(); ++i) {
+                const char* begin = texts[i].data();
+                const char* end = begin + texts[i].size();
+                Poco::Int64 value = 0;
+                double real = 0.0;
+                if (integers[i] && pocotest::number::parseInt64(begin, end, value)) {
+                    sum += static_cast<double>(value);
+                } else if (pocotest::number::parseDouble(begin, end, real)) {
+                    sum += real;
+                }
+            }
+            bench::doNotOptimize(sum);
+        });
+
+        run("number_format/poco", doubles.size(), [&]() {
+            std::size_t length = 0;
+            for (double value : doubles) {
+                length += Poco::Dynamic::Var(value).convert<std::string>().size();
+            }
+            bench::doNotOptimize(length);
+        });
+        run("number_format/shortest", doubles.size(), [&]() {
+            std::size_t length = 0;
+            char buffer[pocotest::number::MAX_DOUBLE_CHARS];
+            for (double value : doubles) {
+                length += static_cast<std::size_t>(pocotest::number::formatDouble(value, buffer) - buffer);
+            }
+            bench::doNotOptimize(length);
+        });
+
+        run("number_convert/var", values.size(), [&]() {
+            double sum = 0.0;
+            for (const auto& value : values) {
+                sum += value.convert<double>();
+            }
+            bench::doNotOptimize(sum);
+        });
+        run("number_convert/typed", values.size(), [&]() {
+            double sum = 0.0;
+            for (const auto& value : values) {
+                sum += pocotest::number::convertValue<double>(value);
+            }
+            bench::doNotOptimize(sum);
+        });
+    }
+}
+
+// Двоичный обмен MessagePack против текста на том же корпусе: msgpack_pack/*
+// сравнивается со stringify_buffer/*, msgpack_unpack/* - с parse_view/*.
+// Пропускная способность считается по размеру текста документа, чтобы
+// MB/s были сравнимы; после строки отчёта печатается размер кодировки
+void runMsgPackSuite(const std::vector<bench::CorpusDocument>& corpus,
+                     const bench::Options& options, bench::Report& report) {
+    std::string buffer;
+    pocotest::MsgPackReader reader;
+    for (const auto& doc : corpus) {
+        std::string encoded;
+        pocotest::packTo(doc.tree, encoded);
+        const std::size_t iterations = options.iterationsFor(doc.json.size());
+
+        const std::string packName = "msgpack_pack/" + doc.name;
+        if (options.selected(packName)) {
+            report.add(bench::measure(packName, doc.json.size(), iterations, [&]() {
+                pocotest::packTo(doc.tree, buffer);
+                bench::doNotOptimize(buffer);
+            }));
+        }
+
+        const std::string unpackName = "msgpack_unpack/" + doc.name;
+        if (options.selected(unpackName)) {
+            report.add(bench::measure(unpackName, doc.json.size(), iterations, [&]() {
+                Poco::Dynamic::Var result = reader.parse(encoded);
+                bench::doNotOptimize(result);
+            }));
+        }
+
+        if (options.selected(packName) || options.selected(unpackName)) {
+            std::cout << "    " << encoded.size() << " bytes msgpack vs " << doc.json.size()
+                      << " bytes JSON (" << std::fixed << std::setprecision(1)
+                      << 100.0 * static_cast<double>(encoded.size()) / static_cast<double>(doc.json.size())
+                      << "%)\n";
+            std::cout.unsetf(std::ios::floatfield);
+        }
+    }
+}
+
+// Копия дерева на запрос: stringify и Parser::parse (как в
+// TestCopySemanticsAndOwnership) против cloneValue и CowTree с правкой
+// одного значения первого уровня (у корня-массива - первого элемента)
+void runCloneSuite(const std::vector<bench::CorpusDocument>& corpus,
+                   const bench::Options& options, bench::Report& report) {
+    for (const auto& doc : corpus) {
+        const std::size_t iterations = options.iterationsFor(doc.json.size());
+        const bool arrayRoot = doc.tree.type() == typeid(Array::Ptr);
+
+        const std::string roundTripName = "clone_roundtrip/" + doc.name;
+        if (options.selected(roundTripName)) {
+            report.add(bench::measure(roundTripName, doc.json.size(), iterations, [&]() {
+                std::ostringstream ss;
+                Stringifier::stringify(doc.tree, ss);
+                Parser parser;
+                Poco::Dynamic::Var copy = parser.parse(ss.str());
+                bench::doNotOptimize(copy);
+            }));
+        }
+
+        const std::string deepName = "clone_deep/" + doc.name;
+        if (options.selected(deepName)) {
+            report.add(bench::measure(deepName, doc.json.size(), iterations, [&]() {
+                Poco::Dynamic::Var copy = pocotest::cloneValue(doc.tree);
+                bench::doNotOptimize(copy);
+            }));
+        }
+
+        const std::string cowName = "clone_cow/" + doc.name;
+        if (options.selected(cowName)) {
+            report.add(bench::measure(cowName, doc.json.size(), iterations, [&]() {
+                pocotest::CowTree copy(doc.tree);
+                if (arrayRoot) {
+                    copy.editArray().set(0, 1);
+                } else {
+                    copy.editObject().set("request_id", 1);
+                }
+                bench::doNotOptimize(copy);
+            }));
+        }
+    }
+}
+
+// Ответ по шаблону для первых 500 записей large_document: Template::render
+// (шаблон разобран один раз) в ostringstream против CompiledTemplate в
+// переиспользуемый std::string. Пропускная способность - по размеру вывода
+void runTemplateSuite(const std::vector<bench::CorpusDocument>& corpus,
+                      const bench::Options& options, bench::Report& report) {
+    static const char* const source =
+        "{\"title\": \"<? echo title ?>\", \"records\": [\n"
+        "<? for record records ?>"
+        "  {\"id\": <? echo record.id ?>, \"name\": \"<? echo record.name ?>\", "
+        "\"cpu\": <? echo record.metrics.cpu ?>, \"tags\": \""
+        "<? for tag record.tags ?><? echo tag ?> <? endfor ?>\""
+        "<? if record.attributes.field_0 ?>, \"field_0\": \"<? echo record.attributes.field_0 ?>\"<? endif ?>},\n"
+        "<? endfor ?>"
+        "]}\n";
+    for (const auto& doc : corpus) {
+        if (doc.name != "large_document") {
+            continue;
+        }
+        const Array::Ptr all = doc.tree.extract<Array::Ptr>();
+        Array::Ptr records = new Array();
+        for (unsigned i = 0; i < 500 && i < all->size(); ++i) {
+            records->add(all->get(i));
+        }
+        Object::Ptr data = new Object();
+        data->set("title", "records");
+        data->set("records", records);
+
+        Template poco;
+        poco.parse(source);
+        const pocotest::CompiledTemplate compiled(source);
+        std::string buffer;
+        compiled.render(data, buffer);
+        const std::size_t bytes = buffer.size();
+        const std::size_t iterations = options.iterationsFor(bytes);
+
+        if (options.selected("template_poco/records")) {
+            report.add(bench::measure("template_poco/records", bytes, iterations, [&]() {
+                std::ostringstream ss;
+                poco.render(data, ss);
+                std::string out = ss.str();
+                bench::doNotOptimize(out);
+            }));
+        }
+        if (options.selected("template_compiled/records")) {
+            report.add(bench::measure("template_compiled/records", bytes, iterations, [&]() {
+                buffer.clear();
+                compiled.render(data, buffer);
+                bench::doNotOptimize(buffer);
+            }));
+        }
+    }
+}
+
+} // namespace
+
+// Запись large_document для runBindingSuite; attributes в схему не входят
+struct BoundMetrics {
+    double cpu = 0.0;
+    double mem = 0.0;
+    int rps = 0;
+};
+
+struct BoundRecord {
+    std::string description;
+    int id = 0;
+    BoundMetrics metrics;
+    std::string name;
+    std::vector<std::string> tags;
+};
+
+namespace pocotest {
+namespace binding {
+
+template <>
+struct Schema<BoundMetrics> {
+    static constexpr auto fields = std::make_tuple(
+        field("cpu", &BoundMetrics::cpu), field("mem", &BoundMetrics::mem), field("rps", &BoundMetrics::rps));
+};
+
+template <>
+struct Schema<BoundRecord> {
+    static constexpr auto fields = std::make_tuple(
+        field("description", &BoundRecord::description), field("id", &BoundRecord::id),
+        field("metrics", &BoundRecord::metrics), field("name", &BoundRecord::name), field("tags", &BoundRecord::tags));
+};
+
+} // namespace binding
+} // namespace pocotest
+
+namespace {
+
+// Копирование полей из дерева через getValue, как в обработчиках
+void bindFromTree(const Array& records, std::vector<BoundRecord>& out) {
+    out.resize(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const Object::Ptr object = records.getObject(static_cast<unsigned>(i));
+        BoundRecord& record = out[i];
+        record.description = object->getValue<std::string>("description");
+        record.id = object->getValue<int>("id");
+        const Object::Ptr metrics = object->getObject("metrics");
+        record.metrics.cpu = metrics->getValue<double>("cpu");
+        record.metrics.mem = metrics->getValue<double>("mem");
+        record.metrics.rps = metrics->getValue<int>("rps");
+        record.name = object->getValue<std::string>("name");
+        record.tags.clear();
+        for (const auto& tag : *object->getArray("tags")) {
+            record.tags.push_back(tag.convert<std::string>());
+        }
+    }
+}
+
+Array::Ptr recordsToTree(const std::vector<BoundRecord>& records) {
+    Array::Ptr array = new Array();
+    for (const auto& record : records) {
+        Object::Ptr object = new Object();
+        object->set("description", record.description);
+        object->set("id", record.id);
+        Object::Ptr metrics = new Object();
+        metrics->set("cpu", record.metrics.cpu);
+        metrics->set("mem", record.metrics.mem);
+        metrics->set("rps", record.metrics.rps);
+        object->set("metrics", metrics);
+        object->set("name", record.name);
+        Array::Ptr tags = new Array();
+        for (const auto& tag : record.tags) {
+            tags->add(tag);
+        }
+        object->set("tags", tags);
+        array->add(object);
+    }
+    return array;
+}
+
+// Структуры из JSON и обратно для первых 2000 записей large_document:
+//   bind_tree/records        - Parser::parse и getValue по полям (базовый
+//                              вариант);
+//   bind_struct/records      - JsonBinding: JsonReader и BindingHandler
+//                              прямо в переиспользуемый вектор структур;
+//   bind_struct_poco/records - тот же BindingHandler под Poco Parser;
+//   write_tree/records       - Object из структур и Stringifier::condense;
+//   write_struct/records     - JsonBinding::stringify в переиспользуемую
+//                              строку.
+// Разбор считается по размеру входа (с attributes, которые пропускаются),
+// запись - по размеру вывода. Перед замерами проверяется, что все пути
+// дают одинаковые структуры и одинаковый текст
+void runBindingSuite(const std::vector<bench::CorpusDocument>& corpus,
+                     const bench::Options& options, bench::Report& report) {
+    for (const auto& doc : corpus) {
+        if (doc.name != "large_document") {
+            continue;
+        }
+        const Array::Ptr all = doc.tree.extract<Array::Ptr>();
+        Array::Ptr records = new Array();
+        for (unsigned i = 0; i < 2000 && i < all->size(); ++i) {
+            records->add(all->get(i));
+        }
+        std::ostringstream input;
+        Stringifier::condense(records, input);
+        const std::string json = input.str();
+
+        pocotest::binding::JsonBinding<std::vector<BoundRecord>> binding;
+        std::vector<BoundRecord> expected;
+        bindFromTree(*records, expected);
+        std::vector<BoundRecord> bound;
+        binding.parse(json, bound);
+        std::string output;
+        binding.stringify(bound, output);
+        std::ostringstream treeOutput;
+        Stringifier::condense(recordsToTree(expected), treeOutput);
+        if (output != treeOutput.str()) {
+            throw Poco::LogicException("binding and tree differ", "bind/records");
+        }
+
+        Parser bindingParser(binding.handler());
+        binding.handler()->setTarget(&bound);
+        const std::size_t parseIterations = options.iterationsFor(json.size());
+        const std::size_t writeIterations = options.iterationsFor(output.size());
+
+        if (options.selected("bind_tree/records")) {
+            std::vector<BoundRecord> out;
+            report.add(bench::measure("bind_tree/records", json.size(), parseIterations, [&]() {
+                Parser parser;
+                const Poco::Dynamic::Var result = parser.parse(json);
+                bindFromTree(*result.extract<Array::Ptr>(), out);
+                bench::doNotOptimize(out);
+            }));
+        }
+        if (options.selected("bind_struct/records")) {
+            report.add(bench::measure("bind_struct/records", json.size(), parseIterations, [&]() {
+                binding.parse(json, bound);
+                bench::doNotOptimize(bound);
+            }));
+        }
+        if (options.selected("bind_struct_poco/records")) {
+            report.add(bench::measure("bind_struct_poco/records", json.size(), parseIterations, [&]() {
+                bindingParser.reset();
+                bindingParser.parse(json);
+                bench::doNotOptimize(bound);
+            }));
+        }
+        if (options.selected("write_tree/records")) {
+            report.add(bench::measure("write_tree/records", output.size(), writeIterations, [&]() {
+                std::ostringstream ss;
+                Stringifier::condense(recordsToTree(bound), ss);
+                std::string out = ss.str();
+                bench::doNotOptimize(out);
+            }));
+        }
+        if (options.selected("write_struct/records")) {
+            report.add(bench::measure("write_struct/records", output.size(), writeIterations, [&]() {
+                binding.stringify(bound, output);
+                bench::doNotOptimize(output);
+            }));
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    const std::vector<std::string> rest = bench::parseOptions(argc, argv, options);
+    if (!rest.empty()) {
+        bench::printUsage(argv[0], rest.front() == "--help" ? std::cout : std::cerr);
+        return rest.front() == "--help" ? 0 : 1;
+    }
+
+    try {
+        std::cout << "JSON scan level: " << pocotest::scan::levelName(pocotest::scan::supportedLevel()) << std::endl;
+        std::cout << "Generating corpus..." << std::endl;
+        const std::vector<bench::CorpusDocument> corpus = bench::buildCorpus();
+
+        bench::Report report;
+        bench::Report::printHeader(std::cout);
+        runParseSuite(corpus, options, report);
+        runParseReuseSuite(corpus, options, report);
+        runParseArenaSuite(corpus, options, report);
+        runParseViewSuite(corpus, options, report);
+        runParseViewScalarSuite(corpus, options, report);
+        runParsePushSuite(corpus, options, report);
+        runStringifySuite(corpus, options, report);
+        runStringifyBufferSuite(corpus, options, report);
+        runStringifyBufferScalarSuite(corpus, options, report);
+        runQuerySuite(corpus, options, report);
+        runProjectionSuite(options, report);
+        runObjectSuite(options, report);
+        runKeyPoolSuite(options, report);
+        runNumberSuite(corpus, options, report);
+        runMsgPackSuite(corpus, options, report);
+        runCloneSuite(corpus, options, report);
+        runTemplateSuite(corpus, options, report);
+        runBindingSuite(corpus, options, report);
+
+        if (!report.writeTSV(options.output)) {
+            std::cerr << "Failed to write " << options.output << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << options.output << std::endl;
+    } catch (const Poco::Exception& e) {
+        std::cerr << "Benchmark failed: " << e.displayText() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+// Масштабирование Poco::JSON по потокам.
+//
+// Каждый поток разбирает документы собственным Parser и сериализует общие
+// (только для чтения) деревья Object::Ptr. Для каждого числа потоков от 1 до
+// nproc печатается суммарная пропускная способность и эффективность
+// масштабирования относительно одного потока: провалы указывают на конкуренцию
+// в аллокаторе и на перекидывание кэш-линий счётчиков ссылок
+// Object/Array/Dynamic::Var.
+
+#include "bench_util.h"
+#include "bench_corpus.h"
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Exception.h>
+
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+using namespace Poco::JSON;
+
+namespace {
+
+// Запускает fn(thread) в threads потоках по iterations раз в каждом.
+// Все потоки стартуют одновременно; время меряется от старта до завершения
+// последнего потока
+template <typename Fn>
+bench::Result measureThreads(const std::string& name, std::size_t bytes,
+                             unsigned threads, std::size_t iterations, Fn&& fn) {
+    std::vector<std::vector<double>> samples(threads);
+    std::vector<std::size_t> allocations(threads, 0);
+    std::vector<std::exception_ptr> errors(threads);
+    std::atomic<unsigned> ready(0);
+    std::atomic<bool> go(false);
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            bool counted = false;
+            try {
+                std::vector<double>& local = samples[t];
+                local.reserve(iterations);
+                fn(t);  // прогрев
+                ready.fetch_add(1);
+                counted = true;
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                const pocotest::AllocationScope scope;
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    const bench::Clock::time_point t0 = bench::Clock::now();
+                    fn(t);
+                    const bench::Clock::time_point t1 = bench::Clock::now();
+                    local.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+                }
+                allocations[t] = scope.delta().allocations;
+            } catch (...) {
+                // Исключение бросается заново после join(); при ошибке
+                // прогрева поток всё равно считается готовым, иначе старт
+                // ждал бы его вечно
+                errors[t] = std::current_exception();
+                if (!counted) {
+                    ready.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    while (ready.load() < threads) {
+        std::this_thread::yield();
+    }
+    const bench::Clock::time_point start = bench::Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const bench::Clock::time_point stop = bench::Clock::now();
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::vector<double> all;
+    all.reserve(threads * iterations);
+    std::size_t allocationCount = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        all.insert(all.end(), samples[t].begin(), samples[t].end());
+        allocationCount += allocations[t];
+    }
+
+    bench::Result result;
+    result.name = name;
+    result.bytes = bytes;
+    result.iterations = threads * iterations;
+    result.totalSeconds = std::chrono::duration<double>(stop - start).count();
+    result.p50Us = bench::percentile(all, 50.0);
+    result.p99Us = bench::percentile(all, 99.0);
+    result.allocsPerDoc = static_cast<double>(allocationCount) / result.iterations;
+    return result;
+}
+
+void printScaling(const std::map<std::string, double>& singleThread, const bench::Result& r, unsigned threads) {
+    const std::string base = r.name.substr(0, r.name.rfind('/'));
+    auto it = singleThread.find(base);
+    if (it == singleThread.end() || it->second <= 0.0) {
+        return;
+    }
+    const double speedup = r.docsPerSec() / it->second;
+    std::cout << "    speedup x" << std::fixed << std::setprecision(2) << speedup
+              << ", efficiency " << std::setprecision(1) << speedup / threads * 100.0 << "%\n";
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    options.targetBytes = 16u * 1024u * 1024u;
+    options.output = "bench_mt_output.txt";
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::string> rest = bench::parseOptions(argc, argv, options);
+    for (std::size_t i = 0; i < rest.size(); ++i) {
+        if (rest[i] == "--threads" && i + 1 < rest.size()) {
+            maxThreads = std::max(1, std::atoi(rest[i + 1].c_str()));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+            break;
+        }
+    }
+    if (!rest.empty()) {
+        std::ostream& out = rest.front() == "--help" ? std::cout : std::cerr;
+        bench::printUsage(argv[0], out);
+        out << "  --threads N     maximum number of threads (default: nproc)\n";
+        return rest.front() == "--help" ? 0 : 1;
+    }
+
+    try {
+        std::cout << "Generating corpus..." << std::endl;
+        const std::vector<bench::CorpusDocument> corpus = bench::buildCorpus();
+
+        bench::Report report;
+        std::map<std::string, double> singleThread;
+        bench::Report::printHeader(std::cout);
+
+        for (unsigned threads : bench::threadCounts(maxThreads)) {
+            const std::string suffix = "/" + std::to_string(threads) + "t";
+            for (const auto& doc : corpus) {
+                // Объём работы на поток фиксирован, поэтому при идеальном
+                // масштабировании время прогона не зависит от числа потоков
+                const std::size_t iterations = options.iterationsFor(doc.json.size());
+
+                const std::string parseName = "mt_parse/" + doc.name + suffix;
+                if (options.selected(parseName)) {
+                    bench::Result r = measureThreads(parseName, doc.json.size(), threads, iterations, [&](unsigned) {
+                        Parser parser;
+                        Poco::Dynamic::Var result = parser.parse(doc.json);
+                        bench::doNotOptimize(result);
+                    });
+                    if (threads == 1) {
+                        singleThread["mt_parse/" + doc.name] = r.docsPerSec();
+                    }
+                    report.add(r);
+                    printScaling(singleThread, r, threads);
+                }
+
+                const std::string stringifyName = "mt_stringify/" + doc.name + suffix;
+                if (options.selected(stringifyName)) {
+                    bench::Result r = measureThreads(stringifyName, doc.json.size(), threads, iterations, [&](unsigned) {
+                        std::ostringstream ss;
+                        Stringifier::stringify(doc.tree, ss);
+                        bench::doNotOptimize(ss);
+                    });
+                    if (threads == 1) {
+                        singleThread["mt_stringify/" + doc.name] = r.docsPerSec();
+                    }
+                    report.add(r);
+                    printScaling(singleThread, r, threads);
+                }
+            }
+        }
+
+        if (!report.writeTSV(options.output)) {
+            std::cerr << "Failed to write " << options.output << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << options.output << std::endl;
+    } catch (const Poco::Exception& e) {
+        std::cerr << "Benchmark failed: " << e.displayText() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,223 @@
+// Потоковый разбор JSON-документа размером в несколько гигабайт.
+//
+// Генерирует на диск детерминированный массив записей (по умолчанию 2 GB),
+// не держа его в памяти, и разбирает файл JsonReader::parseFile с
+// обработчиком, который только считает события. Для каждого размера блока
+// печатается пропускная способность и пиковый RSS процесса: при потоковом
+// разборе он не должен зависеть от размера файла.
+
+#include "bench_util.h"
+#include "json_reader.h"
+
+#include <Poco/File.h>
+#include <Poco/Exception.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace {
+
+// Обработчик, который только считает события
+class CountingHandler : public pocotest::SaxHandler {
+public:
+    void reset() override {
+        objects = 0;
+        values = 0;
+    }
+
+    void startObject() override {
+        ++objects;
+    }
+
+    void null() override {
+        ++values;
+    }
+
+    void value(Poco::Int64) override {
+        ++values;
+    }
+
+    void value(Poco::UInt64) override {
+        ++values;
+    }
+
+    void value(const std::string&) override {
+        ++values;
+    }
+
+    void value(double) override {
+        ++values;
+    }
+
+    void value(bool) override {
+        ++values;
+    }
+
+    std::size_t objects = 0;
+    std::size_t values = 0;
+};
+
+// Пишет массив записей до достижения bytes байт; возвращает размер файла
+std::size_t generateFile(const std::string& path, std::size_t bytes) {
+    static const char* const words[] = {
+        "alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta",
+        "\\u00e9t\\u00e9", "caf\xC3\xA9", "\\\"quoted\\\"", "line\\nbreak"
+    };
+    const std::size_t wordCount = sizeof(words) / sizeof(words[0]);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw Poco::CreateFileException(path);
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> word(0, wordCount - 1);
+    std::uniform_int_distribution<int> number(-1000000, 1000000);
+    std::uniform_real_distribution<double> real(0.0, 1000.0);
+
+    std::string record;
+    std::size_t written = 0;
+    std::size_t id = 0;
+    out << '[';
+    written += 1;
+    while (written < bytes) {
+        record.clear();
+        if (id != 0) {
+            record += ",\n";
+        }
+        record += "{\"id\": " + std::to_string(id)
+            + ", \"value\": " + std::to_string(number(rng))
+            + ", \"score\": " + std::to_string(real(rng))
+            + ", \"active\": " + (id % 3 == 0 ? "true" : "false")
+            + ", \"parent\": null, \"name\": \"";
+        record += words[word(rng)];
+        record += ' ';
+        record += words[word(rng)];
+        record += "\", \"tags\": [\"";
+        record += words[word(rng)];
+        record += "\", \"";
+        record += words[word(rng)];
+        record += "\"], \"meta\": {\"source\": \"generator\", \"rank\": " + std::to_string(id % 100) + "}}";
+        out.write(record.data(), static_cast<std::streamsize>(record.size()));
+        written += record.size();
+        ++id;
+    }
+    out << "]\n";
+    written += 2;
+    if (!out.flush()) {
+        throw Poco::WriteFileException(path);
+    }
+    return written;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    options.output = "bench_stream_output.txt";
+    std::size_t sizeMb = 2048;
+    std::string path = "bench_stream_input.json";
+    bool keep = false;
+
+    std::vector<std::string> rest = bench::parseOptions(argc, argv, options);
+    if (options.quick) {
+        sizeMb = 256;
+    }
+    for (std::size_t i = 0; i < rest.size();) {
+        if (rest[i] == "--size-mb" && i + 1 < rest.size()) {
+            sizeMb = static_cast<std::size_t>(std::max(1, std::atoi(rest[i + 1].c_str())));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--file" && i + 1 < rest.size()) {
+            path = rest[i + 1];
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--keep") {
+            keep = true;
+            rest.erase(rest.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+    if (!rest.empty()) {
+        std::ostream& out = rest.front() == "--help" ? std::cout : std::cerr;
+        out << "Usage: " << argv[0] << " [--quick] [--size-mb N] [--file PATH] [--keep] [--output FILE] [--filter SUBSTR]\n"
+            << "  --quick         short run (256 MB file)\n"
+            << "  --size-mb N     size of the generated file (default: 2048)\n"
+            << "  --file PATH     input file; generated if missing (default: bench_stream_input.json)\n"
+            << "  --keep          keep the generated file for the next run\n"
+            << "  --output FILE   machine-readable TSV report (default: bench_stream_output.txt)\n"
+            << "  --filter SUBSTR run only cases whose name contains SUBSTR\n";
+        return rest.front() == "--help" ? 0 : 1;
+    }
+
+    Poco::File file(path);
+    const bool generated = !file.exists();
+    try {
+        std::size_t bytes = 0;
+        if (generated) {
+            std::cout << "Generating " << sizeMb << " MB into " << path << "..." << std::endl;
+            bytes = generateFile(path, sizeMb * 1024u * 1024u);
+        } else {
+            bytes = static_cast<std::size_t>(file.getSize());
+            std::cout << "Using existing " << path << " (" << bytes / (1024 * 1024) << " MB)" << std::endl;
+        }
+        std::cout << "JSON scan level: " << pocotest::scan::levelName(pocotest::scan::activeLevel()) << '\n'
+                  << "Peak RSS before parsing: " << std::fixed << std::setprecision(1) << bench::peakRssMb() << " MB"
+                  << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+
+        bench::Report report;
+        bench::Report::printHeader(std::cout);
+        for (std::size_t chunk : {std::size_t(4 * 1024), std::size_t(64 * 1024), std::size_t(1024 * 1024)}) {
+            const std::string name = "stream_file/" + std::to_string(chunk / 1024) + "k";
+            if (!options.selected(name)) {
+                continue;
+            }
+            Poco::SharedPtr<CountingHandler> handler = new CountingHandler();
+            pocotest::JsonReader reader(handler);
+            reader.setChunkSize(chunk);
+
+            // Файл больше любого кэша, так что один проход без прогрева
+            const pocotest::AllocationScope allocations;
+            const bench::Clock::time_point start = bench::Clock::now();
+            reader.parseFile(path);
+            const bench::Clock::time_point stop = bench::Clock::now();
+
+            bench::Result r;
+            r.name = name;
+            r.bytes = reader.bytesConsumed();
+            r.iterations = 1;
+            r.totalSeconds = std::chrono::duration<double>(stop - start).count();
+            r.p50Us = r.totalSeconds * 1e6;
+            r.p99Us = r.p50Us;
+            r.allocsPerDoc = static_cast<double>(allocations.delta().allocations);
+            report.add(r);
+            std::cout << "    " << handler->objects << " objects, " << handler->values << " values, peak RSS "
+                      << std::fixed << std::setprecision(1) << bench::peakRssMb() << " MB\n";
+            std::cout.unsetf(std::ios::floatfield);
+        }
+
+        if (generated && !keep) {
+            file.remove();
+        }
+        if (!report.writeTSV(options.output)) {
+            std::cerr << "Failed to write " << options.output << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << options.output << std::endl;
+    } catch (const Poco::Exception& e) {
+        std::cerr << "Benchmark failed: " << e.displayText() << std::endl;
+        if (generated && !keep) {
+            std::remove(path.c_str());
+        }
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        if (generated && !keep) {
+            std::remove(path.c_str());
+        }
+        return 1;
+    }
+    return 0;
+}
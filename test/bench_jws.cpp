@@ -0,0 +1,233 @@
+// Подпись и проверка канонизированных JSON-сообщений (jws_signer.h).
+//
+// Сообщения - записи large_document. Для HS256 и RS256:
+//   jws_naive/<alg>            - на каждое сообщение новый ostringstream для
+//                                Stringifier::condense, новый контекст
+//                                HMACEngine или RSADigestEngine и
+//                                Poco::Base64Encoder (базовый вариант);
+//   jws_sign/<alg>/1t          - один JwsSigner с переиспользуемыми
+//                                контекстами и буферами;
+//   jws_sign_batch/<alg>/<N>t  - JwsBatchSigner::sign в N потоках;
+//   jws_verify/<alg>/1t        - JwsSigner::verify(payload, token);
+//   jws_verify_batch/<alg>/<N>t - JwsBatchSigner::verify в N потоках.
+// Одна итерация - пакет из --batch сообщений; bytes - суммарный размер их
+// канонического вида. Перед замерами проверяется, что все варианты дают
+// одинаковые токены. Подпись RS256 на порядки медленнее HMAC, поэтому для
+// неё число итераций не больше минимального.
+
+#include "bench_util.h"
+#include "bench_corpus.h"
+#include "jws_signer.h"
+
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Crypto/RSAKey.h>
+#include <Poco/Crypto/RSADigestEngine.h>
+#include <Poco/Base64Encoder.h>
+#include <Poco/HMACEngine.h>
+#include <Poco/SHA2Engine.h>
+#include <Poco/Exception.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+using namespace Poco::JSON;
+
+namespace {
+
+std::string base64Url(const std::string& data) {
+    std::ostringstream ss;
+    Poco::Base64Encoder encoder(ss, Poco::BASE64_URL_ENCODING | Poco::BASE64_NO_PADDING);
+    encoder.rdbuf()->setLineLength(0);
+    encoder.write(data.data(), static_cast<std::streamsize>(data.size()));
+    encoder.close();
+    return ss.str();
+}
+
+// Токен без переиспользования чего-либо между сообщениями
+std::string signNaive(const pocotest::JwsKey& key, const Object::Ptr& payload) {
+    std::ostringstream json;
+    Stringifier::condense(payload, json);
+    std::string token = base64Url(std::string("{\"alg\":\"") + key.name() + "\"}") + "." + base64Url(json.str());
+
+    Poco::DigestEngine::Digest signature;
+    if (key.algorithm() == pocotest::JwsKey::HS256) {
+        Poco::HMACEngine<Poco::SHA2Engine256> hmac(key.secret());
+        hmac.update(token);
+        signature = hmac.digest();
+    } else {
+        Poco::Crypto::RSADigestEngine rsa(key.rsaKey(), "SHA256");
+        rsa.update(token);
+        signature = rsa.signature();
+    }
+    return token + "." + base64Url(std::string(signature.begin(), signature.end()));
+}
+
+void printSpeedup(double baseline, const bench::Result& r, std::size_t messages) {
+    std::cout << "    " << std::fixed << std::setprecision(0)
+              << static_cast<double>(messages) * r.docsPerSec() << " messages/s";
+    if (baseline > 0.0) {
+        std::cout << ", " << std::setprecision(2) << r.mbPerSec() / baseline << "x vs naive";
+    }
+    std::cout << '\n';
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+void runAlgorithm(const bench::Options& options, const pocotest::JwsKey& key, unsigned maxThreads,
+                  const std::vector<Object::Ptr>& messages, bench::Report& report) {
+    const std::string alg = key.name();
+    pocotest::JwsSigner signer(key);
+    std::vector<std::string> expected;
+    std::size_t bytes = 0;
+    for (const auto& message : messages) {
+        expected.push_back(signer.sign(*message));
+        bytes += signer.canonical().size();
+        if (signNaive(key, message) != expected.back()) {
+            throw Poco::LogicException("naive and reused signers differ", alg);
+        }
+    }
+
+    std::size_t iterations = options.iterationsFor(bytes);
+    if (key.algorithm() == pocotest::JwsKey::RS256) {
+        iterations = options.minIterations;
+    }
+
+    double baseline = 0.0;
+    const std::string naiveName = "jws_naive/" + alg;
+    if (options.selected(naiveName)) {
+        bench::Result r = bench::measure(naiveName, bytes, iterations, [&]() {
+            for (const auto& message : messages) {
+                std::string token = signNaive(key, message);
+                bench::doNotOptimize(token);
+            }
+        });
+        baseline = r.mbPerSec();
+        report.add(r);
+        printSpeedup(0.0, r, messages.size());
+    }
+
+    const std::string signName = "jws_sign/" + alg + "/1t";
+    if (options.selected(signName)) {
+        std::string token;
+        bench::Result r = bench::measure(signName, bytes, iterations, [&]() {
+            for (const auto& message : messages) {
+                signer.sign(*message, token);
+                bench::doNotOptimize(token);
+            }
+        });
+        report.add(r);
+        printSpeedup(baseline, r, messages.size());
+    }
+
+    const std::string verifyName = "jws_verify/" + alg + "/1t";
+    if (options.selected(verifyName)) {
+        bench::Result r = bench::measure(verifyName, bytes, iterations, [&]() {
+            for (std::size_t i = 0; i < messages.size(); ++i) {
+                if (!signer.verify(*messages[i], expected[i])) {
+                    throw Poco::LogicException("verification failed", verifyName);
+                }
+            }
+        });
+        report.add(r);
+        printSpeedup(baseline, r, messages.size());
+    }
+
+    for (unsigned threads : bench::threadCounts(maxThreads)) {
+        if (threads == 1) {
+            continue;
+        }
+        const std::string suffix = "/" + alg + "/" + std::to_string(threads) + "t";
+        pocotest::JwsBatchSigner batch(key, threads);
+        std::vector<std::string> tokens;
+        std::vector<char> results;
+
+        const std::string batchSignName = "jws_sign_batch" + suffix;
+        if (options.selected(batchSignName)) {
+            batch.sign(messages, tokens);
+            if (tokens != expected) {
+                throw Poco::LogicException("batch and single signers differ", batchSignName);
+            }
+            bench::Result r = bench::measure(batchSignName, bytes, iterations, [&]() {
+                batch.sign(messages, tokens);
+                bench::doNotOptimize(tokens);
+            });
+            report.add(r);
+            printSpeedup(baseline, r, messages.size());
+        }
+
+        const std::string batchVerifyName = "jws_verify_batch" + suffix;
+        if (options.selected(batchVerifyName)) {
+            bench::Result r = bench::measure(batchVerifyName, bytes, iterations, [&]() {
+                batch.verify(messages, expected, results);
+                bench::doNotOptimize(results);
+            });
+            if (std::count(results.begin(), results.end(), 0) != 0) {
+                throw Poco::LogicException("verification failed", batchVerifyName);
+            }
+            report.add(r);
+            printSpeedup(baseline, r, messages.size());
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    options.output = "bench_jws_output.txt";
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    int batchSize = 256;
+
+    std::vector<std::string> rest = bench::parseOptions(argc, argv, options);
+    for (std::size_t i = 0; i < rest.size();) {
+        if (rest[i] == "--threads" && i + 1 < rest.size()) {
+            maxThreads = static_cast<unsigned>(std::max(1, std::atoi(rest[i + 1].c_str())));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--batch" && i + 1 < rest.size()) {
+            batchSize = std::max(1, std::atoi(rest[i + 1].c_str()));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else {
+            ++i;
+        }
+    }
+    if (!rest.empty()) {
+        std::ostream& out = rest.front() == "--help" ? std::cout : std::cerr;
+        bench::printUsage(argv[0], out);
+        out << "  --threads N     maximum number of threads (default: nproc)\n"
+            << "  --batch N       messages per batch (default: 256)\n";
+        return rest.front() == "--help" ? 0 : 1;
+    }
+
+    try {
+        std::mt19937 rng(20250101u);
+        const Array::Ptr records = bench::makeLargeDocument(rng, batchSize);
+        std::vector<Object::Ptr> messages;
+        for (const auto& record : *records) {
+            messages.push_back(record.extract<Object::Ptr>());
+        }
+
+        std::cout << "Generating RSA-2048 key..." << std::endl;
+        const Poco::Crypto::RSAKey rsa(Poco::Crypto::RSAKey::KL_2048, Poco::Crypto::RSAKey::EXP_LARGE);
+
+        bench::Report report;
+        bench::Report::printHeader(std::cout);
+        runAlgorithm(options, pocotest::JwsKey::hmac("bench secret"), maxThreads, messages, report);
+        runAlgorithm(options, pocotest::JwsKey::rsa(rsa), maxThreads, messages, report);
+
+        if (!report.writeTSV(options.output)) {
+            std::cerr << "Failed to write " << options.output << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << options.output << std::endl;
+    } catch (const Poco::Exception& e) {
+        std::cerr << "Benchmark failed: " << e.displayText() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+// Разбор JSON Lines (NDJSON): построчный базовый вариант против
+// параллельного NdjsonReader.
+//
+// Генерирует на диск детерминированный файл записей, по одной на строку, и
+// разбирает его тремя способами:
+//   ndjson_getline/1t  - std::getline из std::ifstream + Parser::parse
+//                        каждой строки в одном потоке (базовый вариант);
+//   ndjson_parse/<N>t  - NdjsonReader::parseFile в N потоках, деревья всех
+//                        записей в порядке строк;
+//   ndjson_stats/<N>t  - NdjsonReader::statsFile, только статистика.
+// Для каждого случая печатается ускорение относительно базового варианта.
+
+#include "bench_util.h"
+#include "ndjson_reader.h"
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/File.h>
+#include <Poco/Exception.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace Poco::JSON;
+
+namespace {
+
+// Пишет записи до достижения bytes байт; возвращает число записей
+std::size_t generateFile(const std::string& path, std::size_t bytes) {
+    static const char* const levels[] = {"debug", "info", "warning", "error"};
+    static const char* const words[] = {
+        "request", "served", "cache", "miss", "timeout", "retry", "user", "session",
+        "caf\xC3\xA9", "\\\"quoted\\\"", "path\\/to", "\\u00e9t\\u00e9"
+    };
+    const std::size_t wordCount = sizeof(words) / sizeof(words[0]);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw Poco::CreateFileException(path);
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> word(0, wordCount - 1);
+    std::uniform_int_distribution<int> level(0, 3);
+    std::uniform_int_distribution<int> latency(1, 5000);
+    std::uniform_real_distribution<double> ratio(0.0, 1.0);
+
+    std::string line;
+    std::size_t written = 0;
+    std::size_t records = 0;
+    while (written < bytes) {
+        line = "{\"seq\": " + std::to_string(records)
+            + ", \"ts\": " + std::to_string(1700000000000LL + static_cast<long long>(records) * 17)
+            + ", \"level\": \"" + levels[level(rng)]
+            + "\", \"latency_ms\": " + std::to_string(latency(rng))
+            + ", \"ratio\": " + std::to_string(ratio(rng))
+            + ", \"message\": \"";
+        for (int i = 0; i < 6; ++i) {
+            if (i != 0) {
+                line += ' ';
+            }
+            line += words[word(rng)];
+        }
+        line += "\", \"labels\": [\"";
+        line += words[word(rng)];
+        line += "\", \"";
+        line += words[word(rng)];
+        line += "\"], \"ok\": ";
+        line += records % 11 == 0 ? "false" : "true";
+        line += "}\n";
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        written += line.size();
+        ++records;
+    }
+    if (!out.flush()) {
+        throw Poco::WriteFileException(path);
+    }
+    return records;
+}
+
+void printSpeedup(double baseline, const bench::Result& r, std::size_t records) {
+    std::cout << "    " << std::fixed << std::setprecision(0)
+              << records * r.docsPerSec() << " records/s";
+    if (baseline > 0.0) {
+        std::cout << ", speedup x" << std::setprecision(2) << r.mbPerSec() / baseline;
+    }
+    std::cout << '\n';
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    options.targetBytes = 0;
+    options.minIterations = 3;
+    options.output = "bench_ndjson_output.txt";
+    std::size_t sizeMb = 128;
+    std::string path = "bench_ndjson_input.jsonl";
+    bool keep = false;
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::string> rest = bench::parseOptions(argc, argv, options);
+    if (options.quick) {
+        sizeMb = 16;
+    }
+    for (std::size_t i = 0; i < rest.size();) {
+        if (rest[i] == "--size-mb" && i + 1 < rest.size()) {
+            sizeMb = static_cast<std::size_t>(std::max(1, std::atoi(rest[i + 1].c_str())));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--file" && i + 1 < rest.size()) {
+            path = rest[i + 1];
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--threads" && i + 1 < rest.size()) {
+            maxThreads = static_cast<unsigned>(std::max(1, std::atoi(rest[i + 1].c_str())));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--keep") {
+            keep = true;
+            rest.erase(rest.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+    if (!rest.empty()) {
+        std::ostream& out = rest.front() == "--help" ? std::cout : std::cerr;
+        out << "Usage: " << argv[0]
+            << " [--quick] [--size-mb N] [--file PATH] [--keep] [--threads N] [--output FILE] [--filter SUBSTR]\n"
+            << "  --quick         short run (16 MB file)\n"
+            << "  --size-mb N     size of the generated file (default: 128)\n"
+            << "  --file PATH     input .jsonl file; generated if missing (default: bench_ndjson_input.jsonl)\n"
+            << "  --keep          keep the generated file for the next run\n"
+            << "  --threads N     maximum number of threads (default: nproc)\n"
+            << "  --output FILE   machine-readable TSV report (default: bench_ndjson_output.txt)\n"
+            << "  --filter SUBSTR run only cases whose name contains SUBSTR\n";
+        return rest.front() == "--help" ? 0 : 1;
+    }
+
+    Poco::File file(path);
+    const bool generated = !file.exists();
+    try {
+        if (generated) {
+            std::cout << "Generating " << sizeMb << " MB into " << path << "..." << std::endl;
+            generateFile(path, sizeMb * 1024u * 1024u);
+        }
+        const std::size_t bytes = static_cast<std::size_t>(file.getSize());
+        const std::size_t records = pocotest::NdjsonReader(maxThreads).statsFile(path).records;
+        std::cout << path << ": " << bytes / (1024 * 1024) << " MB, " << records << " records" << std::endl;
+
+        // Каждая итерация - весь файл, так что число итераций задаёт
+        // --target-mb, но не меньше minIterations
+        const std::size_t iterations = options.iterationsFor(bytes);
+
+        bench::Report report;
+        bench::Report::printHeader(std::cout);
+
+        double baseline = 0.0;
+        const std::string baselineName = "ndjson_getline/1t";
+        if (options.selected(baselineName)) {
+            bench::Result r = bench::measure(baselineName, bytes, iterations, [&]() {
+                std::ifstream in(path, std::ios::binary);
+                Parser parser;
+                std::string line;
+                std::size_t parsed = 0;
+                while (std::getline(in, line)) {
+                    if (line.empty()) {
+                        continue;
+                    }
+                    parser.reset();
+                    Poco::Dynamic::Var result = parser.parse(line);
+                    bench::doNotOptimize(result);
+                    ++parsed;
+                }
+                bench::doNotOptimize(parsed);
+            });
+            baseline = r.mbPerSec();
+            report.add(r);
+            printSpeedup(0.0, r, records);
+        }
+
+        for (unsigned threads : bench::threadCounts(maxThreads)) {
+            const std::string suffix = "/" + std::to_string(threads) + "t";
+            const pocotest::NdjsonReader reader(threads);
+
+            const std::string parseName = "ndjson_parse" + suffix;
+            if (options.selected(parseName)) {
+                bench::Result r = bench::measure(parseName, bytes, iterations, [&]() {
+                    std::vector<Poco::Dynamic::Var> result = reader.parseFile(path);
+                    bench::doNotOptimize(result);
+                });
+                report.add(r);
+                printSpeedup(baseline, r, records);
+            }
+
+            const std::string statsName = "ndjson_stats" + suffix;
+            if (options.selected(statsName)) {
+                bench::Result r = bench::measure(statsName, bytes, iterations, [&]() {
+                    pocotest::NdjsonStats result = reader.statsFile(path);
+                    bench::doNotOptimize(result);
+                });
+                report.add(r);
+                printSpeedup(baseline, r, records);
+            }
+        }
+
+        if (generated && !keep) {
+            file.remove();
+        }
+        if (!report.writeTSV(options.output)) {
+            std::cerr << "Failed to write " << options.output << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << options.output << std::endl;
+    } catch (const Poco::Exception& e) {
+        std::cerr << "Benchmark failed: " << e.displayText() << std::endl;
+        if (generated && !keep) {
+            std::remove(path.c_str());
+        }
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        if (generated && !keep) {
+            std::remove(path.c_str());
+        }
+        return 1;
+    }
+    return 0;
+}
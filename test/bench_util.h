@@ -0,0 +1,226 @@
+#ifndef POCO_TEST_APP_BENCH_UTIL_H
+#define POCO_TEST_APP_BENCH_UTIL_H
+
+// Общие утилиты бенчмарков: замер времени, перцентили, число выделений
+// памяти, пиковый RSS, ряд чисел потоков и отчёт в TSV. Цели бенчмарков
+// собираются с alloc_counter.cpp.
+
+#include "alloc_counter.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Не даём компилятору выбросить результат замеряемого кода
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Результат одного случая бенчмарка
+struct Result {
+    std::string name;            // "<операция>/<документ>"
+    std::size_t bytes = 0;       // байт JSON на одну итерацию
+    std::size_t iterations = 0;
+    double totalSeconds = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double allocsPerDoc = 0.0;   // выделений памяти на итерацию
+
+    double mbPerSec() const {
+        return totalSeconds > 0.0
+            ? static_cast<double>(bytes) * iterations / (1024.0 * 1024.0) / totalSeconds
+            : 0.0;
+    }
+
+    double docsPerSec() const {
+        return totalSeconds > 0.0 ? iterations / totalSeconds : 0.0;
+    }
+};
+
+// Перцентиль p (0..100) по методу ближайшего ранга
+inline double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::size_t rank = static_cast<std::size_t>(p / 100.0 * (samples.size() - 1) + 0.5);
+    rank = std::min(rank, samples.size() - 1);
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+}
+
+// Прогоняет fn() iterations раз (плюс одна итерация прогрева) и собирает
+// латентность каждой итерации
+template <typename Fn>
+Result measure(const std::string& name, std::size_t bytes, std::size_t iterations, Fn&& fn) {
+    fn();
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+
+    const pocotest::AllocationScope allocations;
+    const Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const Clock::time_point t0 = Clock::now();
+        fn();
+        const Clock::time_point t1 = Clock::now();
+        samples.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    const Clock::time_point stop = Clock::now();
+    // Единственное выделение вне fn() - рост samples - исключено reserve()
+    const std::size_t allocationCount = allocations.delta().allocations;
+
+    Result result;
+    result.name = name;
+    result.bytes = bytes;
+    result.iterations = iterations;
+    result.totalSeconds = std::chrono::duration<double>(stop - start).count();
+    result.p50Us = percentile(samples, 50.0);
+    result.p99Us = percentile(samples, 99.0);
+    result.allocsPerDoc = iterations > 0 ? static_cast<double>(allocationCount) / iterations : 0.0;
+    return result;
+}
+
+// Настройки запуска, общие для всех бенчмарков
+struct Options {
+    std::size_t targetBytes = 64u * 1024u * 1024u;  // объём JSON на один случай
+    std::size_t minIterations = 10;
+    std::size_t maxIterations = 100000;
+    std::string output = "bench_output.txt";
+    std::string filter;
+    bool quick = false;  // --quick: бенчмарки с собственными размерами входа уменьшают их сами
+
+    std::size_t iterationsFor(std::size_t bytes) const {
+        std::size_t n = bytes > 0 ? targetBytes / bytes : maxIterations;
+        return std::max(minIterations, std::min(maxIterations, n));
+    }
+
+    bool selected(const std::string& name) const {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    }
+};
+
+// Разбирает общие аргументы командной строки; неизвестные аргументы
+// возвращаются вызывающему
+inline std::vector<std::string> parseOptions(int argc, char** argv, Options& options) {
+    std::vector<std::string> rest;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            options.quick = true;
+            options.targetBytes = 8u * 1024u * 1024u;
+            options.minIterations = 3;
+        } else if (arg == "--target-mb" && i + 1 < argc) {
+            options.targetBytes = static_cast<std::size_t>(std::atof(argv[++i]) * 1024.0 * 1024.0);
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.output = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else {
+            rest.push_back(arg);
+        }
+    }
+    return rest;
+}
+
+inline void printUsage(const char* program, std::ostream& out) {
+    out << "Usage: " << program << " [--quick] [--target-mb N] [--output FILE] [--filter SUBSTR]\n"
+        << "  --quick         short run (8 MB of JSON per case)\n"
+        << "  --target-mb N   amount of JSON processed per case (default: 64)\n"
+        << "  --output FILE   machine-readable TSV report (default: bench_output.txt)\n"
+        << "  --filter SUBSTR run only cases whose name contains SUBSTR\n";
+}
+
+// Пиковый RSS процесса в мегабайтах (ru_maxrss в Linux - в килобайтах)
+inline double peakRssMb() {
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+// 1, 2, 4, ... и обязательно maxThreads
+template <typename T>
+std::vector<T> threadCounts(T maxThreads) {
+    std::vector<T> counts;
+    for (T n = 1; n < maxThreads; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+// Набор результатов: таблица для человека и TSV для скриптов
+class Report {
+public:
+    void add(Result result) {
+        printRow(std::cout, result);
+        results_.push_back(std::move(result));
+    }
+
+    const std::vector<Result>& results() const {
+        return results_;
+    }
+
+    static void printHeader(std::ostream& out) {
+        out << std::left << std::setw(36) << "case"
+            << std::right << std::setw(12) << "bytes"
+            << std::setw(10) << "iters"
+            << std::setw(12) << "MB/s"
+            << std::setw(14) << "docs/s"
+            << std::setw(12) << "p50 us"
+            << std::setw(12) << "p99 us"
+            << std::setw(14) << "allocs/doc" << '\n';
+    }
+
+    static void printRow(std::ostream& out, const Result& r) {
+        out << std::left << std::setw(36) << r.name
+            << std::right << std::setw(12) << r.bytes
+            << std::setw(10) << r.iterations
+            << std::fixed << std::setprecision(2)
+            << std::setw(12) << r.mbPerSec()
+            << std::setw(14) << r.docsPerSec()
+            << std::setw(12) << r.p50Us
+            << std::setw(12) << r.p99Us
+            << std::setw(14) << r.allocsPerDoc << '\n';
+        out.unsetf(std::ios::floatfield);
+    }
+
+    void writeTSV(std::ostream& out) const {
+        out << "name\tbytes\titerations\tmb_per_s\tdocs_per_s\tp50_us\tp99_us\tallocs_per_doc\n";
+        out << std::fixed << std::setprecision(3);
+        for (const auto& r : results_) {
+            out << r.name << '\t' << r.bytes << '\t' << r.iterations << '\t'
+                << r.mbPerSec() << '\t' << r.docsPerSec() << '\t'
+                << r.p50Us << '\t' << r.p99Us << '\t' << r.allocsPerDoc << '\n';
+        }
+    }
+
+    bool writeTSV(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+        writeTSV(out);
+        return static_cast<bool>(out);
+    }
+
+private:
+    std::vector<Result> results_;
+};
+
+} // namespace bench
+
+#endif // POCO_TEST_APP_BENCH_UTIL_H
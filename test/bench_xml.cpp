@@ -0,0 +1,228 @@
+// Преобразование XML в JSON (JsonML): DOM Poco против потокового
+// XmlToJson поверх SAX.
+//
+//   xml_dom/<doc>        - DOMParser::parseString, domToJsonML и
+//                          Stringifier::condense (эталонный путь);
+//   xml_sax/<doc>        - XmlToJson::convert из памяти в переиспользуемую
+//                          строку;
+//   xml_sax_file/<N>mb   - XmlToJson::convertFile сгенерированного на диск
+//                          фида в поток, который только считает байты.
+// Файловый случай идёт первым: печатаемый после него пиковый RSS процесса
+// не должен зависеть от размера файла. Перед замерами проверяется, что оба
+// пути из памяти дают одинаковый JSON.
+
+#include "bench_corpus.h"
+#include "bench_util.h"
+#include "xml_to_json.h"
+
+#include <Poco/DOM/DOMParser.h>
+#include <Poco/DOM/Document.h>
+#include <Poco/SAX/XMLReader.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/AutoPtr.h>
+#include <Poco/CountingStream.h>
+#include <Poco/NullStream.h>
+#include <Poco/File.h>
+#include <Poco/Exception.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Пишет фид до достижения bytes байт, не держа его в памяти; возвращает
+// размер файла
+std::size_t generateFile(const std::string& path, std::size_t bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw Poco::CreateFileException(path);
+    }
+
+    std::mt19937 rng(11);
+    std::string chunk = bench::xmlFeedHeader();
+    std::size_t written = 0;
+    for (std::size_t id = 0; written < bytes; ++id) {
+        bench::appendXmlFeedItem(rng, id, chunk);
+        if (chunk.size() >= 64 * 1024) {
+            out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            written += chunk.size();
+            chunk.clear();
+        }
+    }
+    chunk += bench::xmlFeedFooter();
+    out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    written += chunk.size();
+    if (!out.flush()) {
+        throw Poco::WriteFileException(path);
+    }
+    return written;
+}
+
+std::string convertWithDom(Poco::XML::DOMParser& parser, const std::string& xml) {
+    const Poco::AutoPtr<Poco::XML::Document> document = parser.parseString(xml);
+    std::ostringstream ss;
+    Poco::JSON::Stringifier::condense(pocotest::domToJsonML(*document->documentElement()), ss);
+    return ss.str();
+}
+
+void runFile(const bench::Options& options, const std::string& path, std::size_t bytes, bench::Report& report) {
+    const std::string name = "xml_sax_file/" + std::to_string(bytes / (1024 * 1024)) + "mb";
+    if (!options.selected(name)) {
+        return;
+    }
+    pocotest::XmlToJson converter;
+    Poco::NullOutputStream sink;
+    Poco::CountingOutputStream out(sink);
+
+    // Файл больше любого кэша, так что один проход без прогрева
+    const pocotest::AllocationScope allocations;
+    const bench::Clock::time_point start = bench::Clock::now();
+    converter.convertFile(path, out);
+    const bench::Clock::time_point stop = bench::Clock::now();
+
+    bench::Result r;
+    r.name = name;
+    r.bytes = bytes;
+    r.iterations = 1;
+    r.totalSeconds = std::chrono::duration<double>(stop - start).count();
+    r.p50Us = r.totalSeconds * 1e6;
+    r.p99Us = r.p50Us;
+    r.allocsPerDoc = static_cast<double>(allocations.delta().allocations);
+    report.add(r);
+    std::cout << "    " << converter.elements() << " elements, "
+              << static_cast<std::size_t>(out.chars()) / (1024 * 1024) << " MB of JSON, peak RSS "
+              << std::fixed << std::setprecision(1) << bench::peakRssMb() << " MB\n";
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+void runMemory(const bench::Options& options, bench::Report& report) {
+    std::mt19937 rng(20250101u);
+    const std::vector<std::pair<std::string, std::string>> documents = {
+        {"feed_100", bench::makeXmlFeed(rng, 100)},
+        {"feed_20000", bench::makeXmlFeed(rng, 20000)},
+    };
+
+    Poco::XML::DOMParser parser;
+    parser.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACES, false);
+    pocotest::XmlToJson converter;
+    std::string json;
+
+    for (const auto& [doc, xml] : documents) {
+        converter.convert(xml, json);
+        if (json != convertWithDom(parser, xml)) {
+            throw Poco::LogicException("DOM and SAX conversions differ", doc);
+        }
+        const std::size_t iterations = options.iterationsFor(xml.size());
+
+        const std::string domName = "xml_dom/" + doc;
+        if (options.selected(domName)) {
+            report.add(bench::measure(domName, xml.size(), iterations, [&]() {
+                std::string out = convertWithDom(parser, xml);
+                bench::doNotOptimize(out);
+            }));
+        }
+        const std::string saxName = "xml_sax/" + doc;
+        if (options.selected(saxName)) {
+            report.add(bench::measure(saxName, xml.size(), iterations, [&]() {
+                converter.convert(xml, json);
+                bench::doNotOptimize(json);
+            }));
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    options.output = "bench_xml_output.txt";
+    std::size_t sizeMb = 1024;
+    std::string path = "bench_xml_input.xml";
+    bool keep = false;
+
+    std::vector<std::string> rest = bench::parseOptions(argc, argv, options);
+    if (options.quick) {
+        sizeMb = 128;
+    }
+    for (std::size_t i = 0; i < rest.size();) {
+        if (rest[i] == "--size-mb" && i + 1 < rest.size()) {
+            sizeMb = static_cast<std::size_t>(std::max(1, std::atoi(rest[i + 1].c_str())));
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--file" && i + 1 < rest.size()) {
+            path = rest[i + 1];
+            rest.erase(rest.begin() + i, rest.begin() + i + 2);
+        } else if (rest[i] == "--keep") {
+            keep = true;
+            rest.erase(rest.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+    if (!rest.empty()) {
+        std::ostream& out = rest.front() == "--help" ? std::cout : std::cerr;
+        out << "Usage: " << argv[0] << " [--quick] [--size-mb N] [--file PATH] [--keep] [--output FILE] [--filter SUBSTR]\n"
+            << "  --quick         short run (128 MB file)\n"
+            << "  --size-mb N     size of the generated file (default: 1024)\n"
+            << "  --file PATH     input XML file; generated if missing (default: bench_xml_input.xml)\n"
+            << "  --keep          keep the generated file for the next run\n"
+            << "  --output FILE   machine-readable TSV report (default: bench_xml_output.txt)\n"
+            << "  --filter SUBSTR run only cases whose name contains SUBSTR\n";
+        return rest.front() == "--help" ? 0 : 1;
+    }
+
+    // Имя файлового случая зависит от размера файла, который ещё неизвестен
+    const std::string filePrefix = "xml_sax_file/";
+    const bool fileSelected = options.filter.empty() || filePrefix.find(options.filter) != std::string::npos
+        || options.filter.compare(0, filePrefix.size(), filePrefix) == 0;
+    Poco::File file(path);
+    const bool generated = fileSelected && !file.exists();
+    try {
+        bench::Report report;
+        if (fileSelected) {
+            std::size_t bytes = 0;
+            if (generated) {
+                std::cout << "Generating " << sizeMb << " MB into " << path << "..." << std::endl;
+                bytes = generateFile(path, sizeMb * 1024u * 1024u);
+            } else {
+                bytes = static_cast<std::size_t>(file.getSize());
+                std::cout << "Using existing " << path << " (" << bytes / (1024 * 1024) << " MB)" << std::endl;
+            }
+            std::cout << "Peak RSS before conversion: " << std::fixed << std::setprecision(1) << bench::peakRssMb()
+                      << " MB" << std::endl;
+            std::cout.unsetf(std::ios::floatfield);
+            bench::Report::printHeader(std::cout);
+            runFile(options, path, bytes, report);
+            if (generated && !keep) {
+                file.remove();
+            }
+        } else {
+            bench::Report::printHeader(std::cout);
+        }
+        runMemory(options, report);
+
+        if (!report.writeTSV(options.output)) {
+            std::cerr << "Failed to write " << options.output << std::endl;
+            return 1;
+        }
+        std::cout << "Results written to " << options.output << std::endl;
+    } catch (const Poco::Exception& e) {
+        std::cerr << "Benchmark failed: " << e.displayText() << std::endl;
+        if (generated && !keep) {
+            std::remove(path.c_str());
+        }
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        if (generated && !keep) {
+            std::remove(path.c_str());
+        }
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,281 @@
+#ifndef POCO_TEST_APP_FLAT_OBJECT_H
+#define POCO_TEST_APP_FLAT_OBJECT_H
+
+// Объект JSON с быстрым поиском по ключу для широких объектов.
+//
+// Poco::JSON::Object хранит значения в std::map: каждый get/has/getValue -
+// это O(log n) сравнений строк и копия Dynamic::Var, а порядок вставки
+// (JSON_PRESERVE_KEY_ORDER) держится отдельным списком ключей. FlatObject
+// хранит пары ключ-значение в одном векторе в порядке вставки и рядом -
+// хеши ключей, посчитанные один раз при вставке. Индекс для поиска:
+//   - до smallLimit ключей - отсортированный по хешу вектор (бинарный поиск
+//     сравнивает только целые числа, строка - один раз на совпадение);
+//   - больше - хеш-таблица с открытой адресацией (линейное пробирование),
+//     в ячейках номера пар; при росте таблица перестраивается по сохранённым
+//     хешам, без повторного хеширования строк.
+//
+// Обход всегда идёт в порядке вставки, как обещает JSON_PRESERVE_KEY_ORDER;
+// set() существующего ключа меняет значение на прежнем месте. remove()
+// перестраивает индекс за O(n) - в наших сценариях удаление редкое.
+// find() возвращает указатель на хранимое значение без копии Var.
+
+#include "json_number.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/SharedPtr.h>
+#include <Poco/JSONString.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace pocotest {
+
+class FlatObject {
+public:
+    using Ptr = Poco::SharedPtr<FlatObject>;
+
+    // Поля названы как у std::map::value_type, чтобы обход выглядел так же,
+    // как обход Object
+    struct Member {
+        std::string first;
+        Poco::Dynamic::Var second;
+    };
+
+    using ConstIterator = std::vector<Member>::const_iterator;
+
+    static constexpr std::size_t DEFAULT_SMALL_LIMIT = 16;
+
+    // smallLimit - сколько ключей держать в отсортированном векторе;
+    // 0 - сразу хеш-таблица
+    explicit FlatObject(std::size_t smallLimit = DEFAULT_SMALL_LIMIT)
+        : smallLimit_(smallLimit) {
+    }
+
+    // Копия Object в порядке getNames(), то есть в порядке вставки, если
+    // объект создан с JSON_PRESERVE_KEY_ORDER
+    static Ptr fromObject(const Poco::JSON::Object& object, std::size_t smallLimit = DEFAULT_SMALL_LIMIT) {
+        Ptr result = new FlatObject(smallLimit);
+        const std::vector<std::string> names = object.getNames();
+        result->reserve(names.size());
+        for (const auto& name : names) {
+            result->set(name, object.get(name));
+        }
+        return result;
+    }
+
+    // Object с JSON_PRESERVE_KEY_ORDER и тем же порядком ключей
+    Poco::JSON::Object::Ptr toObject() const {
+        Poco::JSON::Object::Ptr result = new Poco::JSON::Object(Poco::JSON_PRESERVE_KEY_ORDER);
+        for (const Member& member : members_) {
+            result->set(member.first, member.second);
+        }
+        return result;
+    }
+
+    void reserve(std::size_t count) {
+        members_.reserve(count);
+        hashes_.reserve(count);
+        count = std::max(count, members_.size());
+        if (count > smallLimit_ && tableSizeFor(count) > slots_.size()) {
+            rehash(tableSizeFor(count));
+        }
+    }
+
+    std::size_t size() const {
+        return members_.size();
+    }
+
+    // true, если индекс - хеш-таблица, а не отсортированный вектор
+    bool isHashed() const {
+        return !slots_.empty();
+    }
+
+    // Новый ключ добавляется в конец, существующий сохраняет место
+    void set(const std::string& key, Poco::Dynamic::Var value) {
+        const std::size_t hash = hashKey(key);
+        const std::size_t index = lookup(key, hash);
+        if (index != NPOS) {
+            members_[index].second = std::move(value);
+            return;
+        }
+        members_.push_back(Member{key, std::move(value)});
+        hashes_.push_back(hash);
+        insertIndex(members_.size() - 1);
+    }
+
+    bool has(std::string_view key) const {
+        return lookup(key, hashKey(key)) != NPOS;
+    }
+
+    // Хранимое значение или nullptr; указатель действителен до следующего
+    // set() нового ключа или remove()
+    const Poco::Dynamic::Var* find(std::string_view key) const {
+        const std::size_t index = lookup(key, hashKey(key));
+        return index == NPOS ? nullptr : &members_[index].second;
+    }
+
+    Poco::Dynamic::Var* find(std::string_view key) {
+        const std::size_t index = lookup(key, hashKey(key));
+        return index == NPOS ? nullptr : &members_[index].second;
+    }
+
+    // Как Object::get: пустое значение, если ключа нет
+    Poco::Dynamic::Var get(std::string_view key) const {
+        const Poco::Dynamic::Var* value = find(key);
+        return value != nullptr ? *value : Poco::Dynamic::Var();
+    }
+
+    // Как Object::getValue: исключение Var::convert, если ключа нет или
+    // значение не приводится к T
+    template <typename T>
+    T getValue(std::string_view key) const {
+        if (const Poco::Dynamic::Var* value = find(key)) {
+            return number::convertValue<T>(*value);
+        }
+        return Poco::Dynamic::Var().convert<T>();
+    }
+
+    // Как Object::isNull: true, если ключа нет или значение пустое
+    bool isNull(std::string_view key) const {
+        const Poco::Dynamic::Var* value = find(key);
+        return value == nullptr || value->isEmpty();
+    }
+
+    void remove(std::string_view key) {
+        const std::size_t index = lookup(key, hashKey(key));
+        if (index == NPOS) {
+            return;
+        }
+        members_.erase(members_.begin() + static_cast<std::ptrdiff_t>(index));
+        hashes_.erase(hashes_.begin() + static_cast<std::ptrdiff_t>(index));
+        rebuildIndex();
+    }
+
+    void clear() {
+        members_.clear();
+        hashes_.clear();
+        sorted_.clear();
+        slots_.clear();
+    }
+
+    std::vector<std::string> getNames() const {
+        std::vector<std::string> names;
+        names.reserve(members_.size());
+        for (const Member& member : members_) {
+            names.push_back(member.first);
+        }
+        return names;
+    }
+
+    ConstIterator begin() const {
+        return members_.begin();
+    }
+
+    ConstIterator end() const {
+        return members_.end();
+    }
+
+private:
+    static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+    static constexpr std::uint32_t EMPTY = static_cast<std::uint32_t>(-1);
+
+    static std::size_t hashKey(std::string_view key) {
+        return std::hash<std::string_view>()(key);
+    }
+
+    // Степень двойки, при которой таблица заполнена не больше чем наполовину
+    static std::size_t tableSizeFor(std::size_t count) {
+        std::size_t size = 16;
+        while (size < count * 2) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    std::size_t lookup(std::string_view key, std::size_t hash) const {
+        if (!slots_.empty()) {
+            const std::size_t mask = slots_.size() - 1;
+            for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+                const std::uint32_t index = slots_[slot];
+                if (index == EMPTY) {
+                    return NPOS;
+                }
+                if (hashes_[index] == hash && members_[index].first == key) {
+                    return index;
+                }
+            }
+        }
+        auto it = std::lower_bound(sorted_.begin(), sorted_.end(), hash,
+                                   [this](std::uint32_t index, std::size_t h) { return hashes_[index] < h; });
+        for (; it != sorted_.end() && hashes_[*it] == hash; ++it) {
+            if (members_[*it].first == key) {
+                return *it;
+            }
+        }
+        return NPOS;
+    }
+
+    // Добавляет в индекс только что вставленную пару
+    void insertIndex(std::size_t index) {
+        if (slots_.empty() && members_.size() <= smallLimit_) {
+            const std::size_t hash = hashes_[index];
+            auto it = std::upper_bound(sorted_.begin(), sorted_.end(), hash,
+                                       [this](std::size_t h, std::uint32_t i) { return h < hashes_[i]; });
+            sorted_.insert(it, static_cast<std::uint32_t>(index));
+            return;
+        }
+        if (slots_.empty() || members_.size() * 2 > slots_.size()) {
+            rehash(tableSizeFor(members_.size()));
+            return;
+        }
+        placeSlot(index);
+    }
+
+    void placeSlot(std::size_t index) {
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t slot = hashes_[index] & mask;
+        while (slots_[slot] != EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = static_cast<std::uint32_t>(index);
+    }
+
+    void rehash(std::size_t tableSize) {
+        sorted_.clear();
+        slots_.assign(tableSize, EMPTY);
+        for (std::size_t index = 0; index < members_.size(); ++index) {
+            placeSlot(index);
+        }
+    }
+
+    void rebuildIndex() {
+        sorted_.clear();
+        slots_.clear();
+        if (members_.size() > smallLimit_) {
+            rehash(tableSizeFor(members_.size()));
+            return;
+        }
+        for (std::size_t index = 0; index < members_.size(); ++index) {
+            sorted_.push_back(static_cast<std::uint32_t>(index));
+        }
+        std::stable_sort(sorted_.begin(), sorted_.end(),
+                         [this](std::uint32_t a, std::uint32_t b) { return hashes_[a] < hashes_[b]; });
+    }
+
+    std::size_t smallLimit_;
+    std::vector<Member> members_;          // в порядке вставки
+    std::vector<std::size_t> hashes_;      // hashes_[i] - хеш members_[i].first
+    std::vector<std::uint32_t> sorted_;    // малый режим: номера пар по возрастанию хеша
+    std::vector<std::uint32_t> slots_;     // хеш-таблица: номер пары или EMPTY
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_FLAT_OBJECT_H
@@ -0,0 +1,611 @@
+#ifndef POCO_TEST_APP_JSON_BINDING_H
+#define POCO_TEST_APP_JSON_BINDING_H
+
+// Привязка JSON к структурам C++ по схеме, заданной на этапе компиляции.
+//
+// Обычный путь - Parser::parse в дерево Object/Dynamic::Var и копирование
+// полей через getValue<T>() - платит за построение дерева и затем за
+// преобразования Var. Здесь поля структуры объявляются один раз
+// специализацией Schema:
+//
+//   template <> struct Schema<Record> {
+//       static constexpr auto fields = std::make_tuple(
+//           field("id", &Record::id), field("name", &Record::name));
+//   };
+//
+// и по ней шаблоны порождают обработчик событий (BindingHandler - обычный
+// Poco::JSON::Handler для Parser или JsonReader), который пишет значения
+// прямо в поля, и сериализатор, который пишет структуру в строку без
+// Object. Поиск поля по ключу - развёрнутая цепочка сравнений с именами
+// из схемы, переход к полю - таблица функций по его номеру.
+//
+// Типы полей: bool, целые (с проверкой диапазона), double (принимает и
+// целые JSON), std::string, std::optional<T> (null - пустое значение),
+// std::vector<T> и структуры со своей Schema. Неизвестные ключи
+// пропускаются вместе с вложенными значениями. Поля, которых нет в
+// документе, получают значения из T{}, так что разбор в уже заполненную
+// структуру даёт тот же результат, что в новую, но сохраняет ёмкость строк
+// и векторов. Несовпадение типа - JSONException с именем поля; при
+// повторяющихся ключах, как и в Parser, побеждает последний.
+//
+// Сериализатор пишет поля в порядке схемы, пустой optional - как null,
+// строки и double - как JsonWriter, так что при схеме с ключами по
+// алфавиту вывод совпадает с Stringifier::condense дерева с теми же
+// значениями.
+
+#include "json_number.h"
+#include "json_reader.h"
+#include "json_writer.h"
+
+#include <Poco/JSON/Handler.h>
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/SharedPtr.h>
+#include <Poco/Exception.h>
+#include <Poco/Types.h>
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pocotest {
+namespace binding {
+
+// Поле структуры T типа M с именем ключа JSON
+template <typename T, typename M>
+struct Field {
+    std::string_view name;
+    M T::*member;
+};
+
+template <typename T, typename M>
+constexpr Field<T, M> field(std::string_view name, M T::*member) {
+    return Field<T, M>{name, member};
+}
+
+// Специализация объявляет static constexpr auto fields - кортеж field(...)
+template <typename T>
+struct Schema;
+
+template <typename T, typename = void>
+struct IsBound : std::false_type {};
+
+template <typename T>
+struct IsBound<T, std::void_t<decltype(Schema<T>::fields)>> : std::true_type {};
+
+template <typename T>
+struct IsOptional : std::false_type {};
+
+template <typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+struct IsVector : std::false_type {};
+
+template <typename T, typename A>
+struct IsVector<std::vector<T, A>> : std::true_type {};
+
+template <typename T>
+constexpr std::size_t fieldCount() {
+    return std::tuple_size_v<std::decay_t<decltype(Schema<T>::fields)>>;
+}
+
+namespace detail {
+
+// Событие разбора со значением
+struct Event {
+    enum Kind {
+        Null,
+        Bool,
+        Int,
+        UInt,
+        Double,
+        String,
+        StartObject,
+        StartArray
+    };
+
+    Kind kind = Null;
+    bool boolean = false;
+    Poco::Int64 integer = 0;
+    Poco::UInt64 unsignedInteger = 0;
+    double real = 0.0;
+    const std::string* string = nullptr;
+};
+
+inline const char* kindName(Event::Kind kind) {
+    switch (kind) {
+        case Event::Null: return "null";
+        case Event::Bool: return "boolean";
+        case Event::Int:
+        case Event::UInt: return "integer";
+        case Event::Double: return "number";
+        case Event::String: return "string";
+        case Event::StartObject: return "object";
+        case Event::StartArray: return "array";
+    }
+    return "unknown";
+}
+
+[[noreturn]] inline void mismatch(const char* expected, const Event& event) {
+    throw Poco::JSON::JSONException(std::string("expected ") + expected + ", got " + kindName(event.kind));
+}
+
+// Открытый объект или массив. У объекта find() ищет поле по ключу, а
+// field - номер поля для следующего значения (-1 - пропустить)
+struct Frame {
+    void* target = nullptr;
+    Frame (*apply)(void* target, int field, const Event& event) = nullptr;
+    int (*find)(std::string_view key) = nullptr;
+    void (*finish)(void* target, std::uint64_t seen) = nullptr;
+    std::string_view (*name)(int field) = nullptr;
+    int field = -1;
+    std::uint64_t seen = 0;
+};
+
+template <typename T>
+Frame objectFrame(T& object);
+
+template <typename V>
+Frame arrayFrame(V& array);
+
+template <typename M>
+M toInteger(const Event& event) {
+    using Limits = std::numeric_limits<M>;
+    if (event.kind == Event::Int) {
+        bool inRange;
+        if constexpr (std::is_signed_v<M>) {
+            inRange = event.integer >= static_cast<Poco::Int64>(Limits::min())
+                && event.integer <= static_cast<Poco::Int64>(Limits::max());
+        } else {
+            inRange = event.integer >= 0 && static_cast<Poco::UInt64>(event.integer) <= Limits::max();
+        }
+        if (!inRange) {
+            throw Poco::JSON::JSONException("integer " + std::to_string(event.integer) + " out of range");
+        }
+        return static_cast<M>(event.integer);
+    }
+    if (event.kind == Event::UInt) {
+        if (event.unsignedInteger > static_cast<Poco::UInt64>(Limits::max())) {
+            throw Poco::JSON::JSONException("integer " + std::to_string(event.unsignedInteger) + " out of range");
+        }
+        return static_cast<M>(event.unsignedInteger);
+    }
+    mismatch("integer", event);
+}
+
+// Применяет событие к значению типа M; для начала объекта или массива
+// возвращает кадр вложенного контейнера, иначе - пустой кадр
+template <typename M>
+Frame applyTo(M& slot, const Event& event) {
+    if constexpr (std::is_same_v<M, bool>) {
+        if (event.kind != Event::Bool) {
+            mismatch("boolean", event);
+        }
+        slot = event.boolean;
+    } else if constexpr (std::is_integral_v<M>) {
+        slot = toInteger<M>(event);
+    } else if constexpr (std::is_same_v<M, double>) {
+        if (event.kind == Event::Double) {
+            slot = event.real;
+        } else if (event.kind == Event::Int) {
+            slot = static_cast<double>(event.integer);
+        } else if (event.kind == Event::UInt) {
+            slot = static_cast<double>(event.unsignedInteger);
+        } else {
+            mismatch("number", event);
+        }
+    } else if constexpr (std::is_same_v<M, std::string>) {
+        if (event.kind != Event::String) {
+            mismatch("string", event);
+        }
+        slot.assign(*event.string);
+    } else if constexpr (IsOptional<M>::value) {
+        if (event.kind == Event::Null) {
+            slot.reset();
+            return Frame();
+        }
+        if (!slot) {
+            slot.emplace();
+        }
+        return applyTo(*slot, event);
+    } else if constexpr (IsVector<M>::value) {
+        static_assert(!std::is_same_v<typename M::value_type, bool>, "std::vector<bool> is not supported");
+        if (event.kind != Event::StartArray) {
+            mismatch("array", event);
+        }
+        slot.clear();
+        return arrayFrame(slot);
+    } else {
+        static_assert(IsBound<M>::value, "field type has no Schema specialization");
+        if (event.kind != Event::StartObject) {
+            mismatch("object", event);
+        }
+        return objectFrame(slot);
+    }
+    return Frame();
+}
+
+template <typename T>
+const T& defaults() {
+    static const T value{};
+    return value;
+}
+
+template <typename T, std::size_t I>
+Frame applyMember(T& object, const Event& event) {
+    return applyTo(object.*(std::get<I>(Schema<T>::fields).member), event);
+}
+
+template <typename T, std::size_t... I>
+Frame applyField(T& object, int field, const Event& event, std::index_sequence<I...>) {
+    using Apply = Frame (*)(T&, const Event&);
+    static constexpr Apply table[] = {&applyMember<T, I>...};
+    return table[field](object, event);
+}
+
+template <typename T, std::size_t... I>
+int findField([[maybe_unused]] std::string_view key, std::index_sequence<I...>) {
+    int found = -1;
+    static_cast<void>(((std::get<I>(Schema<T>::fields).name == key ? (found = static_cast<int>(I), true) : false)
+                       || ...));
+    return found;
+}
+
+template <typename T, std::size_t... I>
+std::string_view fieldName(int field, std::index_sequence<I...>) {
+    static constexpr std::string_view names[] = {std::get<I>(Schema<T>::fields).name...};
+    return names[field];
+}
+
+template <typename T, std::size_t I>
+void resetIfMissing(T& object, std::uint64_t seen) {
+    if ((seen & (std::uint64_t(1) << I)) == 0) {
+        constexpr auto member = std::get<I>(Schema<T>::fields).member;
+        object.*member = defaults<T>().*member;
+    }
+}
+
+// Поля, которых не было в объекте, получают значения из T{}
+template <typename T, std::size_t... I>
+void resetMissing([[maybe_unused]] T& object, [[maybe_unused]] std::uint64_t seen, std::index_sequence<I...>) {
+    (resetIfMissing<T, I>(object, seen), ...);
+}
+
+template <typename T>
+Frame objectFrame(T& object) {
+    constexpr std::size_t count = fieldCount<T>();
+    static_assert(count <= 64, "at most 64 fields per struct");
+    using Indices = std::make_index_sequence<count>;
+
+    Frame frame;
+    frame.target = &object;
+    frame.apply = [](void* target, int field, const Event& event) {
+        if constexpr (count == 0) {
+            static_cast<void>(target);
+            static_cast<void>(field);
+            static_cast<void>(event);
+            return Frame();
+        } else {
+            return applyField(*static_cast<T*>(target), field, event, Indices());
+        }
+    };
+    frame.find = [](std::string_view key) {
+        return findField<T>(key, Indices());
+    };
+    frame.finish = [](void* target, std::uint64_t seen) {
+        resetMissing(*static_cast<T*>(target), seen, Indices());
+    };
+    frame.name = [](int field) {
+        if constexpr (count == 0) {
+            static_cast<void>(field);
+            return std::string_view();
+        } else {
+            return fieldName<T>(field, Indices());
+        }
+    };
+    return frame;
+}
+
+template <typename V>
+Frame arrayFrame(V& array) {
+    Frame frame;
+    frame.target = &array;
+    frame.apply = [](void* target, int, const Event& event) {
+        V& elements = *static_cast<V*>(target);
+        elements.emplace_back();
+        return applyTo(elements.back(), event);
+    };
+    return frame;
+}
+
+// "name": с запятой перед всеми полями, кроме первого
+template <typename T, std::size_t I>
+std::string quotedKey() {
+    std::string key = I > 0 ? "," : "";
+    JsonWriter().writeString(std::get<I>(Schema<T>::fields).name, key);
+    key += ':';
+    return key;
+}
+
+template <typename M>
+void writeValue(const M& value, const JsonWriter& writer, std::string& out);
+
+template <typename T, std::size_t... I>
+void writeObject([[maybe_unused]] const T& object, [[maybe_unused]] const JsonWriter& writer, std::string& out,
+                 std::index_sequence<I...>) {
+    // Ключи экранируются один раз на тип
+    [[maybe_unused]] static const std::array<std::string, sizeof...(I)> keys = {quotedKey<T, I>()...};
+    out += '{';
+    (static_cast<void>(out += keys[I], writeValue(object.*(std::get<I>(Schema<T>::fields).member), writer, out)),
+     ...);
+    out += '}';
+}
+
+template <typename M>
+void writeValue(const M& value, const JsonWriter& writer, std::string& out) {
+    if constexpr (std::is_same_v<M, bool>) {
+        out += value ? "true" : "false";
+    } else if constexpr (std::is_integral_v<M>) {
+        char digits[24];
+        const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    } else if constexpr (std::is_same_v<M, double>) {
+        char buffer[number::MAX_DOUBLE_CHARS];
+        out.append(buffer, number::formatDouble(value, buffer));
+    } else if constexpr (std::is_same_v<M, std::string>) {
+        writer.writeString(value, out);
+    } else if constexpr (IsOptional<M>::value) {
+        if (value) {
+            writeValue(*value, writer, out);
+        } else {
+            out += "null";
+        }
+    } else if constexpr (IsVector<M>::value) {
+        out += '[';
+        bool first = true;
+        for (const auto& element : value) {
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            writeValue(element, writer, out);
+        }
+        out += ']';
+    } else {
+        static_assert(IsBound<M>::value, "field type has no Schema specialization");
+        writeObject(value, writer, out, std::make_index_sequence<fieldCount<M>()>());
+    }
+}
+
+} // namespace detail
+
+// Обработчик событий Parser или JsonReader, заполняющий *target. После
+// ошибки разбора перед следующим документом нужен reset() (Parser::reset())
+template <typename T>
+class BindingHandler : public Poco::JSON::Handler {
+public:
+    using Ptr = Poco::SharedPtr<BindingHandler>;
+
+    // Структура, в которую пишет следующий разбор
+    void setTarget(T* target) {
+        target_ = target;
+    }
+
+    void reset() override {
+        stack_.clear();
+        skip_ = 0;
+    }
+
+    void startObject() override {
+        open(detail::Event::StartObject);
+    }
+
+    void endObject() override {
+        close();
+    }
+
+    void startArray() override {
+        open(detail::Event::StartArray);
+    }
+
+    void endArray() override {
+        close();
+    }
+
+    void key(const std::string& k) override {
+        if (skip_ == 0) {
+            detail::Frame& top = stack_.back();
+            top.field = top.find(k);
+            if (top.field >= 0) {
+                top.seen |= std::uint64_t(1) << top.field;
+            }
+        }
+    }
+
+    void null() override {
+        detail::Event event;
+        event.kind = detail::Event::Null;
+        deliver(event);
+    }
+
+    void value(int v) override {
+        deliverInteger(v);
+    }
+
+    void value(unsigned v) override {
+        deliverUnsigned(v);
+    }
+
+#if defined(POCO_HAVE_INT64)
+    void value(Poco::Int64 v) override {
+        deliverInteger(v);
+    }
+
+    void value(Poco::UInt64 v) override {
+        deliverUnsigned(v);
+    }
+#endif
+
+    void value(const std::string& s) override {
+        detail::Event event;
+        event.kind = detail::Event::String;
+        event.string = &s;
+        deliver(event);
+    }
+
+    void value(double d) override {
+        detail::Event event;
+        event.kind = detail::Event::Double;
+        event.real = d;
+        deliver(event);
+    }
+
+    void value(bool b) override {
+        detail::Event event;
+        event.kind = detail::Event::Bool;
+        event.boolean = b;
+        deliver(event);
+    }
+
+    // Результат - в *target; дерева нет
+    Poco::Dynamic::Var asVar() const override {
+        return Poco::Dynamic::Var();
+    }
+
+private:
+    void open(detail::Event::Kind kind) {
+        if (skip_ != 0) {
+            ++skip_;
+            return;
+        }
+        detail::Event event;
+        event.kind = kind;
+        deliver(event);
+    }
+
+    void close() {
+        if (skip_ != 0) {
+            --skip_;
+            return;
+        }
+        const detail::Frame& top = stack_.back();
+        if (top.finish != nullptr) {
+            top.finish(top.target, top.seen);
+        }
+        stack_.pop_back();
+    }
+
+    void deliverInteger(Poco::Int64 v) {
+        detail::Event event;
+        event.kind = detail::Event::Int;
+        event.integer = v;
+        deliver(event);
+    }
+
+    void deliverUnsigned(Poco::UInt64 v) {
+        detail::Event event;
+        event.kind = detail::Event::UInt;
+        event.unsignedInteger = v;
+        deliver(event);
+    }
+
+    void deliver(const detail::Event& event) {
+        if (skip_ != 0) {
+            return;
+        }
+        detail::Frame child;
+        if (stack_.empty()) {
+            if (target_ == nullptr) {
+                throw Poco::NullPointerException("BindingHandler: no target");
+            }
+            child = detail::applyTo(*target_, event);
+        } else {
+            const detail::Frame& top = stack_.back();
+            if (top.find != nullptr && top.field < 0) {
+                // Значение неизвестного ключа
+                if (event.kind == detail::Event::StartObject || event.kind == detail::Event::StartArray) {
+                    skip_ = 1;
+                }
+                return;
+            }
+            try {
+                child = top.apply(top.target, top.field, event);
+            } catch (const Poco::JSON::JSONException& e) {
+                const std::string where = top.name != nullptr
+                    ? "field '" + std::string(top.name(top.field)) + "'"
+                    : std::string("array element");
+                throw Poco::JSON::JSONException(where + ": " + e.message());
+            }
+        }
+        if (child.target != nullptr) {
+            stack_.push_back(child);
+        }
+    }
+
+    T* target_ = nullptr;
+    std::vector<detail::Frame> stack_;
+    std::size_t skip_ = 0;
+};
+
+// Порождённые по Schema<T> разбор и сериализация
+template <typename T>
+class JsonBinding {
+public:
+    JsonBinding()
+        : handler_(new BindingHandler<T>)
+        , reader_(handler_) {
+    }
+
+    JsonBinding(const JsonBinding&) = delete;
+    JsonBinding& operator=(const JsonBinding&) = delete;
+
+    // Обработчик для Poco::JSON::Parser; цель задаётся setTarget()
+    const typename BindingHandler<T>::Ptr& handler() const {
+        return handler_;
+    }
+
+    // Заполняет out из документа; при ошибке содержимое out не определено
+    void parse(std::string_view json, T& out) {
+        handler_->reset();
+        handler_->setTarget(&out);
+        reader_.parse(json);
+    }
+
+    T parse(std::string_view json) {
+        T out{};
+        parse(json, out);
+        return out;
+    }
+
+    // Дописывает JSON значения в конец out
+    void write(const T& value, std::string& out) const {
+        detail::writeValue(value, writer_, out);
+    }
+
+    // JSON значения в out, заменяя прежнее содержимое
+    void stringify(const T& value, std::string& out) const {
+        out.clear();
+        write(value, out);
+    }
+
+private:
+    typename BindingHandler<T>::Ptr handler_;
+    JsonReader reader_;
+    JsonWriter writer_;
+};
+
+} // namespace binding
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_BINDING_H
@@ -0,0 +1,99 @@
+#ifndef POCO_TEST_APP_JSON_CASES_H
+#define POCO_TEST_APP_JSON_CASES_H
+
+// Наборы входных данных и вспомогательные функции, общие для тестов
+// Poco::JSON и собственных реализаций разбора (JsonReader на каждом уровне
+// json_scan.h)
+
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Dynamic/Var.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace pocotest {
+
+// Stringifier::condense в строку: эталон для сравнения деревьев и вывода
+inline std::string condensed(const Poco::Dynamic::Var& value, int options = Poco::JSON_WRAP_STRINGS) {
+    std::ostringstream ss;
+    Poco::JSON::Stringifier::condense(value, ss, options);
+    return ss.str();
+}
+
+// Некорректные документы, которые должен отвергать любой строгий парсер
+inline const std::vector<std::string>& malformedJsonCases() {
+    static const std::vector<std::string> cases = {
+        "{", "}", "[", "]",
+        "{\"key\": }",
+        "{\"key\":",
+        "[\"item\", ]",
+        "{\"key\": \"value\",}",
+        "{\"key\": \"value\" \"key2\": \"value2\"}",
+        "{key: \"value\"}", // ключи без кавычек
+        "'single_quoted'",
+        "{\"trailing\": \"comma\",}",
+        "{\"unclosed_string\": \"value}",
+        "{\"bad_escape\": \"\\x\"}",
+        "{\"number\": 123abc}",
+        "{\"control_char\": \"\x01\"}",
+        "/* comment */ {}", // комментарии не поддерживаются в строгом режиме
+        ""
+    };
+    return cases;
+}
+
+// Корректные документы из TestRFC8259Compliance: любой парсер должен
+// давать на них то же дерево, что Parser
+inline const std::vector<std::string>& validJsonCases() {
+    static const std::vector<std::string> cases = {
+        "{}",
+        "[]",
+        "{\"key\":\"value\"}",
+        "{\"key\": null}",
+        "{\"key\": true}",
+        "{\"key\": false}",
+        "{\"key\": 123}",
+        "{\"key\": -123}"
+    };
+    return cases;
+}
+
+// Строки для проверки экранирования и Unicode при записи и обратном разборе
+inline const std::vector<std::string>& escapeTestStrings() {
+    static const std::vector<std::string> strings = {
+        "\"quotes\"",
+        "back\\slash",
+        "line\nbreak",
+        "tab\there",
+        "\x7F", // control character
+        "\u00A9", // Unicode copyright
+        "\u03A9", // Greek Omega
+        "", // empty string
+        "normal string",
+        "mixed\"quotes\\backslash\nnewline\ttab"
+    };
+    return strings;
+}
+
+// Строки с описанием для проверки кодировок и специальных символов
+struct EncodingCase {
+    std::string description;
+    std::string input;
+};
+
+inline const std::vector<EncodingCase>& encodingTestCases() {
+    static const std::vector<EncodingCase> cases = {
+        {"Basic ASCII", "Hello World"},
+        {"Control chars", "Line1\\nLine2\\tTab"}, // экранированные версии
+        {"JSON escapes", "Quote\\\"Slash\\\\"},
+        {"Empty string", ""},
+        {"Numbers in string", "12345"},
+        {"Special chars", "!@#$%^&*()"}
+    };
+    return cases;
+}
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_CASES_H
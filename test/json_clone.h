@@ -0,0 +1,282 @@
+#ifndef POCO_TEST_APP_JSON_CLONE_H
+#define POCO_TEST_APP_JSON_CLONE_H
+
+// Копирование деревьев Poco::JSON без сериализации.
+//
+// Object::Ptr copy = original только разделяет дерево, а глубокую копию в
+// Poco даёт лишь stringify и повторный Parser::parse, который форматирует и
+// снова разбирает каждое значение. cloneValue()/cloneObject()/cloneArray()
+// копируют дерево напрямую: каждый Object и Array - копирующим
+// конструктором (со всеми опциями, включая JSON_PRESERVE_KEY_ORDER), после
+// чего вложенные Object::Ptr/Array::Ptr заменяются их копиями. Скаляры
+// копируются как Dynamic::Var, без преобразования в текст.
+//
+// CowTree - копирование при записи. Копии CowTree разделяют узлы дерева;
+// editObject(path)/editArray(path) проходят от корня к узлу и неглубоко
+// копируют те узлы на пути, на которые есть другие ссылки
+// (SharedPtr::referenceCount() > 1). Остальные поддеревья остаются общими,
+// так что клон шаблона с правкой нескольких полей копирует только путь к
+// ним. Путь записывается как в JsonProjection: ключи через '.', индексы в
+// скобках ("a.b[2].c"); пустой путь - корень.
+//
+// Ссылка, возвращённая edit*(), годится для изменения, пока CowTree не
+// скопирован: после копирования узел снова общий. Object::Ptr из дерева,
+// сохранённый снаружи, тоже считается ссылкой - узел будет скопирован, и
+// изменения через сохранённый Ptr в CowTree не попадут.
+
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Exception.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace pocotest {
+
+namespace clone {
+namespace detail {
+
+inline bool isContainer(const Poco::Dynamic::Var& value) {
+    const std::type_info& type = value.type();
+    return type == typeid(Poco::JSON::Object::Ptr) || type == typeid(Poco::JSON::Array::Ptr) ||
+           type == typeid(Poco::JSON::Object) || type == typeid(Poco::JSON::Array);
+}
+
+} // namespace detail
+} // namespace clone
+
+inline Poco::Dynamic::Var cloneValue(const Poco::Dynamic::Var& value);
+
+// Глубокая копия объекта; ключи и опции те же, что у исходного
+inline Poco::JSON::Object::Ptr cloneObject(const Poco::JSON::Object& object) {
+    Poco::JSON::Object::Ptr copy = new Poco::JSON::Object(object);
+    for (const auto& member : object) {
+        if (clone::detail::isContainer(member.second)) {
+            copy->set(member.first, cloneValue(member.second));
+        }
+    }
+    return copy;
+}
+
+inline Poco::JSON::Array::Ptr cloneArray(const Poco::JSON::Array& array) {
+    Poco::JSON::Array::Ptr copy = new Poco::JSON::Array(array);
+    unsigned index = 0;
+    for (const auto& element : array) {
+        if (clone::detail::isContainer(element)) {
+            copy->set(index, cloneValue(element));
+        }
+        ++index;
+    }
+    return copy;
+}
+
+// Глубокая копия значения того же типа: Object::Ptr остаётся Object::Ptr,
+// Object по значению - Object по значению. Скаляры просто копируются
+inline Poco::Dynamic::Var cloneValue(const Poco::Dynamic::Var& value) {
+    const std::type_info& type = value.type();
+    if (type == typeid(Poco::JSON::Object::Ptr)) {
+        const Poco::JSON::Object::Ptr& object = value.extract<Poco::JSON::Object::Ptr>();
+        return object.isNull() ? value : Poco::Dynamic::Var(cloneObject(*object));
+    } else if (type == typeid(Poco::JSON::Array::Ptr)) {
+        const Poco::JSON::Array::Ptr& array = value.extract<Poco::JSON::Array::Ptr>();
+        return array.isNull() ? value : Poco::Dynamic::Var(cloneArray(*array));
+    } else if (type == typeid(Poco::JSON::Object)) {
+        return Poco::Dynamic::Var(*cloneObject(value.extract<Poco::JSON::Object>()));
+    } else if (type == typeid(Poco::JSON::Array)) {
+        return Poco::Dynamic::Var(*cloneArray(value.extract<Poco::JSON::Array>()));
+    }
+    return value;
+}
+
+class CowTree {
+public:
+    // root - Object::Ptr или Array::Ptr; дерево не копируется
+    explicit CowTree(const Poco::Dynamic::Var& root)
+        : root_(root) {
+        if (!isNode(root_)) {
+            throw Poco::InvalidArgumentException("CowTree root must be an Object::Ptr or Array::Ptr");
+        }
+    }
+
+    // Корень для чтения и сериализации; узлы могут быть общими с другими
+    // CowTree, поэтому менять их можно только через edit*()
+    const Poco::Dynamic::Var& root() const {
+        return root_;
+    }
+
+    // Объект по пути, который можно менять, не затрагивая другие копии
+    Poco::JSON::Object& editObject(const std::string& path = std::string()) {
+        const Node node = edit(path);
+        if (node.object == nullptr) {
+            throw Poco::BadCastException("CowTree value is not an object", path);
+        }
+        return *node.object;
+    }
+
+    Poco::JSON::Array& editArray(const std::string& path = std::string()) {
+        const Node node = edit(path);
+        if (node.array == nullptr) {
+            throw Poco::BadCastException("CowTree value is not an array", path);
+        }
+        return *node.array;
+    }
+
+    // Число узлов, скопированных edit*() за время жизни этого CowTree
+    std::size_t copiedNodes() const {
+        return copied_;
+    }
+
+private:
+    // Узел, принадлежащий только этому дереву: ровно один из указателей
+    struct Node {
+        Poco::JSON::Object* object = nullptr;
+        Poco::JSON::Array* array = nullptr;
+    };
+
+    struct Step {
+        bool isIndex = false;
+        std::string key;
+        unsigned index = 0;
+    };
+
+    static bool isNode(const Poco::Dynamic::Var& value) {
+        return value.type() == typeid(Poco::JSON::Object::Ptr) || value.type() == typeid(Poco::JSON::Array::Ptr);
+    }
+
+    static std::vector<Step> splitPath(const std::string& path) {
+        std::vector<Step> steps;
+        std::size_t pos = 0;
+        while (pos < path.size()) {
+            Step step;
+            if (path[pos] == '[') {
+                const std::size_t close = path.find(']', pos);
+                const std::string digits = close == std::string::npos ? std::string() : path.substr(pos + 1, close - pos - 1);
+                if (digits.empty() || digits.find_first_not_of("0123456789") != std::string::npos) {
+                    throw Poco::InvalidArgumentException("Invalid array index in CowTree path", path);
+                }
+                step.isIndex = true;
+                step.index = Poco::NumberParser::parseUnsigned(digits);
+                pos = close + 1;
+            } else {
+                const std::size_t stop = path.find_first_of(".[", pos);
+                step.key = path.substr(pos, stop == std::string::npos ? std::string::npos : stop - pos);
+                if (step.key.empty() || step.key.find(']') != std::string::npos) {
+                    throw Poco::InvalidArgumentException("Empty key in CowTree path", path);
+                }
+                pos = stop == std::string::npos ? path.size() : stop;
+            }
+            steps.push_back(step);
+            if (pos < path.size() && path[pos] == '.') {
+                if (++pos == path.size()) {
+                    throw Poco::InvalidArgumentException("Empty key in CowTree path", path);
+                }
+            } else if (pos < path.size() && path[pos] != '[') {
+                throw Poco::InvalidArgumentException("Expected '.' or '[' in CowTree path", path);
+            }
+        }
+        return steps;
+    }
+
+    // Если на узел в slot есть другие ссылки, возвращает его неглубокую
+    // копию, которую вызывающий кладёт на место slot; иначе - пустое
+    // значение. Дочерние узлы копии становятся общими и копируются, когда до
+    // них дойдёт edit*()
+    Poco::Dynamic::Var own(const Poco::Dynamic::Var& slot, Node& node) {
+        const std::type_info& type = slot.type();
+        if (type == typeid(Poco::JSON::Object::Ptr)) {
+            const Poco::JSON::Object::Ptr& object = slot.extract<Poco::JSON::Object::Ptr>();
+            if (object.referenceCount() == 1) {
+                node = Node{object.get(), nullptr};
+                return Poco::Dynamic::Var();
+            }
+            Poco::JSON::Object::Ptr copy = new Poco::JSON::Object(*object);
+            node = Node{copy.get(), nullptr};
+            ++copied_;
+            return copy;
+        } else if (type == typeid(Poco::JSON::Array::Ptr)) {
+            const Poco::JSON::Array::Ptr& array = slot.extract<Poco::JSON::Array::Ptr>();
+            if (array.referenceCount() == 1) {
+                node = Node{nullptr, array.get()};
+                return Poco::Dynamic::Var();
+            }
+            Poco::JSON::Array::Ptr copy = new Poco::JSON::Array(*array);
+            node = Node{nullptr, copy.get()};
+            ++copied_;
+            return copy;
+        } else if (type == typeid(Poco::JSON::Object)) {
+            // Object по значению нельзя изменить через Var: заменяется на Ptr
+            Poco::JSON::Object::Ptr copy = new Poco::JSON::Object(slot.extract<Poco::JSON::Object>());
+            node = Node{copy.get(), nullptr};
+            ++copied_;
+            return copy;
+        } else if (type == typeid(Poco::JSON::Array)) {
+            Poco::JSON::Array::Ptr copy = new Poco::JSON::Array(slot.extract<Poco::JSON::Array>());
+            node = Node{nullptr, copy.get()};
+            ++copied_;
+            return copy;
+        }
+        node = Node{};
+        return Poco::Dynamic::Var();
+    }
+
+    Node edit(const std::string& path) {
+        const std::vector<Step> steps = splitPath(path);
+        Node node;
+        Poco::Dynamic::Var replacement = own(root_, node);
+        if (!replacement.isEmpty()) {
+            root_ = replacement;
+        }
+        for (const Step& step : steps) {
+            Node child;
+            if (step.isIndex) {
+                if (node.array == nullptr) {
+                    throw Poco::BadCastException("CowTree value is not an array", path);
+                }
+                if (step.index >= node.array->size()) {
+                    throw Poco::NotFoundException("CowTree array index out of range", path);
+                }
+                // Array::get возвращает копию Var, которая увеличила бы
+                // счётчик ссылок; элемент читается по ссылке
+                const Poco::JSON::Array& array = *node.array;
+                replacement = own(*(array.begin() + step.index), child);
+                if (!replacement.isEmpty()) {
+                    node.array->set(step.index, replacement);
+                }
+            } else {
+                if (node.object == nullptr) {
+                    throw Poco::BadCastException("CowTree value is not an object", path);
+                }
+                // Object::get тоже возвращает копию Var; член ищется обходом
+                // и читается по ссылке
+                const Poco::JSON::Object& object = *node.object;
+                const auto member = std::find_if(object.begin(), object.end(), [&](const auto& entry) {
+                    return entry.first == step.key;
+                });
+                if (member == object.end()) {
+                    throw Poco::NotFoundException("CowTree key not found", path);
+                }
+                replacement = own(member->second, child);
+                if (!replacement.isEmpty()) {
+                    node.object->set(step.key, replacement);
+                }
+            }
+            if (child.object == nullptr && child.array == nullptr) {
+                throw Poco::BadCastException("CowTree value is not a container", path);
+            }
+            node = child;
+        }
+        return node;
+    }
+
+    Poco::Dynamic::Var root_;
+    std::size_t copied_ = 0;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_CLONE_H
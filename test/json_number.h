@@ -0,0 +1,340 @@
+#ifndef POCO_TEST_APP_JSON_NUMBER_H
+#define POCO_TEST_APP_JSON_NUMBER_H
+
+// Быстрый путь для чисел: разбор, форматирование и извлечение из
+// Dynamic::Var.
+//
+// NumberParser::tryParse64/parseFloat разбирают std::string с учётом
+// разделителей разрядов (parseFloat копирует строку), а Var::convert<T>()
+// идёт через виртуальный вызов holder'а, даже если хранится ровно T;
+// double печатается через NumberFormatter (double-conversion). Здесь:
+//   - parseInt64/parseUInt64 - целые одним проходом по цифрам, без strtoll;
+//   - parseDouble - точный быстрый путь Клингера (до 2^53 в мантиссе и
+//     |степень| <= 22: одно умножение или деление точных double), остальное
+//     - std::from_chars, тоже с корректным округлением и без локали;
+//   - formatDouble - кратчайшее представление, которое читается обратно в то
+//     же число (std::to_chars, алгоритм Ryu), в раскладке ToShortest
+//     double-conversion с настройками NumberFormatter: десятичная запись при
+//     показателе от -15 до 14, иначе "1.5e+20"; "nan", "inf", "-inf"; -0
+//     печатается как "0". Вывод совпадает с Var(double).convert<std::string>();
+//   - convertValue<T> - convert<T>() без виртуального вызова, если хранится
+//     T, или целое/double, которое без потерь приводится к T; остальное, в
+//     том числе выход за диапазон, - через Var::convert с его исключениями.
+// parse* возвращают false там, где вызывающий должен уйти на путь Poco
+// (переполнение, некорректный текст), чтобы поведение на краях совпадало.
+
+#include <Poco/Dynamic/Var.h>
+
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+
+namespace pocotest {
+namespace number {
+
+// Достаточно для любого результата formatDouble
+constexpr std::size_t MAX_DOUBLE_CHARS = 40;
+
+namespace detail {
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Цифры без знака; false, если их нет, встретилось что-то кроме цифр или
+// значение не помещается в UInt64
+inline bool parseDigits(const char* p, const char* end, Poco::UInt64& value) {
+    if (p == end) {
+        return false;
+    }
+    Poco::UInt64 result = 0;
+    for (; p != end; ++p) {
+        if (!isDigit(*p)) {
+            return false;
+        }
+        const unsigned digit = static_cast<unsigned>(*p - '0');
+        if (result > (std::numeric_limits<Poco::UInt64>::max() - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+    value = result;
+    return true;
+}
+
+// Точные степени десяти для быстрого пути parseDouble
+inline double exactPowerOfTen(int exponent) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    return powers[exponent];
+}
+
+inline char* append(char* out, const char* text, std::size_t size) {
+    std::memcpy(out, text, size);
+    return out + size;
+}
+
+} // namespace detail
+
+// Целое со знаком в диапазоне Int64: "-?[0-9]+"
+inline bool parseInt64(const char* p, const char* end, Poco::Int64& value) {
+    const bool negative = p != end && *p == '-';
+    Poco::UInt64 magnitude = 0;
+    if (!detail::parseDigits(negative ? p + 1 : p, end, magnitude)) {
+        return false;
+    }
+    const Poco::UInt64 limit = static_cast<Poco::UInt64>(std::numeric_limits<Poco::Int64>::max());
+    if (negative) {
+        if (magnitude > limit + 1) {
+            return false;
+        }
+        value = magnitude == limit + 1 ? std::numeric_limits<Poco::Int64>::min()
+                                       : -static_cast<Poco::Int64>(magnitude);
+    } else {
+        if (magnitude > limit) {
+            return false;
+        }
+        value = static_cast<Poco::Int64>(magnitude);
+    }
+    return true;
+}
+
+// Целое без знака в диапазоне UInt64: "[0-9]+"
+inline bool parseUInt64(const char* p, const char* end, Poco::UInt64& value) {
+    return detail::parseDigits(p, end, value);
+}
+
+// Число JSON ("-?digits[.digits][(e|E)[+-]digits]"); false, если текст не
+// разобран или значение вне диапазона double
+inline bool parseDouble(const char* p, const char* end, double& value) {
+    // from_chars принимает ещё "inf", "nan" и ".5" - в JSON их нет
+    const char* first = p != end && *p == '-' ? p + 1 : p;
+    if (first == end || !detail::isDigit(*first)) {
+        return false;
+    }
+#if FLT_EVAL_METHOD == 0
+    // Быстрый путь: мантисса до 19 цифр, показатель вычисляется точно
+    const char* s = p;
+    const bool negative = s != end && *s == '-';
+    if (negative) {
+        ++s;
+    }
+    Poco::UInt64 mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool exact = true;
+    const char* digitsStart = s;
+    for (; s != end && detail::isDigit(*s); ++s) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*s - '0');
+            if (mantissa != 0) {
+                ++digits;
+            }
+        } else {
+            exact = false;
+        }
+    }
+    const bool integerPart = s != digitsStart;
+    if (s != end && *s == '.') {
+        ++s;
+        for (; s != end && detail::isDigit(*s); ++s) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*s - '0');
+                if (mantissa != 0) {
+                    ++digits;
+                }
+                --exponent;
+            } else {
+                exact = false;
+            }
+        }
+    }
+    if (integerPart && s != end && (*s == 'e' || *s == 'E')) {
+        ++s;
+        const bool negativeExponent = s != end && *s == '-';
+        if (s != end && (*s == '-' || *s == '+')) {
+            ++s;
+        }
+        int written = 0;
+        int explicitExponent = 0;
+        for (; s != end && detail::isDigit(*s); ++s) {
+            if (++written > 6) {
+                exact = false;
+                break;
+            }
+            explicitExponent = explicitExponent * 10 + (*s - '0');
+        }
+        if (written == 0) {
+            return false;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (exact && integerPart && s == end && mantissa <= (Poco::UInt64(1) << 53) &&
+        exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / detail::exactPowerOfTen(-exponent)
+                              : result * detail::exactPowerOfTen(exponent);
+        value = negative ? -result : result;
+        return true;
+    }
+#endif
+    double result = 0.0;
+    const std::from_chars_result parsed = std::from_chars(p, end, result);
+    if (parsed.ec != std::errc() || parsed.ptr != end) {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+// Пишет value в out (не меньше MAX_DOUBLE_CHARS байт) так же, как
+// NumberFormatter::format(double); возвращает конец записанного
+inline char* formatDouble(double value, char* out) {
+    if (std::isnan(value)) {
+        return detail::append(out, "nan", 3);
+    }
+    if (std::isinf(value)) {
+        return value < 0 ? detail::append(out, "-inf", 4) : detail::append(out, "inf", 3);
+    }
+    if (value == 0.0) {
+        *out = '0';
+        return out + 1;
+    }
+    if (value < 0) {
+        *out++ = '-';
+        value = -value;
+    }
+
+    // Кратчайшие цифры в виде "d[.ddd]e(+|-)XX"
+    char scientific[MAX_DOUBLE_CHARS];
+    const std::to_chars_result result =
+        std::to_chars(scientific, scientific + sizeof(scientific), value, std::chars_format::scientific);
+    char digits[20];
+    int length = 0;
+    const char* p = scientific;
+    for (; p != result.ptr && *p != 'e'; ++p) {
+        if (*p != '.') {
+            digits[length++] = *p;
+        }
+    }
+    int exponent = 0;
+    std::from_chars(p + (p[1] == '+' ? 2 : 1), result.ptr, exponent);
+
+    // Раскладка ToShortest: decimal_in_shortest_low = -15, high = 15
+    if (exponent >= -15 && exponent < 15) {
+        const int point = exponent + 1;
+        if (point <= 0) {
+            out = detail::append(out, "0.", 2);
+            std::memset(out, '0', static_cast<std::size_t>(-point));
+            out += -point;
+            return detail::append(out, digits, static_cast<std::size_t>(length));
+        }
+        if (point >= length) {
+            out = detail::append(out, digits, static_cast<std::size_t>(length));
+            std::memset(out, '0', static_cast<std::size_t>(point - length));
+            return out + (point - length);
+        }
+        out = detail::append(out, digits, static_cast<std::size_t>(point));
+        *out++ = '.';
+        return detail::append(out, digits + point, static_cast<std::size_t>(length - point));
+    }
+    *out++ = digits[0];
+    if (length > 1) {
+        *out++ = '.';
+        out = detail::append(out, digits + 1, static_cast<std::size_t>(length - 1));
+    }
+    *out++ = 'e';
+    if (exponent < 0) {
+        *out++ = '-';
+        exponent = -exponent;
+    } else {
+        *out++ = '+';
+    }
+    return std::to_chars(out, out + 4, exponent).ptr;
+}
+
+namespace detail {
+
+// Целое from без потерь приводится к T
+template <typename T, typename F>
+bool fitsInteger(F from) {
+    if constexpr (std::is_signed_v<F> == std::is_signed_v<T>) {
+        return from >= std::numeric_limits<T>::min() && from <= std::numeric_limits<T>::max();
+    } else if constexpr (std::is_signed_v<F>) {
+        return from >= 0 && static_cast<std::make_unsigned_t<F>>(from) <= std::numeric_limits<T>::max();
+    } else {
+        return from <= static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max());
+    }
+}
+
+// Целые, которые кладут в дерево Parser и JsonReader, и int/unsigned,
+// которые кладут через Object::set
+template <typename T, typename F>
+bool tryInteger(const Poco::Dynamic::Var& value, T& result) {
+    if (value.type() != typeid(F)) {
+        return false;
+    }
+    const F from = value.extract<F>();
+    if constexpr (std::is_floating_point_v<T>) {
+        // Целое до 2^53 представимо в double точно. Предел не помещается в
+        // int и unsigned, поэтому сравнение идёт в 64-битном типе
+        constexpr Poco::UInt64 limit = Poco::UInt64(1) << std::numeric_limits<double>::digits;
+        if constexpr (std::is_signed_v<F>) {
+            const Poco::Int64 wide = static_cast<Poco::Int64>(from);
+            if (wide < -static_cast<Poco::Int64>(limit) || wide > static_cast<Poco::Int64>(limit)) {
+                return false;
+            }
+        } else if (static_cast<Poco::UInt64>(from) > limit) {
+            return false;
+        }
+        result = static_cast<T>(from);
+        return true;
+    } else {
+        if (!fitsInteger<T>(from)) {
+            return false;
+        }
+        result = static_cast<T>(from);
+        return true;
+    }
+}
+
+} // namespace detail
+
+// Var::convert<T>() с быстрым путём для совпадающего типа и для
+// преобразований между числами без потерь
+template <typename T>
+T convertValue(const Poco::Dynamic::Var& value) {
+    const std::type_info& type = value.type();
+    if (type == typeid(T)) {
+        return value.extract<T>();
+    }
+    if constexpr ((std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, double>) {
+        T result;
+        if (detail::tryInteger<T, Poco::Int64>(value, result) ||
+            detail::tryInteger<T, Poco::UInt64>(value, result) ||
+            detail::tryInteger<T, int>(value, result) ||
+            detail::tryInteger<T, unsigned>(value, result)) {
+            return result;
+        }
+    }
+    if constexpr (std::is_same_v<T, std::string>) {
+        if (type == typeid(double)) {
+            char buffer[MAX_DOUBLE_CHARS];
+            return std::string(buffer, formatDouble(value.extract<double>(), buffer));
+        }
+    }
+    return value.convert<T>();
+}
+
+} // namespace number
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_NUMBER_H
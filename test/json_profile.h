@@ -0,0 +1,355 @@
+#ifndef POCO_TEST_APP_JSON_PROFILE_H
+#define POCO_TEST_APP_JSON_PROFILE_H
+
+// Замер времени и выделений памяти по стадиям разбора и сериализации JSON.
+//
+// Стадии (Stage): Parse - один вызов разбора документа, Tokenize -
+// лексический разбор в JsonReader, Build - события обработчика (построение
+// дерева), Stringify - один вызов сериализации, Escape - экранирование
+// строки в JsonWriter. Scope на время своей жизни замеряет время и
+// выделения памяти текущего потока (alloc_counter.h) и добавляет их к
+// стадии в общем реестре. Время вложенных Scope вычитается из собственного
+// (self) времени внешнего: у JsonReader собственное время Parse - проверка
+// UTF-8, у Tokenize - сам лексер, если события замеряются TimedHandler. В
+// Poco::JSON::Parser и Stringifier замеры не встроить, поэтому их вызовы
+// оборачиваются profile::parse() и profile::stringify(), а собственное время
+// Parse с TimedHandler - это лексер Poco.
+//
+// В JsonReader, JsonWriter и ReusableParser замеры стоят на горячих путях
+// через POCO_TEST_APP_PROFILE_SCOPE и компилируются, только если определён
+// POCO_TEST_APP_PROFILE (cmake -DPOCO_TEST_PROFILE=ON); иначе макрос пуст.
+// В такой сборке при завершении процесса сводка по стадиям печатается в
+// std::cerr.
+//
+// Цели, использующие Scope, собираются с alloc_counter.cpp.
+
+#include "alloc_counter.h"
+
+#include <Poco/JSON/Handler.h>
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Dynamic/Var.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <string>
+
+#ifdef POCO_TEST_APP_PROFILE
+#define POCO_TEST_APP_PROFILE_SCOPE(stage) \
+    const ::pocotest::profile::Scope pocoTestAppProfileScope_(::pocotest::profile::Stage::stage)
+#else
+#define POCO_TEST_APP_PROFILE_SCOPE(stage) static_cast<void>(0)
+#endif
+
+namespace pocotest {
+namespace profile {
+
+#ifdef POCO_TEST_APP_PROFILE
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+enum class Stage {
+    Parse,
+    Tokenize,
+    Build,
+    Stringify,
+    Escape
+};
+
+constexpr std::size_t STAGE_COUNT = 5;
+
+inline const char* stageName(Stage stage) {
+    switch (stage) {
+        case Stage::Parse: return "parse";
+        case Stage::Tokenize: return "tokenize";
+        case Stage::Build: return "build";
+        case Stage::Stringify: return "stringify";
+        case Stage::Escape: return "escape";
+    }
+    return "unknown";
+}
+
+// Накопленные значения одной стадии
+struct StageStats {
+    std::uint64_t calls = 0;
+    std::uint64_t nanoseconds = 0;       // вместе с вложенными стадиями
+    std::uint64_t selfNanoseconds = 0;   // без вложенных стадий
+    std::uint64_t allocations = 0;       // вместе с вложенными стадиями
+    std::uint64_t bytes = 0;
+};
+
+// Счётчики всех стадий всех потоков
+class Registry {
+public:
+    Registry()
+        : dumpAtExit_(ENABLED) {
+    }
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    ~Registry() {
+        if (dumpAtExit_.load(std::memory_order_relaxed) && !empty()) {
+            dump(std::cerr);
+        }
+    }
+
+    void add(Stage stage, const StageStats& sample) {
+        Counters& c = counters_[static_cast<std::size_t>(stage)];
+        c.calls.fetch_add(sample.calls, std::memory_order_relaxed);
+        c.nanoseconds.fetch_add(sample.nanoseconds, std::memory_order_relaxed);
+        c.selfNanoseconds.fetch_add(sample.selfNanoseconds, std::memory_order_relaxed);
+        c.allocations.fetch_add(sample.allocations, std::memory_order_relaxed);
+        c.bytes.fetch_add(sample.bytes, std::memory_order_relaxed);
+    }
+
+    StageStats stats(Stage stage) const {
+        const Counters& c = counters_[static_cast<std::size_t>(stage)];
+        StageStats result;
+        result.calls = c.calls.load(std::memory_order_relaxed);
+        result.nanoseconds = c.nanoseconds.load(std::memory_order_relaxed);
+        result.selfNanoseconds = c.selfNanoseconds.load(std::memory_order_relaxed);
+        result.allocations = c.allocations.load(std::memory_order_relaxed);
+        result.bytes = c.bytes.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    bool empty() const {
+        for (std::size_t i = 0; i < STAGE_COUNT; ++i) {
+            if (counters_[i].calls.load(std::memory_order_relaxed) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Обнуляет счётчики; замеры, идущие в других потоках, не должны
+    // пересекаться со сбросом
+    void reset() {
+        for (Counters& c : counters_) {
+            c.calls.store(0, std::memory_order_relaxed);
+            c.nanoseconds.store(0, std::memory_order_relaxed);
+            c.selfNanoseconds.store(0, std::memory_order_relaxed);
+            c.allocations.store(0, std::memory_order_relaxed);
+            c.bytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Печатать ли сводку при завершении процесса; по умолчанию - только в
+    // сборке с POCO_TEST_APP_PROFILE
+    void setDumpAtExit(bool dump) {
+        dumpAtExit_.store(dump, std::memory_order_relaxed);
+    }
+
+    // Таблица по стадиям, у которых были вызовы
+    void dump(std::ostream& out) const {
+        out << "JSON profile (allocations include nested stages)\n"
+            << std::left << std::setw(12) << "stage"
+            << std::right << std::setw(12) << "calls"
+            << std::setw(12) << "total ms"
+            << std::setw(12) << "self ms"
+            << std::setw(12) << "ns/call"
+            << std::setw(14) << "allocs/call"
+            << std::setw(14) << "bytes/call" << '\n';
+        out << std::fixed << std::setprecision(2);
+        for (std::size_t i = 0; i < STAGE_COUNT; ++i) {
+            const Stage stage = static_cast<Stage>(i);
+            const StageStats s = stats(stage);
+            if (s.calls == 0) {
+                continue;
+            }
+            const double calls = static_cast<double>(s.calls);
+            out << std::left << std::setw(12) << stageName(stage)
+                << std::right << std::setw(12) << s.calls
+                << std::setw(12) << s.nanoseconds / 1e6
+                << std::setw(12) << s.selfNanoseconds / 1e6
+                << std::setw(12) << s.nanoseconds / calls
+                << std::setw(14) << s.allocations / calls
+                << std::setw(14) << s.bytes / calls << '\n';
+        }
+        out.unsetf(std::ios::floatfield);
+    }
+
+private:
+    struct Counters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> nanoseconds{0};
+        std::atomic<std::uint64_t> selfNanoseconds{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> bytes{0};
+    };
+
+    std::array<Counters, STAGE_COUNT> counters_;
+    std::atomic<bool> dumpAtExit_;
+};
+
+inline Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Замер одной стадии от создания до разрушения объекта
+class Scope {
+public:
+    explicit Scope(Stage stage)
+        : stage_(stage)
+        , parent_(current())
+        , start_(Clock::now()) {
+        current() = this;
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() {
+        const std::uint64_t elapsed = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count());
+        const AllocationStats allocated = allocations_.delta();
+
+        StageStats sample;
+        sample.calls = 1;
+        sample.nanoseconds = elapsed;
+        sample.selfNanoseconds = elapsed - std::min(children_, elapsed);
+        sample.allocations = allocated.allocations;
+        sample.bytes = allocated.bytes;
+        registry().add(stage_, sample);
+
+        if (parent_ != nullptr) {
+            parent_->children_ += elapsed;
+        }
+        current() = parent_;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Самый внутренний открытый Scope текущего потока
+    static Scope*& current() {
+        static thread_local Scope* scope = nullptr;
+        return scope;
+    }
+
+    Stage stage_;
+    Scope* parent_;
+    std::uint64_t children_ = 0;
+    AllocationScope allocations_;
+    Clock::time_point start_;
+};
+
+// Обработчик-обёртка: каждое событие передаётся inner и замеряется как
+// стадия Build
+class TimedHandler : public Poco::JSON::Handler {
+public:
+    explicit TimedHandler(const Poco::JSON::Handler::Ptr& inner)
+        : inner_(inner) {
+    }
+
+    const Poco::JSON::Handler::Ptr& inner() const {
+        return inner_;
+    }
+
+    void reset() override {
+        inner_->reset();
+    }
+
+    void startObject() override {
+        const Scope scope(Stage::Build);
+        inner_->startObject();
+    }
+
+    void endObject() override {
+        const Scope scope(Stage::Build);
+        inner_->endObject();
+    }
+
+    void startArray() override {
+        const Scope scope(Stage::Build);
+        inner_->startArray();
+    }
+
+    void endArray() override {
+        const Scope scope(Stage::Build);
+        inner_->endArray();
+    }
+
+    void key(const std::string& k) override {
+        const Scope scope(Stage::Build);
+        inner_->key(k);
+    }
+
+    void null() override {
+        const Scope scope(Stage::Build);
+        inner_->null();
+    }
+
+    void value(int v) override {
+        const Scope scope(Stage::Build);
+        inner_->value(v);
+    }
+
+    void value(unsigned v) override {
+        const Scope scope(Stage::Build);
+        inner_->value(v);
+    }
+
+#if defined(POCO_HAVE_INT64)
+    void value(Poco::Int64 v) override {
+        const Scope scope(Stage::Build);
+        inner_->value(v);
+    }
+
+    void value(Poco::UInt64 v) override {
+        const Scope scope(Stage::Build);
+        inner_->value(v);
+    }
+#endif
+
+    void value(const std::string& s) override {
+        const Scope scope(Stage::Build);
+        inner_->value(s);
+    }
+
+    void value(double d) override {
+        const Scope scope(Stage::Build);
+        inner_->value(d);
+    }
+
+    void value(bool b) override {
+        const Scope scope(Stage::Build);
+        inner_->value(b);
+    }
+
+    Poco::Dynamic::Var asVar() const override {
+        return inner_->asVar();
+    }
+
+private:
+    Poco::JSON::Handler::Ptr inner_;
+};
+
+// Poco::JSON::Parser::parse как стадия Parse
+inline Poco::Dynamic::Var parse(Poco::JSON::Parser& parser, const std::string& json) {
+    const Scope scope(Stage::Parse);
+    return parser.parse(json);
+}
+
+// Stringifier::condense как стадия Stringify
+inline void stringify(const Poco::Dynamic::Var& value, std::ostream& out,
+                      int options = Poco::JSON_WRAP_STRINGS) {
+    const Scope scope(Stage::Stringify);
+    Poco::JSON::Stringifier::condense(value, out, options);
+}
+
+} // namespace profile
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_PROFILE_H
@@ -0,0 +1,499 @@
+#ifndef POCO_TEST_APP_JSON_PROJECTION_H
+#define POCO_TEST_APP_JSON_PROJECTION_H
+
+// Выборочный разбор: из документа извлекаются только значения по заданным
+// путям, остальное пропускается без построения дерева.
+//
+// Parser::parse строит Object/Array/Dynamic::Var для всего документа, даже
+// если нужны несколько полей. JsonProjection получает список путей вида
+// "a.b[2].c" (ключи через '.', индексы массивов в скобках) и проходит
+// документ по префиксному дереву этих путей. Ненужные значения пропускаются
+// на уровне байтов: скобки сопоставляются счётчиком со стеком, который
+// переиспользуется между документами, тела строк и промежутки между
+// скобками пробегаются векторным поиском (json_scan.h). В дерево Poco
+// разбираются (через JsonReader) только запрошенные значения.
+//
+// Результат для пути совпадает с Query::find по полностью разобранному
+// документу, если тип каждого промежуточного значения соответствует пути;
+// индекс у не-массива даёт пустое значение, а не игнорируется, как в
+// Query. При повторяющихся ключах, как и в Parser, побеждает последний.
+//
+// Запрошенные значения и ключи объектов на пути к ним проверяются полностью.
+// В пропускаемых значениях проверяется только парность скобок и кавычек,
+// так что, например, "tru" в ненужном поле ошибкой не считается.
+
+#include "json_reader.h"
+#include "json_scan.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Exception.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+namespace pocotest {
+
+class JsonProjection {
+public:
+    explicit JsonProjection(const std::vector<std::string>& paths)
+        : paths_(paths) {
+        compile();
+    }
+
+    const std::vector<std::string>& paths() const {
+        return paths_;
+    }
+
+    // Максимальная глубина вложенности; 0 - без ограничения
+    void setDepth(std::size_t depth) {
+        maxDepth_ = depth;
+    }
+
+    std::size_t getDepth() const {
+        return maxDepth_;
+    }
+
+    // Разбирает документ; values[i] - значение paths()[i] или пустое
+    // значение, если его нет. Вход не копируется
+    void parse(const char* data, std::size_t size, std::vector<Poco::Dynamic::Var>& values) {
+        values.assign(paths_.size(), Poco::Dynamic::Var());
+        values_ = &values;
+        begin_ = data;
+        p_ = data;
+        end_ = data + size;
+        skipped_ = 0;
+        kernels_ = &scan::kernels();
+
+        skipWhitespace();
+        if (p_ == end_) {
+            fail("Empty JSON document");
+        }
+        parseValue(0, 0);
+        skipWhitespace();
+        if (p_ != end_) {
+            fail("Excess characters found after JSON end");
+        }
+    }
+
+    std::vector<Poco::Dynamic::Var> parse(std::string_view json) {
+        std::vector<Poco::Dynamic::Var> values;
+        parse(json.data(), json.size(), values);
+        return values;
+    }
+
+    // Число байт, пропущенных последним разбором без построения дерева
+    std::size_t skippedBytes() const {
+        return skipped_;
+    }
+
+private:
+    // Шаг пути: ключ объекта или индекс массива
+    struct Step {
+        bool isIndex = false;
+        std::string key;
+        std::size_t index = 0;
+    };
+
+    // Путь, вложенный в другой запрошенный путь: берётся из уже
+    // разобранного значения предка
+    struct Derived {
+        std::size_t result;
+        std::vector<Step> steps;
+    };
+
+    struct Node {
+        std::vector<std::pair<std::string, std::size_t>> keys;
+        std::vector<std::pair<std::size_t, std::size_t>> indexes;
+        std::vector<std::size_t> results;     // пути, оканчивающиеся здесь
+        std::vector<Derived> derived;
+        std::vector<std::size_t> subtree;     // все пути в поддереве
+    };
+
+    static std::vector<Step> splitPath(const std::string& path) {
+        std::vector<Step> steps;
+        std::size_t pos = 0;
+        while (pos < path.size()) {
+            if (path[pos] == '[') {
+                const std::size_t close = path.find(']', pos);
+                const std::string digits = close == std::string::npos ? std::string() : path.substr(pos + 1, close - pos - 1);
+                if (digits.empty() || digits.find_first_not_of("0123456789") != std::string::npos) {
+                    throw Poco::InvalidArgumentException("Invalid array index in projection path", path);
+                }
+                Step step;
+                step.isIndex = true;
+                step.index = static_cast<std::size_t>(Poco::NumberParser::parseUnsigned64(digits));
+                steps.push_back(step);
+                pos = close + 1;
+                if (pos < path.size() && path[pos] != '.' && path[pos] != '[') {
+                    throw Poco::InvalidArgumentException("Expected '.' or '[' after array index in projection path", path);
+                }
+                if (pos < path.size() && path[pos] == '.') {
+                    ++pos;
+                    if (pos == path.size()) {
+                        throw Poco::InvalidArgumentException("Empty key in projection path", path);
+                    }
+                }
+            } else {
+                const std::size_t stop = path.find_first_of(".[", pos);
+                Step step;
+                step.key = path.substr(pos, stop == std::string::npos ? std::string::npos : stop - pos);
+                if (step.key.empty() || step.key.find(']') != std::string::npos) {
+                    throw Poco::InvalidArgumentException("Empty key in projection path", path);
+                }
+                steps.push_back(step);
+                pos = stop == std::string::npos ? path.size() : stop;
+                if (pos < path.size() && path[pos] == '.') {
+                    ++pos;
+                    if (pos == path.size()) {
+                        throw Poco::InvalidArgumentException("Empty key in projection path", path);
+                    }
+                }
+            }
+        }
+        return steps;
+    }
+
+    // Строит префиксное дерево. Короткие пути вставляются первыми, так что
+    // путь под уже запрошенным значением становится производным
+    void compile() {
+        std::vector<std::vector<Step>> split;
+        std::vector<std::size_t> order;
+        for (std::size_t i = 0; i < paths_.size(); ++i) {
+            split.push_back(splitPath(paths_[i]));
+            order.push_back(i);
+        }
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return split[a].size() < split[b].size();
+        });
+
+        nodes_.assign(1, Node());
+        for (std::size_t result : order) {
+            const std::vector<Step>& steps = split[result];
+            std::size_t node = 0;
+            std::size_t depth = 0;
+            for (; depth < steps.size() && nodes_[node].results.empty(); ++depth) {
+                nodes_[node].subtree.push_back(result);
+                node = child(node, steps[depth]);
+            }
+            nodes_[node].subtree.push_back(result);
+            if (!nodes_[node].results.empty() && depth < steps.size()) {
+                nodes_[node].derived.push_back(Derived{result, std::vector<Step>(steps.begin() + depth, steps.end())});
+            } else {
+                nodes_[node].results.push_back(result);
+            }
+        }
+    }
+
+    std::size_t child(std::size_t node, const Step& step) {
+        if (step.isIndex) {
+            for (const auto& entry : nodes_[node].indexes) {
+                if (entry.first == step.index) {
+                    return entry.second;
+                }
+            }
+            nodes_.emplace_back();
+            nodes_[node].indexes.emplace_back(step.index, nodes_.size() - 1);
+        } else {
+            for (const auto& entry : nodes_[node].keys) {
+                if (entry.first == step.key) {
+                    return entry.second;
+                }
+            }
+            nodes_.emplace_back();
+            nodes_[node].keys.emplace_back(step.key, nodes_.size() - 1);
+        }
+        return nodes_.size() - 1;
+    }
+
+    static Poco::Dynamic::Var navigate(Poco::Dynamic::Var value, const std::vector<Step>& steps) {
+        for (const Step& step : steps) {
+            if (step.isIndex) {
+                if (value.type() != typeid(Poco::JSON::Array::Ptr)) {
+                    return Poco::Dynamic::Var();
+                }
+                value = value.extract<Poco::JSON::Array::Ptr>()->get(static_cast<unsigned>(step.index));
+            } else {
+                if (value.type() != typeid(Poco::JSON::Object::Ptr)) {
+                    return Poco::Dynamic::Var();
+                }
+                value = value.extract<Poco::JSON::Object::Ptr>()->get(step.key);
+            }
+        }
+        return value;
+    }
+
+    // depth - число открытых контейнеров вокруг значения. Глубину
+    // запрошенных и пропускаемых значений проверяет skipValue(), так что
+    // JsonReader разбирает уже проверенный участок без своего ограничения
+    void parseValue(std::size_t node, std::size_t depth) {
+        const Node& current = nodes_[node];
+        if (!current.results.empty()) {
+            const char* start = p_;
+            skipValue(depth);
+            const Poco::Dynamic::Var value = reader_.parse(start, static_cast<std::size_t>(p_ - start));
+            for (std::size_t result : current.results) {
+                (*values_)[result] = value;
+            }
+            for (const Derived& derived : current.derived) {
+                (*values_)[derived.result] = navigate(value, derived.steps);
+            }
+            return;
+        }
+        const bool object = *p_ == '{' && !current.keys.empty();
+        const bool array = *p_ == '[' && !current.indexes.empty();
+        if ((object || array) && maxDepth_ != 0 && depth >= maxDepth_) {
+            fail("Maximum JSON nesting depth exceeded");
+        }
+        if (object) {
+            parseObject(current, depth + 1);
+        } else if (array) {
+            parseArray(current, depth + 1);
+        } else {
+            skip(depth);
+        }
+    }
+
+    void skip(std::size_t depth) {
+        const char* start = p_;
+        skipValue(depth);
+        skipped_ += static_cast<std::size_t>(p_ - start);
+    }
+
+    void parseObject(const Node& node, std::size_t depth) {
+        ++p_;
+        skipWhitespace();
+        if (p_ != end_ && *p_ == '}') {
+            ++p_;
+            return;
+        }
+        for (;;) {
+            skipWhitespace();
+            if (p_ == end_ || *p_ != '"') {
+                fail("Expected object key");
+            }
+            const std::string_view key = parseKey();
+            skipWhitespace();
+            if (p_ == end_ || *p_ != ':') {
+                fail("Expected ':' after object key");
+            }
+            ++p_;
+            skipWhitespace();
+            if (p_ == end_) {
+                fail("Unexpected end of JSON document");
+            }
+
+            std::size_t next = 0;
+            for (const auto& entry : node.keys) {
+                if (entry.first == key) {
+                    next = entry.second;
+                    break;
+                }
+            }
+            if (next != 0) {
+                // Повторный ключ заменяет прежнее значение
+                for (std::size_t result : nodes_[next].subtree) {
+                    (*values_)[result].clear();
+                }
+                parseValue(next, depth);
+            } else {
+                skip(depth);
+            }
+
+            skipWhitespace();
+            if (p_ != end_ && *p_ == ',') {
+                ++p_;
+                continue;
+            }
+            if (p_ != end_ && *p_ == '}') {
+                ++p_;
+                return;
+            }
+            fail("Expected ',' or '}'");
+        }
+    }
+
+    void parseArray(const Node& node, std::size_t depth) {
+        ++p_;
+        skipWhitespace();
+        if (p_ != end_ && *p_ == ']') {
+            ++p_;
+            return;
+        }
+        for (std::size_t index = 0;; ++index) {
+            skipWhitespace();
+            if (p_ == end_) {
+                fail("Unexpected end of JSON document");
+            }
+            std::size_t next = 0;
+            for (const auto& entry : node.indexes) {
+                if (entry.first == index) {
+                    next = entry.second;
+                    break;
+                }
+            }
+            if (next != 0) {
+                parseValue(next, depth);
+            } else {
+                skip(depth);
+            }
+
+            skipWhitespace();
+            if (p_ != end_ && *p_ == ',') {
+                ++p_;
+                continue;
+            }
+            if (p_ != end_ && *p_ == ']') {
+                ++p_;
+                return;
+            }
+            fail("Expected ',' or ']'");
+        }
+    }
+
+    // Ключ без escape-последовательностей возвращается как участок входа,
+    // остальные декодируются JsonReader в key_
+    std::string_view parseKey() {
+        const char* start = p_;
+        ++p_;
+        const char* run = kernels_->stringRun(p_, end_);
+        if (run != end_ && *run == '"') {
+            p_ = run + 1;
+            if (scan::validateUtf8(*kernels_, start + 1, run) != run) {
+                p_ = start;
+                fail("Invalid UTF-8 sequence");
+            }
+            return std::string_view(start + 1, static_cast<std::size_t>(run - start - 1));
+        }
+        p_ = start;
+        skipString();
+        key_ = reader_.parse(start, static_cast<std::size_t>(p_ - start)).extract<std::string>();
+        return key_;
+    }
+
+    // Пропускает значение, начинающееся в p_ (не пробел), внутри depth
+    // открытых контейнеров
+    void skipValue(std::size_t depth) {
+        const char c = *p_;
+        if (c == '"') {
+            skipString();
+        } else if (c == '{' || c == '[') {
+            skipContainer(depth);
+        } else {
+            skipScalar();
+        }
+    }
+
+    void skipString() {
+        ++p_;
+        for (;;) {
+            p_ = kernels_->stringRun(p_, end_);
+            if (p_ == end_) {
+                fail("Unterminated string");
+            }
+            const char c = *p_;
+            if (c == '"') {
+                ++p_;
+                return;
+            }
+            if (c != '\\') {
+                fail("Invalid control character in string");
+            }
+            p_ += 2;
+            if (p_ > end_) {
+                p_ = end_;
+                fail("Unterminated string");
+            }
+        }
+    }
+
+    // Скобки сопоставляются по стеку; всё между кавычками и скобками
+    // пропускается одним векторным поиском
+    void skipContainer(std::size_t depth) {
+        stack_.clear();
+        for (;;) {
+            p_ = kernels_->structuralRun(p_, end_);
+            if (p_ == end_) {
+                fail("Unexpected end of JSON document");
+            }
+            const char c = *p_;
+            if (c == '"') {
+                skipString();
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                if (maxDepth_ != 0 && depth + stack_.size() >= maxDepth_) {
+                    fail("Maximum JSON nesting depth exceeded");
+                }
+                stack_.push_back(c == '{' ? '}' : ']');
+            } else {
+                if (stack_.empty() || stack_.back() != c) {
+                    fail("Mismatched bracket");
+                }
+                stack_.pop_back();
+            }
+            ++p_;
+            if (stack_.empty()) {
+                return;
+            }
+        }
+    }
+
+    // Число или литерал: до ближайшего разделителя
+    void skipScalar() {
+        const char* start = p_;
+        while (p_ != end_) {
+            const char c = *p_;
+            if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                c == '-' || c == '+' || c == '.') {
+                ++p_;
+            } else {
+                break;
+            }
+        }
+        if (p_ == start) {
+            fail("Unexpected character");
+        }
+    }
+
+    void skipWhitespace() {
+        p_ = kernels_->skipWhitespace(p_, end_);
+    }
+
+    [[noreturn]] void fail(const char* message) const {
+        std::string text(message);
+        text += " at offset ";
+        text += std::to_string(static_cast<std::size_t>(p_ - begin_));
+        if (p_ != end_) {
+            text += " near '";
+            text += *p_;
+            text += '\'';
+        }
+        throw Poco::JSON::JSONException(text);
+    }
+
+    std::vector<std::string> paths_;
+    std::vector<Node> nodes_;           // nodes_[0] - корень
+    std::size_t maxDepth_ = 0;
+    JsonReader reader_;
+    std::string stack_;
+    std::string key_;
+
+    std::vector<Poco::Dynamic::Var>* values_ = nullptr;
+    const char* begin_ = nullptr;
+    const char* p_ = nullptr;
+    const char* end_ = nullptr;
+    std::size_t skipped_ = 0;
+    const scan::Kernels* kernels_ = nullptr;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_PROJECTION_H
@@ -0,0 +1,638 @@
+#ifndef POCO_TEST_APP_JSON_PUSH_PARSER_H
+#define POCO_TEST_APP_JSON_PUSH_PARSER_H
+
+// Разбор JSON, поступающего кусками: тело HTTP-запроса, сообщения из сокета.
+//
+// JsonReader и Poco::JSON::Parser требуют весь документ сразу (или поток,
+// из которого можно читать с блокировкой), так что сервер, получающий тело
+// частями, сначала собирает его в строку и только потом разбирает.
+// JsonPushParser принимает куски по мере поступления: feed() разбирает всё,
+// что можно разобрать, сохраняет состояние до следующего вызова и
+// возвращает Status::Complete, когда документ закончен. finish() сообщает
+// о конце входа и возвращает результат обработчика.
+//
+// Грамматика, типы чисел и сообщения об ошибках - те же, что у JsonReader;
+// события передаются тому же Poco::JSON::Handler. Состояние между кусками
+// хранится на границе токенов: стек контейнеров, ожидаемый токен и, внутри
+// строки, уже декодированная часть. Незаконченный токен (число, литерал,
+// escape-последовательность или обрезанный символ UTF-8) копируется во
+// внутренний буфер и дочитывается из начала следующего куска; остальное
+// разбирается прямо в буфере вызывающего без копирования.
+//
+// Число в конце куска не считается законченным: "12" может продолжиться
+// "34". Поэтому документ из одного числа заканчивается только в finish().
+// Любой другой документ feed() распознаёт сам, после чего допускаются
+// только пробелы. После finish() или ошибки следующий feed() начинает новый
+// документ.
+
+#include "json_reader.h"
+#include "json_number.h"
+#include "json_scan.h"
+
+#include <Poco/JSON/Handler.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/NumberParser.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pocotest {
+
+class JsonPushParser {
+public:
+    enum class Status {
+        NeedMore,   // документ ещё не закончен
+        Complete    // документ закончен; finish() вернёт результат
+    };
+
+    // Столько байт нового куска дописывается к незаконченному токену
+    // предыдущего, прежде чем разбор перейдёт в буфер вызывающего. Хватает
+    // для любого литерала, escape-последовательности и обычного числа
+    static constexpr std::size_t STITCH_SIZE = 64;
+
+    explicit JsonPushParser(const Poco::JSON::Handler::Ptr& handler = new Poco::JSON::ParseHandler)
+        : handler_(handler)
+        , kernels_(&scan::kernels()) {
+    }
+
+    // Максимальная глубина вложенности; 0 - без ограничения
+    void setDepth(std::size_t depth) {
+        maxDepth_ = depth;
+    }
+
+    std::size_t getDepth() const {
+        return maxDepth_;
+    }
+
+    const Poco::JSON::Handler::Ptr& handler() const {
+        return handler_;
+    }
+
+    // Разбирает очередной кусок. Данные нужны только на время вызова
+    Status feed(const char* data, std::size_t size) {
+        if (!started_) {
+            start();
+        }
+        try {
+            std::size_t offset = 0;
+            if (!pending_.empty()) {
+                // Незаконченный токен дочитывается из начала куска
+                const std::size_t held = pending_.size();
+                const std::size_t take = std::min(size, STITCH_SIZE);
+                pending_.append(data, take);
+                std::size_t used = runPending(false);
+                if (used >= held) {
+                    offset = used - held;
+                    pending_.clear();
+                } else if (take == size) {
+                    pending_.erase(0, used);
+                    return status();
+                } else {
+                    // Токен длиннее STITCH_SIZE: кусок дописывается целиком
+                    pending_.erase(0, used);
+                    pending_.append(data + take, size - take);
+                    used = runPending(false);
+                    pending_.erase(0, used);
+                    return status();
+                }
+            }
+            run(data + offset, data + size, false);
+            consumed_ += static_cast<std::size_t>(mark_ - begin_);
+            pending_.assign(mark_, data + size);
+            return status();
+        } catch (...) {
+            started_ = false;
+            throw;
+        }
+    }
+
+    Status feed(std::string_view data) {
+        return feed(data.data(), data.size());
+    }
+
+    // Конец входа: дочитывает число верхнего уровня и возвращает результат
+    // обработчика (asVar()). Если документ не закончен - JSONException
+    Poco::Dynamic::Var finish() {
+        if (!started_) {
+            start();
+        }
+        started_ = false;
+        runPending(true);
+        if (inString_) {
+            fail("Unterminated string");
+        }
+        if (state_ != State::Done) {
+            fail(state_ == State::Value && stack_.empty() ? "Empty JSON document"
+                                                          : "Unexpected end of JSON document");
+        }
+        return handler_->asVar();
+    }
+
+    // Отбрасывает незаконченный документ
+    void reset() {
+        started_ = false;
+        pending_.clear();
+    }
+
+    // Закончен ли документ, разбираемый сейчас
+    bool isComplete() const {
+        return started_ && state_ == State::Done;
+    }
+
+    // Число байт текущего документа, разобранных до конца; байты
+    // незаконченного токена сюда не входят
+    std::size_t bytesConsumed() const {
+        return consumed_;
+    }
+
+    // Память, удерживаемая между кусками и документами
+    std::size_t pendingCapacity() const {
+        return pending_.capacity();
+    }
+
+    std::size_t scratchCapacity() const {
+        return scratch_.capacity();
+    }
+
+private:
+    enum class State {
+        Value,        // ожидается значение
+        ArrayFirst,   // после '[': значение или ']'
+        ObjectFirst,  // после '{': ключ или '}'
+        Key,          // после ',' в объекте: ключ
+        Colon,        // после ключа: ':'
+        AfterValue,   // ожидается ',' или закрывающая скобка
+        Done          // документ закончен, допустимы только пробелы
+    };
+
+    void start() {
+        handler_->reset();
+        stack_.clear();
+        pending_.clear();
+        scratch_.clear();
+        state_ = State::Value;
+        inString_ = false;
+        needDelimiter_ = false;
+        consumed_ = 0;
+        started_ = true;
+    }
+
+    Status status() const {
+        return state_ == State::Done ? Status::Complete : Status::NeedMore;
+    }
+
+    // Разбирает pending_ и возвращает число разобранных байт
+    std::size_t runPending(bool final) {
+        const char* data = pending_.data();
+        run(data, data + pending_.size(), final);
+        const std::size_t used = static_cast<std::size_t>(mark_ - begin_);
+        consumed_ += used;
+        return used;
+    }
+
+    // Разбирает [begin, filled) до первого незаконченного токена; его начало
+    // (или точка продолжения строки) остаётся в mark_. Обрезанный символ
+    // UTF-8 в конце не разбирается, пока final не сообщит, что продолжения не
+    // будет
+    void run(const char* begin, const char* filled, bool final) {
+        begin_ = begin;
+        p_ = begin;
+        mark_ = begin;
+        end_ = filled;
+        const char* invalid = scan::validateUtf8(*kernels_, begin, filled);
+        if (invalid != filled) {
+            if (final || !detail::isTruncatedUtf8(invalid, filled)) {
+                p_ = invalid;
+                fail("Invalid UTF-8 sequence");
+            }
+            end_ = invalid;
+        }
+        while (step(final)) {
+        }
+    }
+
+    // Разбирает один токен; false - данные кончились
+    bool step(bool final) {
+        mark_ = p_;
+        if (inString_) {
+            if (!parseString()) {
+                return false;
+            }
+            endString();
+            return true;
+        }
+        // После литерала или числа должен идти разделитель: иначе "123abc"
+        // или "truex" были бы приняты по частям
+        if (needDelimiter_) {
+            if (p_ == end_) {
+                return false;
+            }
+            const char c = *p_;
+            if (!detail::isJsonWhitespace(c) && c != ',' && c != ']' && c != '}') {
+                fail("Unexpected character after value");
+            }
+            needDelimiter_ = false;
+        }
+        while (p_ != end_ && detail::isJsonWhitespace(*p_)) {
+            p_ = kernels_->skipWhitespace(p_ + 1, end_);
+        }
+        mark_ = p_;
+        if (p_ == end_) {
+            return false;
+        }
+        const char c = *p_;
+        switch (state_) {
+            case State::Value:
+                return parseValue(final);
+            case State::ArrayFirst:
+                if (c == ']') {
+                    ++p_;
+                    stack_.pop_back();
+                    handler_->endArray();
+                    endValue();
+                    return true;
+                }
+                checkDepth();
+                return parseValue(final);
+            case State::ObjectFirst:
+                if (c == '}') {
+                    ++p_;
+                    stack_.pop_back();
+                    handler_->endObject();
+                    endValue();
+                    return true;
+                }
+                checkDepth();
+                return parseKey();
+            case State::Key:
+                return parseKey();
+            case State::Colon:
+                if (c != ':') {
+                    fail("Expected ':' after object key");
+                }
+                ++p_;
+                state_ = State::Value;
+                return true;
+            case State::AfterValue:
+                return afterValue(c);
+            case State::Done:
+                fail("Excess characters found after JSON end");
+        }
+        return false;
+    }
+
+    bool parseValue(bool final) {
+        switch (*p_) {
+            case '{':
+                ++p_;
+                handler_->startObject();
+                stack_.push_back('{');
+                state_ = State::ObjectFirst;
+                return true;
+            case '[':
+                ++p_;
+                handler_->startArray();
+                stack_.push_back('[');
+                state_ = State::ArrayFirst;
+                return true;
+            case '"':
+                beginString(false);
+                return true;
+            case 't':
+                if (!parseLiteral("true", 4, final)) {
+                    return false;
+                }
+                handler_->value(true);
+                break;
+            case 'f':
+                if (!parseLiteral("false", 5, final)) {
+                    return false;
+                }
+                handler_->value(false);
+                break;
+            case 'n':
+                if (!parseLiteral("null", 4, final)) {
+                    return false;
+                }
+                handler_->null();
+                break;
+            default:
+                if (*p_ != '-' && !detail::isDigit(*p_)) {
+                    fail("Unexpected character");
+                }
+                if (!parseNumber(final)) {
+                    return false;
+                }
+                break;
+        }
+        endValue();
+        return true;
+    }
+
+    bool parseKey() {
+        if (*p_ != '"') {
+            fail("Expected object key");
+        }
+        beginString(true);
+        return true;
+    }
+
+    bool afterValue(char c) {
+        const char open = stack_.back();
+        if (c == ',') {
+            ++p_;
+            state_ = open == '{' ? State::Key : State::Value;
+            return true;
+        }
+        if (open == '{' && c == '}') {
+            ++p_;
+            stack_.pop_back();
+            handler_->endObject();
+            endValue();
+            return true;
+        }
+        if (open == '[' && c == ']') {
+            ++p_;
+            stack_.pop_back();
+            handler_->endArray();
+            endValue();
+            return true;
+        }
+        fail(open == '{' ? "Expected ',' or '}'" : "Expected ',' or ']'");
+    }
+
+    void endValue() {
+        state_ = stack_.empty() ? State::Done : State::AfterValue;
+    }
+
+    // Контейнер попадает в стек на '{' или '[', но, как и в JsonReader,
+    // пустой контейнер глубину не увеличивает: проверка - на первом элементе
+    void checkDepth() {
+        if (maxDepth_ != 0 && stack_.size() > maxDepth_) {
+            fail("Maximum JSON nesting depth exceeded");
+        }
+    }
+
+    bool parseLiteral(const char* literal, std::size_t length, bool final) {
+        const std::size_t available = std::min(length, static_cast<std::size_t>(end_ - p_));
+        if (std::memcmp(p_, literal, available) != 0) {
+            fail("Invalid literal");
+        }
+        if (available < length) {
+            if (final) {
+                fail("Invalid literal");
+            }
+            return false;
+        }
+        p_ += length;
+        needDelimiter_ = true;
+        return true;
+    }
+
+    static bool isNumberChar(char c) {
+        return detail::isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    }
+
+    // Число разбирается целиком из [p_, конец числа): граница куска внутри
+    // числа означает, что оно ещё не закончено
+    bool parseNumber(bool final) {
+        const char* end = p_;
+        while (end != end_ && isNumberChar(*end)) {
+            ++end;
+        }
+        if (end == end_ && !final) {
+            return false;
+        }
+
+        const char* begin = p_;
+        bool integer = true;
+        if (*p_ == '-') {
+            ++p_;
+        }
+        if (p_ == end || !detail::isDigit(*p_)) {
+            fail("Invalid number");
+        }
+        if (*p_ == '0') {
+            ++p_;
+        } else {
+            skipDigits(end);
+        }
+        if (p_ != end && *p_ == '.') {
+            integer = false;
+            ++p_;
+            if (p_ == end || !detail::isDigit(*p_)) {
+                fail("Invalid number");
+            }
+            skipDigits(end);
+        }
+        if (p_ != end && (*p_ == 'e' || *p_ == 'E')) {
+            integer = false;
+            ++p_;
+            if (p_ != end && (*p_ == '+' || *p_ == '-')) {
+                ++p_;
+            }
+            if (p_ == end || !detail::isDigit(*p_)) {
+                fail("Invalid number");
+            }
+            skipDigits(end);
+        }
+        if (p_ != end) {
+            fail("Unexpected character after value");
+        }
+        needDelimiter_ = true;
+
+        // Типы - как в JsonReader и Poco::JSON::Parser
+        if (integer) {
+            Poco::Int64 value = 0;
+            Poco::UInt64 unsignedValue = 0;
+            if (number::parseInt64(begin, end, value)) {
+                handler_->value(value);
+            } else if (number::parseUInt64(begin, end, unsignedValue)) {
+                handler_->value(unsignedValue);
+            } else {
+                handler_->value(Poco::NumberParser::parseUnsigned64(std::string(begin, end)));
+            }
+        } else {
+            double value = 0.0;
+            if (number::parseDouble(begin, end, value)) {
+                handler_->value(value);
+            } else {
+                handler_->value(Poco::NumberParser::parseFloat(std::string(begin, end)));
+            }
+        }
+        return true;
+    }
+
+    void skipDigits(const char* end) {
+        while (p_ != end && detail::isDigit(*p_)) {
+            ++p_;
+        }
+    }
+
+    void beginString(bool key) {
+        ++p_;
+        scratch_.clear();
+        inString_ = true;
+        stringIsKey_ = key;
+    }
+
+    void endString() {
+        if (stringIsKey_) {
+            handler_->key(scratch_);
+            state_ = State::Colon;
+        } else {
+            handler_->value(scratch_);
+            endValue();
+        }
+    }
+
+    // Продолжает строку в scratch_. Если данные кончились, mark_ указывает,
+    // откуда продолжить: на конец куска или на незаконченную
+    // escape-последовательность
+    bool parseString() {
+        for (;;) {
+            const char* run = kernels_->stringRun(p_, end_);
+            scratch_.append(p_, run);
+            p_ = run;
+            if (p_ == end_) {
+                mark_ = p_;
+                return false;
+            }
+            const unsigned char c = static_cast<unsigned char>(*p_);
+            if (c == '"') {
+                ++p_;
+                inString_ = false;
+                return true;
+            }
+            if (c != '\\') {
+                fail("Invalid control character in string");
+            }
+            if (!parseEscape()) {
+                mark_ = p_;
+                return false;
+            }
+        }
+    }
+
+    // Escape-последовательность с p_ ('\\'); false - она обрезана концом
+    // куска, p_ не сдвигается
+    bool parseEscape() {
+        if (end_ - p_ < 2) {
+            return false;
+        }
+        switch (p_[1]) {
+            case '"': scratch_ += '"'; break;
+            case '\\': scratch_ += '\\'; break;
+            case '/': scratch_ += '/'; break;
+            case 'b': scratch_ += '\b'; break;
+            case 'f': scratch_ += '\f'; break;
+            case 'n': scratch_ += '\n'; break;
+            case 'r': scratch_ += '\r'; break;
+            case 't': scratch_ += '\t'; break;
+            case 'u': {
+                const char* q = p_ + 2;
+                unsigned int cp = 0;
+                if (!parseHex4(q, cp)) {
+                    return false;
+                }
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    if (q == end_ || (*q == '\\' && q + 1 == end_)) {
+                        return false;
+                    }
+                    if (q[0] != '\\' || q[1] != 'u') {
+                        p_ = q;
+                        fail("Unpaired UTF-16 surrogate in string");
+                    }
+                    q += 2;
+                    unsigned int low = 0;
+                    if (!parseHex4(q, low)) {
+                        return false;
+                    }
+                    if (low < 0xDC00 || low > 0xDFFF) {
+                        p_ = q;
+                        fail("Invalid UTF-16 surrogate pair in string");
+                    }
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    p_ = q;
+                    fail("Unpaired UTF-16 surrogate in string");
+                }
+                detail::appendUtf8(scratch_, cp);
+                p_ = q;
+                return true;
+            }
+            default:
+                ++p_;
+                fail("Invalid escape sequence in string");
+        }
+        p_ += 2;
+        return true;
+    }
+
+    // Четыре шестнадцатеричные цифры с q; false - цифры обрезаны концом куска
+    bool parseHex4(const char*& q, unsigned int& value) {
+        value = 0;
+        for (int i = 0; i < 4; ++i, ++q) {
+            if (q == end_) {
+                return false;
+            }
+            const char c = *q;
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= static_cast<unsigned int>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= static_cast<unsigned int>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= static_cast<unsigned int>(c - 'A' + 10);
+            } else {
+                p_ = q;
+                fail("Invalid \\u escape in string");
+            }
+        }
+        return true;
+    }
+
+    [[noreturn]] void fail(const char* message) {
+        started_ = false;
+        std::string text(message);
+        text += " at offset ";
+        text += std::to_string(consumed_ + static_cast<std::size_t>(p_ - begin_));
+        if (p_ != end_) {
+            text += " near '";
+            text += *p_;
+            text += '\'';
+        }
+        throw Poco::JSON::JSONException(text);
+    }
+
+    Poco::JSON::Handler::Ptr handler_;
+    const scan::Kernels* kernels_ = nullptr;
+    std::size_t maxDepth_ = 0;
+
+    // Текущий разбираемый диапазон: кусок вызывающего или pending_
+    const char* begin_ = nullptr;
+    const char* p_ = nullptr;
+    const char* end_ = nullptr;       // конец целых символов UTF-8
+    const char* mark_ = nullptr;      // начало незаконченного токена
+    std::size_t consumed_ = 0;        // байт документа до begin_
+
+    // Состояние между кусками
+    bool started_ = false;
+    State state_ = State::Value;
+    std::vector<char> stack_;         // открытые контейнеры: '{' или '['
+    bool inString_ = false;
+    bool stringIsKey_ = false;
+    bool needDelimiter_ = false;
+    std::string pending_;             // незаконченный токен предыдущего куска
+    std::string scratch_;             // декодированная часть строки
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_PUSH_PARSER_H
@@ -0,0 +1,637 @@
+#ifndef POCO_TEST_APP_JSON_READER_H
+#define POCO_TEST_APP_JSON_READER_H
+
+// Разбор JSON из непрерывного буфера без копирования входа или из потока
+// блоками фиксированного размера.
+//
+// Poco::JSON::Parser принимает только std::string (или std::istream, который
+// целиком копируется в строку), поэтому документ из сетевого буфера или
+// отображённого файла приходится сначала копировать. JsonReader читает
+// диапазон (const char*, size_t) / std::string_view на месте и передаёт
+// события тому же интерфейсу Poco::JSON::Handler, что и Parser: с
+// ParseHandler результат - обычное дерево Object/Array/Dynamic::Var.
+//
+// Из std::istream или файла документ читается блоками (setChunkSize()), и
+// память читателя не зависит от размера документа: один блок, самая длинная
+// строка или число и стек открытых контейнеров. С обработчиком,
+// производным от SaxHandler, так можно обработать экспорт в несколько
+// гигабайт, не строя дерево.
+//
+// Грамматика - строгий RFC 8259 с теми же решениями, что у Parser:
+// комментарии и висячие запятые запрещены, строки должны быть корректным
+// UTF-8 без управляющих символов, целые числа передаются как Int64 (или
+// UInt64, если не помещаются), остальные - как double. Разбор итеративный,
+// с явным стеком, так что глубина вложенности не ограничена стеком вызовов.
+//
+// Перед разбором весь буфер (или очередной блок) проверяется на
+// корректность UTF-8 (json_scan.h), после чего тело строки копируется до
+// ближайшей кавычки, '\\' или управляющего символа одним векторным поиском.
+// Числа преобразуются без NumberParser и копий строки (json_number.h).
+
+#include "json_number.h"
+#include "json_profile.h"
+#include "json_scan.h"
+
+#include <Poco/JSON/Handler.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/FileStream.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Exception.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pocotest {
+
+namespace detail {
+
+inline bool isJsonWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline void appendUtf8(std::string& out, unsigned int cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Последовательность UTF-8 в p обрезана концом блока (а не ошибочна):
+// начальный байт допустим, но байтов до end не хватает
+inline bool isTruncatedUtf8(const char* p, const char* end) {
+    const unsigned char c = static_cast<unsigned char>(*p);
+    std::size_t length = 0;
+    if (c >= 0xC2 && c <= 0xDF) {
+        length = 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        length = 3;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        length = 4;
+    }
+    return length != 0 && static_cast<std::size_t>(end - p) < length;
+}
+
+} // namespace detail
+
+// Обработчик событий без построения дерева: все методы ничего не делают.
+// Для потоковой обработки достаточно переопределить нужные
+class SaxHandler : public Poco::JSON::Handler {
+public:
+    void reset() override {}
+    void startObject() override {}
+    void endObject() override {}
+    void startArray() override {}
+    void endArray() override {}
+    void key(const std::string&) override {}
+    void null() override {}
+    void value(int) override {}
+    void value(unsigned) override {}
+    void value(Poco::Int64) override {}
+    void value(Poco::UInt64) override {}
+    void value(const std::string&) override {}
+    void value(double) override {}
+    void value(bool) override {}
+
+    Poco::Dynamic::Var asVar() const override {
+        return Poco::Dynamic::Var();
+    }
+};
+
+class JsonReader {
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+    static constexpr std::size_t MIN_CHUNK_SIZE = 16;
+
+    explicit JsonReader(const Poco::JSON::Handler::Ptr& handler = new Poco::JSON::ParseHandler)
+        : handler_(handler) {
+    }
+
+    // Максимальная глубина вложенности; 0 - без ограничения
+    void setDepth(std::size_t depth) {
+        maxDepth_ = depth;
+    }
+
+    std::size_t getDepth() const {
+        return maxDepth_;
+    }
+
+    // Размер блока чтения из потока
+    void setChunkSize(std::size_t size) {
+        chunkSize_ = std::max(size, MIN_CHUNK_SIZE);
+    }
+
+    std::size_t getChunkSize() const {
+        return chunkSize_;
+    }
+
+    const Poco::JSON::Handler::Ptr& handler() const {
+        return handler_;
+    }
+
+    // Разбирает документ; вход не копируется и должен жить только на время
+    // вызова. Возвращает результат обработчика (asVar())
+    Poco::Dynamic::Var parse(const char* data, std::size_t size) {
+        POCO_TEST_APP_PROFILE_SCOPE(Parse);
+        in_ = nullptr;
+        begin_ = data;
+        p_ = data;
+        end_ = data + size;
+        consumed_ = 0;
+        kernels_ = &scan::kernels();
+
+        const char* invalid = scan::validateUtf8(*kernels_, begin_, end_);
+        if (invalid != end_) {
+            p_ = invalid;
+            fail("Invalid UTF-8 sequence");
+        }
+        return parseAll();
+    }
+
+    Poco::Dynamic::Var parse(std::string_view json) {
+        return parse(json.data(), json.size());
+    }
+
+    // Разбирает документ из потока блоками по getChunkSize() байт
+    Poco::Dynamic::Var parse(std::istream& in) {
+        POCO_TEST_APP_PROFILE_SCOPE(Parse);
+        chunk_.resize(chunkSize_);
+        in_ = &in;
+        begin_ = chunk_.data();
+        p_ = begin_;
+        end_ = begin_;
+        filled_ = begin_;
+        consumed_ = 0;
+        eof_ = false;
+        kernels_ = &scan::kernels();
+        try {
+            Poco::Dynamic::Var result = parseAll();
+            in_ = nullptr;
+            return result;
+        } catch (...) {
+            in_ = nullptr;
+            throw;
+        }
+    }
+
+    // Разбирает файл потоково; FileNotFoundException и т.п. - как у
+    // Poco::FileInputStream
+    Poco::Dynamic::Var parseFile(const std::string& path) {
+        Poco::FileInputStream in(path);
+        return parse(in);
+    }
+
+    // Число байт входа, прочитанных последним разбором
+    std::size_t bytesConsumed() const {
+        return consumed_ + static_cast<std::size_t>(p_ - begin_);
+    }
+
+    // Память, удерживаемая читателем между документами
+    std::size_t chunkCapacity() const {
+        return chunk_.capacity();
+    }
+
+    std::size_t scratchCapacity() const {
+        return scratch_.capacity();
+    }
+
+private:
+    enum class State {
+        Value,       // ожидается значение
+        Key,         // ожидается ключ объекта
+        AfterValue   // значение закончено: ожидается ',' или закрывающая скобка
+    };
+
+    Poco::Dynamic::Var parseAll() {
+        POCO_TEST_APP_PROFILE_SCOPE(Tokenize);
+        stack_.clear();
+        handler_->reset();
+
+        skipWhitespace();
+        if (!more()) {
+            fail("Empty JSON document");
+        }
+        parseDocument();
+        skipWhitespace();
+        if (more()) {
+            fail("Excess characters found after JSON end");
+        }
+        return handler_->asVar();
+    }
+
+    // Есть ли ещё хотя бы один байт; при чтении из потока подгружает блок
+    bool more() {
+        return p_ != end_ || refill();
+    }
+
+    // Читает следующий блок. Незавершённая последовательность UTF-8 в конце
+    // блока переносится в начало следующего, так что [begin_, end_) всегда
+    // состоит из целых символов
+    bool refill() {
+        if (in_ == nullptr || (eof_ && filled_ == end_)) {
+            return false;
+        }
+        const std::size_t tail = static_cast<std::size_t>(filled_ - end_);
+        consumed_ += static_cast<std::size_t>(end_ - begin_);
+        char* buffer = chunk_.data();
+        std::memmove(buffer, end_, tail);
+        std::size_t size = tail;
+        if (!eof_) {
+            in_->read(buffer + tail, static_cast<std::streamsize>(chunk_.size() - tail));
+            size += static_cast<std::size_t>(in_->gcount());
+            if (in_->bad()) {
+                throw Poco::IOException("Error reading JSON stream");
+            }
+            eof_ = !*in_;
+        }
+        begin_ = buffer;
+        p_ = buffer;
+        filled_ = buffer + size;
+        end_ = filled_;
+
+        const char* invalid = scan::validateUtf8(*kernels_, begin_, filled_);
+        if (invalid != filled_) {
+            if (eof_ || !detail::isTruncatedUtf8(invalid, filled_)) {
+                p_ = invalid;
+                fail("Invalid UTF-8 sequence");
+            }
+            end_ = invalid;
+        }
+        return p_ != end_;
+    }
+
+    void parseDocument() {
+        State state = State::Value;
+        for (;;) {
+            switch (state) {
+                case State::Value:
+                    state = parseValue();
+                    break;
+                case State::Key:
+                    parseKey();
+                    state = State::Value;
+                    break;
+                case State::AfterValue:
+                    if (stack_.empty()) {
+                        return;
+                    }
+                    state = afterValue();
+                    break;
+            }
+        }
+    }
+
+    State parseValue() {
+        skipWhitespace();
+        if (!more()) {
+            fail("Unexpected end of JSON document");
+        }
+        switch (*p_) {
+            case '{':
+                ++p_;
+                handler_->startObject();
+                skipWhitespace();
+                if (more() && *p_ == '}') {
+                    ++p_;
+                    handler_->endObject();
+                    return State::AfterValue;
+                }
+                push('{');
+                return State::Key;
+            case '[':
+                ++p_;
+                handler_->startArray();
+                skipWhitespace();
+                if (more() && *p_ == ']') {
+                    ++p_;
+                    handler_->endArray();
+                    return State::AfterValue;
+                }
+                push('[');
+                return State::Value;
+            case '"':
+                parseString();
+                handler_->value(scratch_);
+                return State::AfterValue;
+            case 't':
+                parseLiteral("true", 4);
+                handler_->value(true);
+                return State::AfterValue;
+            case 'f':
+                parseLiteral("false", 5);
+                handler_->value(false);
+                return State::AfterValue;
+            case 'n':
+                parseLiteral("null", 4);
+                handler_->null();
+                return State::AfterValue;
+            default:
+                if (*p_ == '-' || detail::isDigit(*p_)) {
+                    parseNumber();
+                    return State::AfterValue;
+                }
+                fail("Unexpected character");
+        }
+        return State::AfterValue;
+    }
+
+    void parseKey() {
+        skipWhitespace();
+        if (!more() || *p_ != '"') {
+            fail("Expected object key");
+        }
+        parseString();
+        handler_->key(scratch_);
+        skipWhitespace();
+        if (!more() || *p_ != ':') {
+            fail("Expected ':' after object key");
+        }
+        ++p_;
+    }
+
+    State afterValue() {
+        skipWhitespace();
+        if (!more()) {
+            fail("Unexpected end of JSON document");
+        }
+        const char open = stack_.back();
+        const char c = *p_++;
+        if (c == ',') {
+            return open == '{' ? State::Key : State::Value;
+        }
+        if (open == '{' && c == '}') {
+            stack_.pop_back();
+            handler_->endObject();
+            return State::AfterValue;
+        }
+        if (open == '[' && c == ']') {
+            stack_.pop_back();
+            handler_->endArray();
+            return State::AfterValue;
+        }
+        --p_;
+        fail(open == '{' ? "Expected ',' or '}'" : "Expected ',' or ']'");
+        return State::AfterValue;
+    }
+
+    void push(char open) {
+        if (maxDepth_ != 0 && stack_.size() >= maxDepth_) {
+            fail("Maximum JSON nesting depth exceeded");
+        }
+        stack_.push_back(open);
+    }
+
+    // Компактный JSON почти не содержит пробелов: векторный поиск
+    // запускается, только если пробел действительно есть
+    void skipWhitespace() {
+        while (more() && detail::isJsonWhitespace(*p_)) {
+            p_ = kernels_->skipWhitespace(p_ + 1, end_);
+        }
+    }
+
+    void parseLiteral(const char* literal, std::size_t length) {
+        for (std::size_t i = 0; i < length; ++i) {
+            if (!more() || *p_ != literal[i]) {
+                fail("Invalid literal");
+            }
+            ++p_;
+        }
+        checkDelimiter();
+    }
+
+    // После скаляра верхнего уровня или элемента контейнера должен идти
+    // разделитель: иначе "123abc" или "truex" были бы приняты по частям
+    void checkDelimiter() {
+        if (more()) {
+            const char c = *p_;
+            if (!detail::isJsonWhitespace(c) && c != ',' && c != ']' && c != '}') {
+                fail("Unexpected character after value");
+            }
+        }
+    }
+
+    // Читает строку, начинающуюся с '"', в scratch_ (ёмкость сохраняется
+    // между вызовами). UTF-8 уже проверен при загрузке буфера
+    void parseString() {
+        ++p_;
+        scratch_.clear();
+        for (;;) {
+            const char* run = kernels_->stringRun(p_, end_);
+            scratch_.append(p_, run);
+            p_ = run;
+            if (p_ == end_) {
+                if (!refill()) {
+                    fail("Unterminated string");
+                }
+                continue;
+            }
+            const unsigned char c = static_cast<unsigned char>(*p_);
+            if (c == '"') {
+                ++p_;
+                return;
+            }
+            if (c == '\\') {
+                parseEscape();
+            } else {
+                fail("Invalid control character in string");
+            }
+        }
+    }
+
+    void parseEscape() {
+        ++p_;
+        if (!more()) {
+            fail("Unterminated string");
+        }
+        const char c = *p_++;
+        switch (c) {
+            case '"': scratch_ += '"'; break;
+            case '\\': scratch_ += '\\'; break;
+            case '/': scratch_ += '/'; break;
+            case 'b': scratch_ += '\b'; break;
+            case 'f': scratch_ += '\f'; break;
+            case 'n': scratch_ += '\n'; break;
+            case 'r': scratch_ += '\r'; break;
+            case 't': scratch_ += '\t'; break;
+            case 'u': {
+                unsigned int cp = parseHex4();
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    if (!more() || *p_ != '\\') {
+                        fail("Unpaired UTF-16 surrogate in string");
+                    }
+                    ++p_;
+                    if (!more() || *p_ != 'u') {
+                        fail("Unpaired UTF-16 surrogate in string");
+                    }
+                    ++p_;
+                    const unsigned int low = parseHex4();
+                    if (low < 0xDC00 || low > 0xDFFF) {
+                        fail("Invalid UTF-16 surrogate pair in string");
+                    }
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    fail("Unpaired UTF-16 surrogate in string");
+                }
+                detail::appendUtf8(scratch_, cp);
+                break;
+            }
+            default:
+                --p_;
+                fail("Invalid escape sequence in string");
+        }
+    }
+
+    unsigned int parseHex4() {
+        unsigned int value = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (!more()) {
+                fail("Invalid \\u escape in string");
+            }
+            const char c = *p_;
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= static_cast<unsigned int>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= static_cast<unsigned int>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= static_cast<unsigned int>(c - 'A' + 10);
+            } else {
+                fail("Invalid \\u escape in string");
+            }
+            ++p_;
+        }
+        return value;
+    }
+
+    // Дописывает в scratch_ цифры, начиная с p_, в том числе через границу
+    // блока
+    void takeDigits() {
+        for (;;) {
+            const char* start = p_;
+            while (p_ != end_ && detail::isDigit(*p_)) {
+                ++p_;
+            }
+            scratch_.append(start, p_);
+            if (p_ != end_ || !refill()) {
+                return;
+            }
+        }
+    }
+
+    void parseNumber() {
+        scratch_.clear();
+        bool integer = true;
+        if (*p_ == '-') {
+            scratch_ += *p_++;
+        }
+        if (!more() || !detail::isDigit(*p_)) {
+            fail("Invalid number");
+        }
+        if (*p_ == '0') {
+            scratch_ += *p_++;
+        } else {
+            takeDigits();
+        }
+        if (more() && *p_ == '.') {
+            integer = false;
+            scratch_ += *p_++;
+            if (!more() || !detail::isDigit(*p_)) {
+                fail("Invalid number");
+            }
+            takeDigits();
+        }
+        if (more() && (*p_ == 'e' || *p_ == 'E')) {
+            integer = false;
+            scratch_ += *p_++;
+            if (more() && (*p_ == '+' || *p_ == '-')) {
+                scratch_ += *p_++;
+            }
+            if (!more() || !detail::isDigit(*p_)) {
+                fail("Invalid number");
+            }
+            takeDigits();
+        }
+        checkDelimiter();
+
+        // Типы - как в Poco::JSON::Parser; переполнение и значения вне
+        // диапазона double уходят в NumberParser, чтобы исключения и
+        // результат на краях были те же
+        const char* begin = scratch_.data();
+        const char* end = begin + scratch_.size();
+        if (integer) {
+            Poco::Int64 value = 0;
+            Poco::UInt64 unsignedValue = 0;
+            if (number::parseInt64(begin, end, value)) {
+                handler_->value(value);
+            } else if (number::parseUInt64(begin, end, unsignedValue)) {
+                handler_->value(unsignedValue);
+            } else {
+                handler_->value(Poco::NumberParser::parseUnsigned64(scratch_));
+            }
+        } else {
+            double value = 0.0;
+            if (number::parseDouble(begin, end, value)) {
+                handler_->value(value);
+            } else {
+                handler_->value(Poco::NumberParser::parseFloat(scratch_));
+            }
+        }
+    }
+
+    [[noreturn]] void fail(const char* message) const {
+        std::string text(message);
+        text += " at offset ";
+        text += std::to_string(consumed_ + static_cast<std::size_t>(p_ - begin_));
+        if (p_ != end_) {
+            text += " near '";
+            text += *p_;
+            text += '\'';
+        }
+        throw Poco::JSON::JSONException(text);
+    }
+
+    Poco::JSON::Handler::Ptr handler_;
+    const scan::Kernels* kernels_ = nullptr;
+    std::size_t maxDepth_ = 0;
+    std::size_t chunkSize_ = DEFAULT_CHUNK_SIZE;
+
+    // Текущий буфер: весь документ или очередной блок потока
+    const char* begin_ = nullptr;
+    const char* p_ = nullptr;
+    const char* end_ = nullptr;       // конец целых символов UTF-8
+    std::size_t consumed_ = 0;        // байт входа до begin_
+
+    // Чтение из потока
+    std::istream* in_ = nullptr;
+    std::vector<char> chunk_;
+    const char* filled_ = nullptr;    // конец прочитанных байтов блока
+    bool eof_ = false;
+
+    std::vector<char> stack_;         // открытые контейнеры: '{' или '['
+    std::string scratch_;             // декодированная строка или текст числа
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_READER_H
@@ -0,0 +1,496 @@
+#ifndef POCO_TEST_APP_JSON_SCAN_H
+#define POCO_TEST_APP_JSON_SCAN_H
+
+// Векторные примитивы сканирования JSON для JsonReader и JsonWriter.
+//
+// Побайтный разбор тратит большую часть времени на длинные участки, где
+// ничего не происходит: тело строки до кавычки, отступы, ASCII-текст при
+// проверке UTF-8, текст без символов, требующих экранирования, при записи,
+// промежутки между кавычками и скобками при пропуске значений (JsonProjection).
+// Здесь эти поиски выполняются блоками по 16 (SSE4.2) или 32 (AVX2) байта.
+// Реализация выбирается один раз по cpuid; скалярная версия - эталон и
+// запасной вариант для остальных платформ. Результат любой реализации обязан
+// совпадать со скалярной, для тестов и бенчмарков уровень можно понизить
+// через setLevel().
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define POCO_TEST_APP_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace pocotest {
+namespace scan {
+
+enum class Level {
+    Scalar = 0,
+    SSE42 = 1,
+    AVX2 = 2
+};
+
+inline const char* levelName(Level level) {
+    switch (level) {
+        case Level::SSE42: return "sse4.2";
+        case Level::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+// Набор реализаций одного уровня. Все функции работают с [p, end) и не
+// читают за end
+struct Kernels {
+    Level level;
+    // Первый байт, завершающий участок строки: '"', '\\' или < 0x20
+    const char* (*stringRun)(const char* p, const char* end);
+    // Первый байт, не являющийся пробельным символом JSON
+    const char* (*skipWhitespace)(const char* p, const char* end);
+    // Первый байт >= 0x80
+    const char* (*asciiRun)(const char* p, const char* end);
+    // Первый байт, который Poco::toJSON экранирует: '"', '\\', '/' или < 0x20
+    const char* (*escapeRun)(const char* p, const char* end);
+    // То же, что escapeRun, плюс байты >= 0x7F (режим JSON_ESCAPE_UNICODE)
+    const char* (*escapeUnicodeRun)(const char* p, const char* end);
+    // Первая кавычка или скобка: '"', '{', '}', '[' или ']'
+    const char* (*structuralRun)(const char* p, const char* end);
+};
+
+namespace detail {
+
+inline bool isStringSpecial(unsigned char c) {
+    return c == '"' || c == '\\' || c < 0x20;
+}
+
+inline bool isEscaped(unsigned char c) {
+    return c == '"' || c == '\\' || c == '/' || c < 0x20;
+}
+
+inline bool isEscapedUnicode(unsigned char c) {
+    return isEscaped(c) || c >= 0x7F;
+}
+
+inline bool isStructural(unsigned char c) {
+    return c == '"' || c == '{' || c == '}' || c == '[' || c == ']';
+}
+
+inline bool isWhitespace(unsigned char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline const char* stringRunScalar(const char* p, const char* end) {
+    while (p != end && !isStringSpecial(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* escapeRunScalar(const char* p, const char* end) {
+    while (p != end && !isEscaped(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* escapeUnicodeRunScalar(const char* p, const char* end) {
+    while (p != end && !isEscapedUnicode(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* structuralRunScalar(const char* p, const char* end) {
+    while (p != end && !isStructural(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* skipWhitespaceScalar(const char* p, const char* end) {
+    while (p != end && isWhitespace(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* asciiRunScalar(const char* p, const char* end) {
+    while (p != end && static_cast<unsigned char>(*p) < 0x80) {
+        ++p;
+    }
+    return p;
+}
+
+#ifdef POCO_TEST_APP_SCAN_X86
+
+// SSE4.2: поиск по диапазонам и наборам символов инструкцией pcmpestri
+__attribute__((target("sse4.2")))
+inline const char* stringRunSSE42(const char* p, const char* end) {
+    // Пары границ: [0x00, 0x1F], ['"', '"'], ['\\', '\\']
+    const __m128i ranges = _mm_setr_epi8(0x00, 0x1F, '"', '"', '\\', '\\', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int index = _mm_cmpestri(ranges, 6, block, 16,
+                                       _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+        if (index < 16) {
+            return p + index;
+        }
+        p += 16;
+    }
+    return stringRunScalar(p, end);
+}
+
+__attribute__((target("sse4.2")))
+inline const char* escapeRunSSE42(const char* p, const char* end) {
+    const __m128i ranges = _mm_setr_epi8(0x00, 0x1F, '"', '"', '\\', '\\', '/', '/', 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int index = _mm_cmpestri(ranges, 8, block, 16,
+                                       _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+        if (index < 16) {
+            return p + index;
+        }
+        p += 16;
+    }
+    return escapeRunScalar(p, end);
+}
+
+__attribute__((target("sse4.2")))
+inline const char* escapeUnicodeRunSSE42(const char* p, const char* end) {
+    const __m128i ranges = _mm_setr_epi8(0x00, 0x1F, '"', '"', '\\', '\\', '/', '/',
+                                         0x7F, static_cast<char>(0xFF), 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int index = _mm_cmpestri(ranges, 10, block, 16,
+                                       _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+        if (index < 16) {
+            return p + index;
+        }
+        p += 16;
+    }
+    return escapeUnicodeRunScalar(p, end);
+}
+
+__attribute__((target("sse4.2")))
+inline const char* structuralRunSSE42(const char* p, const char* end) {
+    const __m128i set = _mm_setr_epi8('"', '{', '}', '[', ']', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int index = _mm_cmpestri(set, 5, block, 16,
+                                       _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+        if (index < 16) {
+            return p + index;
+        }
+        p += 16;
+    }
+    return structuralRunScalar(p, end);
+}
+
+__attribute__((target("sse4.2")))
+inline const char* skipWhitespaceSSE42(const char* p, const char* end) {
+    const __m128i set = _mm_setr_epi8(' ', '\t', '\n', '\r', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int index = _mm_cmpestri(set, 4, block, 16,
+                                       _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY |
+                                       _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT);
+        if (index < 16) {
+            return p + index;
+        }
+        p += 16;
+    }
+    return skipWhitespaceScalar(p, end);
+}
+
+__attribute__((target("sse4.2")))
+inline const char* asciiRunSSE42(const char* p, const char* end) {
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int mask = _mm_movemask_epi8(block);
+        if (mask != 0) {
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        p += 16;
+    }
+    return asciiRunScalar(p, end);
+}
+
+// AVX2: сравнения по 32 байта и битовая маска совпадений
+__attribute__((target("avx2")))
+inline const char* stringRunAVX2(const char* p, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        // c <= 0x1F без знака <=> max(c, 0x1F) == 0x1F
+        const __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(block, control), control));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return stringRunScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+inline const char* escapeRunAVX2(const char* p, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, slash),
+                            _mm256_cmpeq_epi8(_mm256_max_epu8(block, control), control)));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return escapeRunScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+inline const char* escapeUnicodeRunAVX2(const char* p, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    const __m256i del = _mm256_set1_epi8(0x7F);
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        // c >= 0x7F без знака <=> max(c, 0x7F) == c
+        const __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)),
+            _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, slash),
+                                _mm256_cmpeq_epi8(_mm256_max_epu8(block, control), control)),
+                _mm256_cmpeq_epi8(_mm256_max_epu8(block, del), block)));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return escapeUnicodeRunScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+inline const char* structuralRunAVX2(const char* p, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i openBrace = _mm256_set1_epi8('{');
+    const __m256i closeBrace = _mm256_set1_epi8('}');
+    const __m256i openBracket = _mm256_set1_epi8('[');
+    const __m256i closeBracket = _mm256_set1_epi8(']');
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i structural = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, openBrace)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, closeBrace),
+                            _mm256_or_si256(_mm256_cmpeq_epi8(block, openBracket),
+                                            _mm256_cmpeq_epi8(block, closeBracket))));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(structural));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return structuralRunScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+inline const char* skipWhitespaceAVX2(const char* p, const char* end) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i ret = _mm256_set1_epi8('\r');
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i whitespace = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, newline), _mm256_cmpeq_epi8(block, ret)));
+        const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(whitespace));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return skipWhitespaceScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+inline const char* asciiRunAVX2(const char* p, const char* end) {
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(block));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return asciiRunScalar(p, end);
+}
+
+#endif // POCO_TEST_APP_SCAN_X86
+
+inline std::atomic<const Kernels*>& activeKernels();
+
+} // namespace detail
+
+// Наивысший уровень, поддерживаемый процессором
+inline Level supportedLevel() {
+#ifdef POCO_TEST_APP_SCAN_X86
+    static const Level level = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Level::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return Level::SSE42;
+        }
+        return Level::Scalar;
+    }();
+    return level;
+#else
+    return Level::Scalar;
+#endif
+}
+
+// Реализации заданного уровня; уровень выше поддерживаемого понижается
+inline const Kernels& kernels(Level level) {
+    static const Kernels scalar = {
+        Level::Scalar, detail::stringRunScalar, detail::skipWhitespaceScalar, detail::asciiRunScalar,
+        detail::escapeRunScalar, detail::escapeUnicodeRunScalar, detail::structuralRunScalar
+    };
+#ifdef POCO_TEST_APP_SCAN_X86
+    static const Kernels sse42 = {
+        Level::SSE42, detail::stringRunSSE42, detail::skipWhitespaceSSE42, detail::asciiRunSSE42,
+        detail::escapeRunSSE42, detail::escapeUnicodeRunSSE42, detail::structuralRunSSE42
+    };
+    static const Kernels avx2 = {
+        Level::AVX2, detail::stringRunAVX2, detail::skipWhitespaceAVX2, detail::asciiRunAVX2,
+        detail::escapeRunAVX2, detail::escapeUnicodeRunAVX2, detail::structuralRunAVX2
+    };
+    if (level > supportedLevel()) {
+        level = supportedLevel();
+    }
+    if (level == Level::AVX2) {
+        return avx2;
+    }
+    if (level == Level::SSE42) {
+        return sse42;
+    }
+#else
+    (void)level;
+#endif
+    return scalar;
+}
+
+// Текущие реализации (по умолчанию - наилучшие доступные)
+inline const Kernels& kernels() {
+    return *detail::activeKernels().load(std::memory_order_relaxed);
+}
+
+inline Level activeLevel() {
+    return kernels().level;
+}
+
+// Принудительно задаёт уровень для всех последующих разборов; возвращает
+// фактически выбранный (не выше supportedLevel())
+inline Level setLevel(Level level) {
+    const Kernels& selected = kernels(level);
+    detail::activeKernels().store(&selected, std::memory_order_relaxed);
+    return selected.level;
+}
+
+// Длина корректной последовательности UTF-8, начинающейся в p, или 0.
+// Отвергаются избыточные (overlong) формы, суррогаты и кодовые точки
+// больше U+10FFFF
+inline std::size_t utf8SequenceLength(const char* p, const char* end) {
+    const unsigned char c = static_cast<unsigned char>(*p);
+    if (c < 0x80) {
+        return 1;
+    }
+    std::size_t length = 0;
+    unsigned char lower = 0x80;
+    unsigned char upper = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) {
+        length = 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        length = 3;
+        if (c == 0xE0) {
+            lower = 0xA0;
+        } else if (c == 0xED) {
+            upper = 0x9F;
+        }
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        length = 4;
+        if (c == 0xF0) {
+            lower = 0x90;
+        } else if (c == 0xF4) {
+            upper = 0x8F;
+        }
+    } else {
+        return 0;
+    }
+    if (static_cast<std::size_t>(end - p) < length) {
+        return 0;
+    }
+    const unsigned char second = static_cast<unsigned char>(p[1]);
+    if (second < lower || second > upper) {
+        return 0;
+    }
+    for (std::size_t i = 2; i < length; ++i) {
+        const unsigned char next = static_cast<unsigned char>(p[i]);
+        if (next < 0x80 || next > 0xBF) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+// Проверка UTF-8 всего буфера: ASCII пропускается блоками, многобайтовые
+// последовательности проверяются по одной. Возвращает адрес первого
+// некорректного байта или end
+inline const char* validateUtf8(const Kernels& k, const char* p, const char* end) {
+    for (;;) {
+        p = k.asciiRun(p, end);
+        if (p == end) {
+            return end;
+        }
+        // Не-ASCII текст обычно идёт подряд: не возвращаемся в векторный
+        // цикл ради каждого символа
+        do {
+            const std::size_t length = utf8SequenceLength(p, end);
+            if (length == 0) {
+                return p;
+            }
+            p += length;
+        } while (p != end && static_cast<unsigned char>(*p) >= 0x80);
+    }
+}
+
+inline const char* validateUtf8(const char* p, const char* end) {
+    return validateUtf8(kernels(), p, end);
+}
+
+namespace detail {
+
+inline std::atomic<const Kernels*>& activeKernels() {
+    static std::atomic<const Kernels*> active(&kernels(supportedLevel()));
+    return active;
+}
+
+} // namespace detail
+
+} // namespace scan
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_SCAN_H
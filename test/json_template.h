@@ -0,0 +1,573 @@
+#ifndef POCO_TEST_APP_JSON_TEMPLATE_H
+#define POCO_TEST_APP_JSON_TEMPLATE_H
+
+// Шаблоны Poco::JSON::Template, скомпилированные в список инструкций.
+//
+// Template::parse строит дерево частей, но каждый render() заново разбирает
+// пути запросов (Query::find на каждое <? echo ?>, <? if ?> и <? for ?>),
+// пишет только в std::ostream, а цикл <? for ?> записывает переменную цикла
+// прямо в объект данных и потом удаляет её. CompiledTemplate принимает тот же
+// синтаксис (echo/=, if/ifexist/elsif/elif/else/endif, for/endfor, include)
+// и компилирует его один раз в плоский список инструкций с переходами:
+//   - пути запросов компилируются в QueryPlan (query_plan.h);
+//   - переменная цикла разрешается при компиляции: путь, начинающийся с её
+//     имени, вычисляется от текущего элемента массива, данные не меняются,
+//     так что один шаблон можно рисовать из нескольких потоков;
+//   - include подставляется при компиляции; файлы шаблона и всех включений
+//     запоминаются с временем изменения и размером.
+// render() дописывает результат в переданный std::string, ёмкость которого
+// сохраняется между вызовами.
+//
+// Вывод совпадает с Template::render: значения echo пишутся как
+// Var::convert<std::string>(), условия вычисляются как в Poco (пустая строка,
+// пустые Object/Array и отсутствующее значение - ложь), перевод строки после
+// команд, кроме echo, съедается. В отличие от Poco, незакрытые if/for
+// считаются ошибкой, а ошибки include обнаруживаются при компиляции.
+//
+// CompiledTemplateCache хранит шаблоны по пути и перекомпилирует шаблон,
+// если изменился любой из его файлов.
+
+#include "query_plan.h"
+
+#include <Poco/JSON/Template.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/FileStream.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/Timestamp.h>
+#include <Poco/Ascii.h>
+#include <Poco/Mutex.h>
+#include <Poco/Exception.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pocotest {
+
+class CompiledTemplate {
+public:
+    using Ptr = std::shared_ptr<const CompiledTemplate>;
+
+    // Шаблон из текста; относительные пути include разрешаются от baseDir,
+    // а если файла там нет - от текущего каталога
+    explicit CompiledTemplate(const std::string& source, const std::string& baseDir = std::string()) {
+        std::vector<std::string> loopNames;
+        compile(source, baseDir, loopNames, 0);
+    }
+
+    // Шаблон из файла; файл запоминается для проверки isStale()
+    static Ptr fromFile(const std::string& path) {
+        std::shared_ptr<CompiledTemplate> result(new CompiledTemplate());
+        std::vector<std::string> loopNames;
+        result->compileFile(path, loopNames, 0);
+        return result;
+    }
+
+    // Дописывает результат в конец out
+    void render(const Poco::Dynamic::Var& data, std::string& out) const {
+        std::vector<LoopFrame> loops;
+        std::size_t pc = 0;
+        while (pc < code_.size()) {
+            const Instruction& instruction = code_[pc];
+            switch (instruction.op) {
+                case Op::Text:
+                    out += instruction.text;
+                    ++pc;
+                    break;
+                case Op::Echo:
+                    append(resolve(instruction, data, loops), out);
+                    ++pc;
+                    break;
+                case Op::Branch:
+                    pc = isTrue(instruction, resolve(instruction, data, loops)) ? pc + 1 : instruction.target;
+                    break;
+                case Op::Jump:
+                    pc = instruction.target;
+                    break;
+                case Op::LoopBegin: {
+                    LoopFrame frame;
+                    frame.array = arrayOf(resolve(instruction, data, loops));
+                    if (frame.array.isNull() || frame.array->size() == 0) {
+                        pc = instruction.target;
+                        break;
+                    }
+                    const Poco::JSON::Array& array = *frame.array;
+                    frame.current = array.begin();
+                    frame.end = array.end();
+                    loops.push_back(std::move(frame));
+                    ++pc;
+                    break;
+                }
+                case Op::LoopEnd: {
+                    LoopFrame& frame = loops.back();
+                    if (++frame.current != frame.end) {
+                        pc = instruction.target;
+                    } else {
+                        loops.pop_back();
+                        ++pc;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    std::string render(const Poco::Dynamic::Var& data) const {
+        std::string out;
+        render(data, out);
+        return out;
+    }
+
+    // Число инструкций; для тестов и отладки
+    std::size_t size() const {
+        return code_.size();
+    }
+
+    // Файлы шаблона и включений, как они были найдены при компиляции
+    std::vector<std::string> files() const {
+        std::vector<std::string> result;
+        for (const auto& file : files_) {
+            result.push_back(file.path);
+        }
+        return result;
+    }
+
+    // true, если любой из files() изменился или удалён после компиляции
+    bool isStale() const {
+        for (const auto& file : files_) {
+            Poco::File current(file.path);
+            if (!current.exists() || current.getLastModified() != file.modified ||
+                current.getSize() != file.size) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+    static constexpr std::size_t MAX_INCLUDE_DEPTH = 32;
+
+    enum class Op { Text, Echo, Branch, Jump, LoopBegin, LoopEnd };
+
+    // Branch: при ложном условии переход на target. LoopBegin: при пустом
+    // массиве - на target за LoopEnd. LoopEnd: к первой инструкции тела.
+    // Запрос: plan от данных (scope == NONE) или от текущего элемента
+    // цикла номер scope
+    struct Instruction {
+        Op op;
+        std::string text;
+        std::size_t plan = NONE;
+        std::size_t scope = NONE;
+        bool exist = false;
+        std::size_t target = NONE;
+    };
+
+    struct LoopFrame {
+        Poco::JSON::Array::Ptr array;
+        Poco::JSON::Array::ConstIterator current;
+        Poco::JSON::Array::ConstIterator end;
+    };
+
+    // Открытый блок: ветки if ждут адреса конца, цикл - своего LoopEnd
+    struct Block {
+        bool loop = false;
+        std::size_t start = NONE;           // LoopBegin
+        std::size_t branch = NONE;          // Branch последней ветки if
+        std::vector<std::size_t> jumps;     // переходы в конец if
+    };
+
+    struct FileStamp {
+        std::string path;
+        Poco::Timestamp modified;
+        Poco::File::FileSize size;
+    };
+
+    CompiledTemplate() = default;
+
+    // Разбор повторяет Template::parse: текст до "<?", слово команды ("="
+    // - это echo), аргументы через пробелы, "?>"
+    class Reader {
+    public:
+        explicit Reader(const std::string& source)
+            : source_(source) {
+        }
+
+        bool good() const {
+            return pos_ < source_.size();
+        }
+
+        int get() {
+            return pos_ < source_.size() ? static_cast<unsigned char>(source_[pos_++]) : -1;
+        }
+
+        int peek() const {
+            return pos_ < source_.size() ? static_cast<unsigned char>(source_[pos_]) : -1;
+        }
+
+        void unget() {
+            --pos_;
+        }
+
+        std::string readText() {
+            const std::size_t start = pos_;
+            const std::size_t open = source_.find("<?", pos_);
+            if (open == std::string::npos) {
+                pos_ = source_.size();
+                return source_.substr(start);
+            }
+            pos_ = open + 2;
+            return source_.substr(start, open - start);
+        }
+
+        std::string readCommand() {
+            std::string command;
+            readWhiteSpace();
+            int c = get();
+            while (c != -1) {
+                if (Poco::Ascii::isSpace(c)) {
+                    break;
+                }
+                if (c == '?' && peek() == '>') {
+                    unget();
+                    break;
+                }
+                if (c == '=' && command.empty()) {
+                    command = "echo";
+                    break;
+                }
+                command += static_cast<char>(c);
+                c = get();
+            }
+            return command;
+        }
+
+        std::string readQuery() {
+            std::string query;
+            int c;
+            while ((c = get()) != -1) {
+                if (c == '?' && peek() == '>') {
+                    unget();
+                    break;
+                }
+                if (Poco::Ascii::isSpace(c)) {
+                    break;
+                }
+                query += static_cast<char>(c);
+            }
+            return query;
+        }
+
+        std::string readWord() {
+            std::string word;
+            int c;
+            while ((c = peek()) != -1 && !Poco::Ascii::isSpace(c)) {
+                word += static_cast<char>(get());
+            }
+            return word;
+        }
+
+        std::string readString() {
+            std::string str;
+            int c = get();
+            if (c == '"') {
+                while ((c = get()) != -1 && c != '"') {
+                    str += static_cast<char>(c);
+                }
+            }
+            return str;
+        }
+
+        void readWhiteSpace() {
+            while (peek() != -1 && Poco::Ascii::isSpace(peek())) {
+                get();
+            }
+        }
+
+    private:
+        const std::string& source_;
+        std::size_t pos_ = 0;
+    };
+
+    void compileFile(const std::string& path, std::vector<std::string>& loopNames, std::size_t depth) {
+        Poco::File file(path);
+        if (!file.exists()) {
+            throw Poco::FileNotFoundException(path);
+        }
+        files_.push_back(FileStamp{path, file.getLastModified(), file.getSize()});
+        std::string source;
+        Poco::FileInputStream in(path);
+        Poco::StreamCopier::copyToString(in, source);
+        Poco::Path parent(path);
+        parent.makeParent();
+        compile(source, parent.toString(), loopNames, depth);
+    }
+
+    void compile(const std::string& source, const std::string& baseDir,
+                 std::vector<std::string>& loopNames, std::size_t depth) {
+        if (depth > MAX_INCLUDE_DEPTH) {
+            throw Poco::JSON::JSONTemplateException("Too deeply nested <? include ?>");
+        }
+        const std::size_t outerLoops = loopNames.size();
+        std::vector<Block> blocks;
+        Reader in(source);
+        while (in.good()) {
+            const std::string text = in.readText();
+            if (!text.empty()) {
+                addText(text);
+            }
+            const std::string command = in.readCommand();
+            if (command.empty()) {
+                break;
+            }
+            in.readWhiteSpace();
+
+            if (command == "echo") {
+                const std::string query = in.readQuery();
+                if (query.empty()) {
+                    throw Poco::JSON::JSONTemplateException("Missing query in <? echo ?>");
+                }
+                emit(Op::Echo, query, loopNames);
+            } else if (command == "for") {
+                const std::string name = in.readWord();
+                if (name.empty()) {
+                    throw Poco::JSON::JSONTemplateException("Missing variable in <? for ?> command");
+                }
+                in.readWhiteSpace();
+                const std::string query = in.readQuery();
+                if (query.empty()) {
+                    throw Poco::JSON::JSONTemplateException("Missing query in <? for ?> command");
+                }
+                Block block;
+                block.loop = true;
+                block.start = emit(Op::LoopBegin, query, loopNames);
+                blocks.push_back(std::move(block));
+                loopNames.push_back(name);
+            } else if (command == "endfor") {
+                if (blocks.empty() || !blocks.back().loop) {
+                    throw Poco::JSON::JSONTemplateException("Unexpected <? endfor ?> found");
+                }
+                const std::size_t start = blocks.back().start;
+                Instruction end{Op::LoopEnd};
+                end.target = start + 1;
+                code_.push_back(std::move(end));
+                code_[start].target = code_.size();
+                blocks.pop_back();
+                loopNames.pop_back();
+            } else if (command == "if" || command == "ifexist") {
+                const std::string query = in.readQuery();
+                if (query.empty()) {
+                    throw Poco::JSON::JSONTemplateException("Missing query in <? " + command + " ?>");
+                }
+                Block block;
+                block.branch = emit(Op::Branch, query, loopNames);
+                code_[block.branch].exist = command == "ifexist";
+                blocks.push_back(std::move(block));
+            } else if (command == "elsif" || command == "elif" || command == "else") {
+                std::string query;
+                if (command != "else") {
+                    query = in.readQuery();
+                    if (query.empty()) {
+                        throw Poco::JSON::JSONTemplateException("Missing query in <? " + command + " ?>");
+                    }
+                }
+                if (blocks.empty() || blocks.back().loop) {
+                    throw Poco::JSON::JSONTemplateException("Unexpected <? " + command + " ?> found");
+                }
+                Block& block = blocks.back();
+                block.jumps.push_back(code_.size());
+                code_.push_back(Instruction{Op::Jump});
+                patch(block.branch);
+                block.branch = command == "else" ? NONE : emit(Op::Branch, query, loopNames);
+            } else if (command == "endif") {
+                if (blocks.empty() || blocks.back().loop) {
+                    throw Poco::JSON::JSONTemplateException("Unexpected <? endif ?> found");
+                }
+                patch(blocks.back().branch);
+                for (std::size_t jump : blocks.back().jumps) {
+                    patch(jump);
+                }
+                blocks.pop_back();
+            } else if (command == "include") {
+                in.readWhiteSpace();
+                const std::string filename = in.readString();
+                if (filename.empty()) {
+                    throw Poco::JSON::JSONTemplateException("Missing filename in <? include ?>");
+                }
+                compileFile(resolveInclude(baseDir, filename), loopNames, depth + 1);
+            } else {
+                throw Poco::JSON::JSONTemplateException("Unknown command " + command);
+            }
+
+            in.readWhiteSpace();
+            if (in.get() != '?' || in.get() != '>') {
+                throw Poco::JSON::JSONTemplateException("Missing ?>");
+            }
+            if (command != "echo") {
+                if (in.peek() == '\r') {
+                    in.get();
+                }
+                if (in.peek() == '\n') {
+                    in.get();
+                }
+            }
+        }
+        if (!blocks.empty()) {
+            throw Poco::JSON::JSONTemplateException(blocks.back().loop ? "Missing <? endfor ?>" : "Missing <? endif ?>");
+        }
+        loopNames.resize(outerLoops);
+    }
+
+    // Как IncludePart: относительный путь - от каталога шаблона, если там
+    // есть такой файл
+    static std::string resolveInclude(const std::string& baseDir, const std::string& filename) {
+        Poco::Path path(filename);
+        if (path.isRelative() && !baseDir.empty()) {
+            Poco::Path candidate(Poco::Path(baseDir).makeDirectory(), path);
+            if (Poco::File(candidate).exists()) {
+                return candidate.toString();
+            }
+        }
+        return path.toString();
+    }
+
+    void addText(const std::string& text) {
+        if (!code_.empty() && code_.back().op == Op::Text && !isTarget(code_.size())) {
+            code_.back().text += text;
+            return;
+        }
+        Instruction instruction{Op::Text};
+        instruction.text = text;
+        code_.push_back(std::move(instruction));
+    }
+
+    // Текст можно склеить с предыдущим, только если на текущий адрес не
+    // ведёт ни один переход
+    bool isTarget(std::size_t address) const {
+        for (const Instruction& instruction : code_) {
+            if (instruction.target == address) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Инструкция с запросом; путь, начинающийся с имени переменной
+    // цикла, считается от её текущего элемента
+    std::size_t emit(Op op, const std::string& query, const std::vector<std::string>& loopNames) {
+        Instruction instruction{op};
+        std::string path = query;
+        const std::size_t stop = query.find_first_of(".[");
+        const std::string head = query.substr(0, stop);
+        for (std::size_t i = loopNames.size(); i-- > 0;) {
+            if (loopNames[i] == head) {
+                instruction.scope = i;
+                path = stop == std::string::npos ? std::string() : query.substr(query[stop] == '.' ? stop + 1 : stop);
+                break;
+            }
+        }
+        instruction.plan = plans_.size();
+        plans_.emplace_back(path);
+        code_.push_back(std::move(instruction));
+        return code_.size() - 1;
+    }
+
+    void patch(std::size_t address) {
+        if (address != NONE) {
+            code_[address].target = code_.size();
+        }
+    }
+
+    Poco::Dynamic::Var resolve(const Instruction& instruction, const Poco::Dynamic::Var& data,
+                               const std::vector<LoopFrame>& loops) const {
+        const QueryPlan& plan = plans_[instruction.plan];
+        return instruction.scope == NONE ? plan.find(data) : plan.find(*loops[instruction.scope].current);
+    }
+
+    static Poco::JSON::Array::Ptr arrayOf(const Poco::Dynamic::Var& value) {
+        if (value.type() == typeid(Poco::JSON::Array::Ptr)) {
+            return value.extract<Poco::JSON::Array::Ptr>();
+        } else if (value.type() == typeid(Poco::JSON::Array)) {
+            return new Poco::JSON::Array(value.extract<Poco::JSON::Array>());
+        }
+        return nullptr;
+    }
+
+    // Как LogicQuery/LogicExistQuery в Template.cpp
+    static bool isTrue(const Instruction& instruction, const Poco::Dynamic::Var& value) {
+        if (value.isEmpty()) {
+            return false;
+        }
+        if (instruction.exist) {
+            return true;
+        }
+        if (value.isString()) {
+            return !value.convert<std::string>().empty();
+        }
+        return value.convert<bool>();
+    }
+
+    static void append(const Poco::Dynamic::Var& value, std::string& out) {
+        if (value.isEmpty()) {
+            return;
+        }
+        if (value.type() == typeid(std::string)) {
+            out += value.extract<std::string>();
+        } else {
+            out += value.convert<std::string>();
+        }
+    }
+
+    std::vector<Instruction> code_;
+    std::vector<QueryPlan> plans_;
+    std::vector<FileStamp> files_;
+};
+
+// Скомпилированные шаблоны по пути файла; безопасен для нескольких потоков.
+// Шаблон перекомпилируется, если изменился его файл или любое включение
+class CompiledTemplateCache {
+public:
+    CompiledTemplate::Ptr get(const std::string& path) {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        auto it = templates_.find(path);
+        if (it != templates_.end() && !it->second->isStale()) {
+            return it->second;
+        }
+        CompiledTemplate::Ptr compiled = CompiledTemplate::fromFile(path);
+        templates_[path] = compiled;
+        ++compilations_;
+        return compiled;
+    }
+
+    // Сколько раз шаблоны компилировались (первый раз и после изменений)
+    std::size_t compilations() const {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        return compilations_;
+    }
+
+    std::size_t size() const {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        return templates_.size();
+    }
+
+    void clear() {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        templates_.clear();
+    }
+
+private:
+    mutable Poco::FastMutex mutex_;
+    std::unordered_map<std::string, CompiledTemplate::Ptr> templates_;
+    std::size_t compilations_ = 0;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_TEMPLATE_H
@@ -0,0 +1,305 @@
+#ifndef POCO_TEST_APP_JSON_WRITER_H
+#define POCO_TEST_APP_JSON_WRITER_H
+
+// Сериализация дерева Poco::JSON в компактный JSON прямо в std::string
+// вызывающего.
+//
+// Stringifier и Object::stringify пишут только в std::ostream, поэтому
+// получение строки - это ostringstream плюс копия ss.str(). JsonWriter
+// дописывает результат в переданный буфер, ёмкость которого сохраняется между
+// документами. Вывод побайтно совпадает с Stringifier::condense: объекты
+// обходятся в порядке ключей std::map, строки экранируются как в
+// Poco::toJSON, double пишется кратчайшей записью в формате NumberFormatter
+// (json_number.h), float форматирует сам Dynamic::Var. Типы, для которых нет
+// быстрого пути (даты, Dynamic::Struct, векторы Var), передаются Stringifier
+// через поток, дописывающий в тот же буфер.
+//
+// Объект, созданный с JSON_PRESERVE_KEY_ORDER, Object::stringify пишет в
+// порядке вставки, но Object не сообщает об этом без копирования ключей
+// (getNames()). Поэтому порядок задаёт опция писателя: с
+// JSON_PRESERVE_KEY_ORDER ключи берутся из getNames() - это порядок
+// Object::stringify для любого объекта, и вывод совпадает с condense на
+// любом дереве ценой копии ключей; без неё обход идёт по std::map без
+// выделений памяти, и для таких объектов вывод отличается от condense
+// только порядком ключей.
+//
+// Участки строк, не требующие экранирования, находятся векторным поиском
+// (json_scan.h) и копируются целиком; экранируются только отдельные байты.
+
+#include "json_number.h"
+#include "json_profile.h"
+#include "json_scan.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/JSONString.h>
+
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+namespace pocotest {
+
+// Буфер потока, дописывающий всё в std::string
+class StringAppendBuf : public std::streambuf {
+public:
+    explicit StringAppendBuf(std::string& out)
+        : out_(out) {
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            out_ += traits_type::to_char_type(c);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        out_.append(s, static_cast<std::size_t>(n));
+        return n;
+    }
+
+private:
+    std::string& out_;
+};
+
+// std::ostream поверх StringAppendBuf
+class StringAppendStream : public std::ostream {
+public:
+    explicit StringAppendStream(std::string& out)
+        : std::ostream(nullptr)
+        , buf_(out) {
+        rdbuf(&buf_);
+    }
+
+private:
+    StringAppendBuf buf_;
+};
+
+class JsonWriter {
+public:
+    explicit JsonWriter(int options = Poco::JSON_WRAP_STRINGS)
+        : options_(options)
+        , kernels_(&scan::kernels()) {
+    }
+
+    int options() const {
+        return options_;
+    }
+
+    // Дописывает компактный JSON значения в конец out
+    void write(const Poco::Dynamic::Var& value, std::string& out) const {
+        POCO_TEST_APP_PROFILE_SCOPE(Stringify);
+        if (value.type() == typeid(std::string)) {
+            writeString(value.extract<std::string>(), out, (options_ & Poco::JSON_WRAP_STRINGS) != 0);
+        } else {
+            writeValue(value, out);
+        }
+    }
+
+    void write(const Poco::JSON::Object& object, std::string& out) const {
+        POCO_TEST_APP_PROFILE_SCOPE(Stringify);
+        writeObject(object, out);
+    }
+
+    void write(const Poco::JSON::Array& array, std::string& out) const {
+        POCO_TEST_APP_PROFILE_SCOPE(Stringify);
+        writeArray(array, out);
+    }
+
+    // Дописывает строку в кавычках, экранированную как в Poco::toJSON. Без
+    // кавычек (wrap = false) строку можно дописывать частями, не разрывающими
+    // символы UTF-8
+    void writeString(std::string_view value, std::string& out, bool wrap = true) const {
+        POCO_TEST_APP_PROFILE_SCOPE(Escape);
+        if (wrap) {
+            out += '"';
+        }
+        if ((options_ & Poco::JSON_ESCAPE_UNICODE) != 0) {
+            writeUnicodeEscaped(value, out);
+        } else {
+            writeEscaped(value, out);
+        }
+        if (wrap) {
+            out += '"';
+        }
+    }
+
+private:
+    void writeValue(const Poco::Dynamic::Var& value, std::string& out) const {
+        const std::type_info& type = value.type();
+        if (type == typeid(Poco::JSON::Object::Ptr)) {
+            const Poco::JSON::Object::Ptr& object = value.extract<Poco::JSON::Object::Ptr>();
+            if (object.isNull()) {
+                out += "null";
+            } else {
+                writeObject(*object, out);
+            }
+        } else if (type == typeid(Poco::JSON::Array::Ptr)) {
+            const Poco::JSON::Array::Ptr& array = value.extract<Poco::JSON::Array::Ptr>();
+            if (array.isNull()) {
+                out += "null";
+            } else {
+                writeArray(*array, out);
+            }
+        } else if (type == typeid(std::string)) {
+            writeString(value.extract<std::string>(), out);
+        } else if (value.isEmpty()) {
+            out += "null";
+        } else if (type == typeid(bool)) {
+            out += value.extract<bool>() ? "true" : "false";
+        } else if (type == typeid(Poco::Int64)) {
+            writeInteger(value.extract<Poco::Int64>(), out);
+        } else if (type == typeid(Poco::UInt64)) {
+            writeInteger(value.extract<Poco::UInt64>(), out);
+        } else if (type == typeid(int)) {
+            writeInteger(value.extract<int>(), out);
+        } else if (type == typeid(unsigned)) {
+            writeInteger(value.extract<unsigned>(), out);
+        } else if (type == typeid(Poco::JSON::Object)) {
+            writeObject(value.extract<Poco::JSON::Object>(), out);
+        } else if (type == typeid(Poco::JSON::Array)) {
+            writeArray(value.extract<Poco::JSON::Array>(), out);
+        } else if (type == typeid(double)) {
+            // Кратчайшая запись в формате NumberFormatter (json_number.h)
+            char buffer[number::MAX_DOUBLE_CHARS];
+            out.append(buffer, number::formatDouble(value.extract<double>(), buffer));
+        } else if (type == typeid(float)) {
+            // float Poco форматирует со своей точностью - через Dynamic::Var
+            out += value.convert<std::string>();
+        } else {
+            StringAppendStream stream(out);
+            Poco::JSON::Stringifier::condense(value, stream, options_ | Poco::JSON_WRAP_STRINGS);
+        }
+    }
+
+    void writeObject(const Poco::JSON::Object& object, std::string& out) const {
+        out += '{';
+        bool first = true;
+        if ((options_ & Poco::JSON_PRESERVE_KEY_ORDER) != 0) {
+            for (const auto& name : object.getNames()) {
+                if (!first) {
+                    out += ',';
+                }
+                first = false;
+                writeString(name, out);
+                out += ':';
+                writeValue(object.get(name), out);
+            }
+        } else {
+            for (const auto& member : object) {
+                if (!first) {
+                    out += ',';
+                }
+                first = false;
+                writeString(member.first, out);
+                out += ':';
+                writeValue(member.second, out);
+            }
+        }
+        out += '}';
+    }
+
+    void writeArray(const Poco::JSON::Array& array, std::string& out) const {
+        out += '[';
+        bool first = true;
+        for (const auto& element : array) {
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            writeValue(element, out);
+        }
+        out += ']';
+    }
+
+    template <typename T>
+    static void writeInteger(T value, std::string& out) {
+        char digits[24];
+        const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+
+    void writeEscaped(std::string_view value, std::string& out) const {
+        static const bool escapeSlash = Poco::toJSON("/", 0) == "\\/";
+        const auto run = escapeSlash ? kernels_->escapeRun : kernels_->stringRun;
+        const char* hex = (options_ & Poco::JSON_LOWERCASE_HEX) != 0 ? "0123456789abcdef" : "0123456789ABCDEF";
+
+        const char* p = value.data();
+        const char* end = p + value.size();
+        for (;;) {
+            const char* stop = run(p, end);
+            out.append(p, stop);
+            if (stop == end) {
+                return;
+            }
+            const unsigned char c = static_cast<unsigned char>(*stop);
+            p = stop + 1;
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '/': out += "\\/"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default: {
+                    const char escaped[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0F]};
+                    out.append(escaped, sizeof(escaped));
+                    break;
+                }
+            }
+        }
+    }
+
+    // JSON_ESCAPE_UNICODE: печатный ASCII копируется целиком, а отрезки из
+    // остальных байтов экранирует Poco. Отрезки режутся только на ASCII, так
+    // что последовательности UTF-8 не разрываются
+    void writeUnicodeEscaped(std::string_view value, std::string& out) const {
+        const int options = options_ & ~Poco::JSON_WRAP_STRINGS;
+        const char* p = value.data();
+        const char* end = p + value.size();
+        for (;;) {
+            const char* stop = kernels_->escapeUnicodeRun(p, end);
+            if (stop == end) {
+                out.append(p, stop);
+                return;
+            }
+            // Poco присоединяет байты продолжения (10xxxxxx) к предыдущему
+            // символу, даже ASCII: в некорректном UTF-8 отрезок начинается
+            // на символ раньше
+            if (stop != p && (static_cast<unsigned char>(*stop) & 0xC0) == 0x80) {
+                --stop;
+            }
+            out.append(p, stop);
+            p = stop + 1;
+            while (p != end && scan::detail::isEscapedUnicode(static_cast<unsigned char>(*p))) {
+                ++p;
+            }
+            out += Poco::toJSON(std::string(stop, p), options);
+        }
+    }
+
+    int options_;
+    const scan::Kernels* kernels_;
+};
+
+// Сериализует значение в out, заменяя прежнее содержимое; ёмкость out
+// сохраняется, так что буфер можно переиспользовать между документами
+inline void stringifyTo(const Poco::Dynamic::Var& value, std::string& out,
+                        int options = Poco::JSON_WRAP_STRINGS) {
+    out.clear();
+    JsonWriter(options).write(value, out);
+}
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JSON_WRITER_H
@@ -0,0 +1,458 @@
+#ifndef POCO_TEST_APP_JWS_SIGNER_H
+#define POCO_TEST_APP_JWS_SIGNER_H
+
+// Подпись и проверка канонизированных JSON-сообщений в компактном формате
+// JWS (RFC 7515): BASE64URL(заголовок) "." BASE64URL(полезная нагрузка) "."
+// BASE64URL(подпись). Поддерживаются HS256 (HMAC-SHA256) и RS256
+// (RSASSA-PKCS1-v1_5 с SHA-256, Poco::Crypto).
+//
+// Канонический вид объекта - компактный JSON с ключами в порядке байтов на
+// всех уровнях, в том числе в объектах внутри массивов, независимо от
+// JSON_PRESERVE_KEY_ORDER: объекты обходятся по своему std::map, а
+// JsonWriter пишет только скаляры. Строки пишутся в UTF-8 с экранированием
+// Poco::toJSON, числа - кратчайшей записью (json_number.h), так что разбор
+// канонического текста и повторная канонизация дают тот же текст.
+//
+// JwsSigner держит контексты дайджеста и ключа (HMACEngine с посчитанными
+// ipad/opad или RSADigestEngine), заголовок в base64url и буферы; всё это
+// создаётся один раз и переиспользуется для каждого сообщения. Экземпляр
+// используется одним потоком. JwsBatchSigner делит пакет сообщений на
+// непрерывные отрезки по числу потоков; каждый отрезок обрабатывает свой
+// JwsSigner, потоки берутся из собственного Poco::ThreadPool и живут между
+// пакетами.
+//
+// Заголовок токена при проверке должен совпадать с заголовком ключа
+// побайтно, так что алгоритм из токена не выбирается. Некорректный токен -
+// это false, а не исключение; исключения бросают только ошибки ключа
+// (например, подпись открытым ключом RSA).
+
+#include "json_writer.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Crypto/RSAKey.h>
+#include <Poco/Crypto/RSADigestEngine.h>
+#include <Poco/HMACEngine.h>
+#include <Poco/SHA2Engine.h>
+#include <Poco/DigestEngine.h>
+#include <Poco/Runnable.h>
+#include <Poco/ThreadPool.h>
+#include <Poco/SharedPtr.h>
+#include <Poco/Exception.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+namespace pocotest {
+
+namespace detail {
+
+inline void appendBase64Url(const unsigned char* data, std::size_t size, std::string& out) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        const unsigned v = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        const char quad[] = {alphabet[v >> 18], alphabet[(v >> 12) & 0x3F], alphabet[(v >> 6) & 0x3F],
+                             alphabet[v & 0x3F]};
+        out.append(quad, sizeof(quad));
+    }
+    if (size - i == 1) {
+        const unsigned v = data[i] << 16;
+        out += alphabet[v >> 18];
+        out += alphabet[(v >> 12) & 0x3F];
+    } else if (size - i == 2) {
+        const unsigned v = (data[i] << 16) | (data[i + 1] << 8);
+        out += alphabet[v >> 18];
+        out += alphabet[(v >> 12) & 0x3F];
+        out += alphabet[(v >> 6) & 0x3F];
+    }
+}
+
+inline void appendBase64Url(std::string_view data, std::string& out) {
+    appendBase64Url(reinterpret_cast<const unsigned char*>(data.data()), data.size(), out);
+}
+
+// Декодирует base64url без дополнения '='; false на недопустимом символе
+// или длине
+inline bool decodeBase64Url(std::string_view text, Poco::DigestEngine::Digest& out) {
+    out.clear();
+    if (text.size() % 4 == 1) {
+        return false;
+    }
+    unsigned v = 0;
+    int bits = 0;
+    for (char c : text) {
+        unsigned d;
+        if (c >= 'A' && c <= 'Z') {
+            d = c - 'A';
+        } else if (c >= 'a' && c <= 'z') {
+            d = c - 'a' + 26;
+        } else if (c >= '0' && c <= '9') {
+            d = c - '0' + 52;
+        } else if (c == '-') {
+            d = 62;
+        } else if (c == '_') {
+            d = 63;
+        } else {
+            return false;
+        }
+        v = (v << 6) | d;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<unsigned char>(v >> bits));
+        }
+        v &= (1u << bits) - 1;
+    }
+    // Неполный хвост должен быть нулевым, иначе у подписи два представления
+    return v == 0;
+}
+
+// Сравнение за время, не зависящее от места первого расхождения
+inline bool equalConstantTime(const Poco::DigestEngine::Digest& a, const Poco::DigestEngine::Digest& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    unsigned char diff = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+inline void writeCanonical(const Poco::Dynamic::Var& value, const JsonWriter& writer, std::string& out);
+
+// Члены объекта по порядку байтов ключа: Object обходит свой std::map,
+// упорядоченный так (std::string сравнивает как unsigned char), при любых
+// флагах объекта
+inline void writeCanonicalObject(const Poco::JSON::Object& object, const JsonWriter& writer, std::string& out) {
+    out += '{';
+    bool first = true;
+    for (const auto& member : object) {
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        writer.writeString(member.first, out);
+        out += ':';
+        writeCanonical(member.second, writer, out);
+    }
+    out += '}';
+}
+
+inline void writeCanonicalArray(const Poco::JSON::Array& array, const JsonWriter& writer, std::string& out) {
+    out += '[';
+    bool first = true;
+    for (const auto& element : array) {
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        writeCanonical(element, writer, out);
+    }
+    out += ']';
+}
+
+inline void writeCanonical(const Poco::Dynamic::Var& value, const JsonWriter& writer, std::string& out) {
+    const std::type_info& type = value.type();
+    if (type == typeid(Poco::JSON::Object::Ptr)) {
+        const Poco::JSON::Object::Ptr& object = value.extract<Poco::JSON::Object::Ptr>();
+        if (object.isNull()) {
+            out += "null";
+        } else {
+            writeCanonicalObject(*object, writer, out);
+        }
+    } else if (type == typeid(Poco::JSON::Array::Ptr)) {
+        const Poco::JSON::Array::Ptr& array = value.extract<Poco::JSON::Array::Ptr>();
+        if (array.isNull()) {
+            out += "null";
+        } else {
+            writeCanonicalArray(*array, writer, out);
+        }
+    } else if (type == typeid(Poco::JSON::Object)) {
+        writeCanonicalObject(value.extract<Poco::JSON::Object>(), writer, out);
+    } else if (type == typeid(Poco::JSON::Array)) {
+        writeCanonicalArray(value.extract<Poco::JSON::Array>(), writer, out);
+    } else {
+        writer.write(value, out);
+    }
+}
+
+} // namespace detail
+
+// Канонический JSON объекта в out, заменяя прежнее содержимое
+inline void canonicalizeTo(const Poco::JSON::Object& object, std::string& out) {
+    out.clear();
+    detail::writeCanonicalObject(object, JsonWriter(Poco::JSON_WRAP_STRINGS), out);
+}
+
+// Алгоритм и ключ; копии разделяют ключ RSA
+class JwsKey {
+public:
+    enum Algorithm {
+        HS256,
+        RS256
+    };
+
+    static JwsKey hmac(const std::string& secret) {
+        return JwsKey(HS256, secret, nullptr);
+    }
+
+    // Для проверки достаточно открытого ключа, для подписи нужен закрытый
+    static JwsKey rsa(const Poco::Crypto::RSAKey& key) {
+        return JwsKey(RS256, std::string(), new Poco::Crypto::RSAKey(key));
+    }
+
+    Algorithm algorithm() const {
+        return algorithm_;
+    }
+
+    const char* name() const {
+        return algorithm_ == HS256 ? "HS256" : "RS256";
+    }
+
+    const std::string& secret() const {
+        return secret_;
+    }
+
+    const Poco::Crypto::RSAKey& rsaKey() const {
+        return *rsa_;
+    }
+
+private:
+    JwsKey(Algorithm algorithm, const std::string& secret, Poco::Crypto::RSAKey* rsa)
+        : algorithm_(algorithm)
+        , secret_(secret)
+        , rsa_(rsa) {
+    }
+
+    Algorithm algorithm_;
+    std::string secret_;
+    Poco::SharedPtr<Poco::Crypto::RSAKey> rsa_;
+};
+
+class JwsSigner {
+public:
+    using Hmac = Poco::HMACEngine<Poco::SHA2Engine256>;
+
+    explicit JwsSigner(const JwsKey& key)
+        : key_(key) {
+        if (key.algorithm() == JwsKey::HS256) {
+            hmac_ = std::make_unique<Hmac>(key.secret());
+        } else {
+            rsa_ = std::make_unique<Poco::Crypto::RSADigestEngine>(key.rsaKey(), "SHA256");
+        }
+        const std::string header = std::string("{\"alg\":\"") + key.name() + "\"}";
+        detail::appendBase64Url(header, header_);
+    }
+
+    JwsSigner(const JwsSigner&) = delete;
+    JwsSigner& operator=(const JwsSigner&) = delete;
+
+    const JwsKey& key() const {
+        return key_;
+    }
+
+    // Заголовок токена в base64url
+    const std::string& header() const {
+        return header_;
+    }
+
+    // Токен для payload в token, заменяя прежнее содержимое; ёмкость token
+    // сохраняется между сообщениями
+    void sign(const Poco::JSON::Object& payload, std::string& token) {
+        canonicalizeTo(payload, canonical_);
+        token.assign(header_);
+        token += '.';
+        detail::appendBase64Url(canonical_, token);
+        const Poco::DigestEngine::Digest& signature = computeSignature(token);
+        token += '.';
+        detail::appendBase64Url(signature.data(), signature.size(), token);
+    }
+
+    // Токен во внутреннем буфере, действителен до следующего вызова
+    const std::string& sign(const Poco::JSON::Object& payload) {
+        sign(payload, token_);
+        return token_;
+    }
+
+    // Проверяет формат, заголовок и подпись токена
+    bool verify(std::string_view token) {
+        const std::size_t first = token.find('.');
+        const std::size_t second = first == std::string_view::npos ? first : token.find('.', first + 1);
+        if (second == std::string_view::npos || token.find('.', second + 1) != std::string_view::npos
+            || token.substr(0, first) != header_) {
+            return false;
+        }
+        if (!detail::decodeBase64Url(token.substr(second + 1), received_)) {
+            return false;
+        }
+        const std::string_view input = token.substr(0, second);
+        if (hmac_) {
+            return detail::equalConstantTime(computeSignature(input), received_);
+        }
+        rsa_->reset();
+        rsa_->update(input.data(), input.size());
+        return rsa_->verify(received_);
+    }
+
+    // Вдобавок к verify(token) проверяет, что токен подписывает именно
+    // канонический вид payload
+    bool verify(const Poco::JSON::Object& payload, std::string_view token) {
+        canonicalizeTo(payload, canonical_);
+        encoded_.clear();
+        detail::appendBase64Url(canonical_, encoded_);
+        const std::size_t first = token.find('.');
+        if (first == std::string_view::npos || token.compare(first + 1, encoded_.size(), encoded_) != 0
+            || token.size() <= first + 1 + encoded_.size() || token[first + 1 + encoded_.size()] != '.') {
+            return false;
+        }
+        return verify(token);
+    }
+
+    // Канонический вид последнего подписанного или проверенного payload
+    const std::string& canonical() const {
+        return canonical_;
+    }
+
+private:
+    const Poco::DigestEngine::Digest& computeSignature(std::string_view input) {
+        if (hmac_) {
+            hmac_->update(input.data(), input.size());
+            // digest() сбрасывает HMACEngine к начальному состоянию с тем же
+            // ключом; результат копируется до следующего update()
+            signature_ = hmac_->digest();
+            return signature_;
+        }
+        rsa_->reset();
+        rsa_->update(input.data(), input.size());
+        return rsa_->signature();
+    }
+
+    JwsKey key_;
+    std::unique_ptr<Hmac> hmac_;
+    std::unique_ptr<Poco::Crypto::RSADigestEngine> rsa_;
+    std::string header_;
+    std::string canonical_;
+    std::string encoded_;
+    std::string token_;
+    Poco::DigestEngine::Digest signature_;
+    Poco::DigestEngine::Digest received_;
+};
+
+// Пакетная подпись и проверка в нескольких потоках с JwsSigner на поток
+class JwsBatchSigner {
+public:
+    // threads == 0 - по числу ядер
+    explicit JwsBatchSigner(const JwsKey& key, unsigned threads = 0)
+        : threads_(std::max(1u, threads != 0 ? threads : std::thread::hardware_concurrency()))
+        , pool_(1, static_cast<int>(threads_)) {
+        workers_.reserve(threads_);
+        for (unsigned i = 0; i < threads_; ++i) {
+            workers_.push_back(std::make_unique<Worker>(key));
+        }
+    }
+
+    JwsBatchSigner(const JwsBatchSigner&) = delete;
+    JwsBatchSigner& operator=(const JwsBatchSigner&) = delete;
+
+    unsigned getThreads() const {
+        return threads_;
+    }
+
+    // tokens[i] - токен payloads[i]; строки tokens переиспользуются
+    void sign(const std::vector<Poco::JSON::Object::Ptr>& payloads, std::vector<std::string>& tokens) {
+        tokens.resize(payloads.size());
+        run(payloads.size(), [&](JwsSigner& signer, std::size_t i) {
+            signer.sign(*payloads[i], tokens[i]);
+        });
+    }
+
+    // results[i] - verify(payloads[i], tokens[i]); без payloads проверяются
+    // только токены
+    void verify(const std::vector<Poco::JSON::Object::Ptr>& payloads, const std::vector<std::string>& tokens,
+                std::vector<char>& results) {
+        if (!payloads.empty() && payloads.size() != tokens.size()) {
+            throw Poco::InvalidArgumentException("JwsBatchSigner::verify", "payloads and tokens differ in size");
+        }
+        results.assign(tokens.size(), 0);
+        run(tokens.size(), [&](JwsSigner& signer, std::size_t i) {
+            results[i] = payloads.empty() ? signer.verify(tokens[i]) : signer.verify(*payloads[i], tokens[i]);
+        });
+    }
+
+    void verify(const std::vector<std::string>& tokens, std::vector<char>& results) {
+        verify({}, tokens, results);
+    }
+
+private:
+    class Worker : public Poco::Runnable {
+    public:
+        explicit Worker(const JwsKey& key)
+            : signer(key) {
+        }
+
+        void run() override {
+            try {
+                for (std::size_t i = begin; i < end; ++i) {
+                    task(signer, i);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        JwsSigner signer;
+        std::function<void(JwsSigner&, std::size_t)> task;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::exception_ptr error;
+    };
+
+    // Первый отрезок обрабатывает вызывающий поток, остальные - пул
+    template <typename Task>
+    void run(std::size_t count, Task&& task) {
+        const std::size_t parts = std::min<std::size_t>(workers_.size(), count);
+        if (parts == 0) {
+            return;
+        }
+        const std::size_t step = (count + parts - 1) / parts;
+        std::size_t used = 0;
+        for (std::size_t begin = 0; begin < count; begin += step, ++used) {
+            Worker& worker = *workers_[used];
+            worker.task = task;
+            worker.begin = begin;
+            worker.end = std::min(count, begin + step);
+            worker.error = nullptr;
+        }
+        for (std::size_t i = 1; i < used; ++i) {
+            pool_.start(*workers_[i]);
+        }
+        workers_[0]->run();
+        pool_.joinAll();
+
+        for (std::size_t i = 0; i < used; ++i) {
+            workers_[i]->task = nullptr;
+            if (workers_[i]->error) {
+                std::rethrow_exception(workers_[i]->error);
+            }
+        }
+    }
+
+    unsigned threads_;
+    Poco::ThreadPool pool_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_JWS_SIGNER_H
@@ -0,0 +1,122 @@
+#ifndef POCO_TEST_APP_KEY_POOL_H
+#define POCO_TEST_APP_KEY_POOL_H
+
+// Общий словарь ключей объектов для потока однотипных документов.
+//
+// Документы одной схемы повторяют одни и те же ключи, а каждое дерево
+// хранит свою копию каждого ключа. KeyPool хранит ключ один раз на всё
+// время жизни пула и отдаёт std::string_view на эту копию: повторный ключ
+// не занимает памяти в документе, а два интернированных ключа равны тогда и
+// только тогда, когда равны их указатели.
+//
+// Пул подключается явно (ArenaHandler::setKeyPool) и может быть общим для
+// нескольких парсеров и потоков. Чтобы чужой вход с уникальными ключами не
+// раздувал пул, он ограничен числом ключей и длиной ключа; ключ сверх
+// ограничений не интернируется, и вызывающий копирует его сам.
+
+#include <Poco/SharedPtr.h>
+#include <Poco/Mutex.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace pocotest {
+
+struct KeyPoolStats {
+    std::size_t keys = 0;          // различных ключей в пуле
+    std::size_t bytes = 0;         // байт текста ключей в пуле
+    std::size_t hits = 0;          // обращений к уже известному ключу
+    std::size_t misses = 0;        // ключей, добавленных в пул
+    std::size_t rejected = 0;      // ключей, не принятых из-за ограничений
+    std::size_t savedBytes = 0;    // байт, не скопированных благодаря попаданиям
+};
+
+class KeyPool {
+public:
+    using Ptr = Poco::SharedPtr<KeyPool>;
+
+    explicit KeyPool(std::size_t maxKeys = 65536, std::size_t maxKeyLength = 256)
+        : maxKeys_(maxKeys)
+        , maxKeyLength_(maxKeyLength) {
+    }
+
+    KeyPool(const KeyPool&) = delete;
+    KeyPool& operator=(const KeyPool&) = delete;
+
+    // Интернированная копия key, действительная, пока жив пул. Пустой
+    // string_view (data() == nullptr), если key пустой или не принят
+    std::string_view intern(std::string_view key) {
+        if (key.empty()) {
+            return std::string_view();
+        }
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            ++stats_.hits;
+            stats_.savedBytes += key.size();
+            return *it;
+        }
+        if (key.size() > maxKeyLength_ || index_.size() >= maxKeys_) {
+            ++stats_.rejected;
+            return std::string_view();
+        }
+        const std::string_view stored = store(key);
+        index_.insert(stored);
+        ++stats_.misses;
+        ++stats_.keys;
+        stats_.bytes += key.size();
+        return stored;
+    }
+
+    // Интернированная копия key без добавления в пул
+    std::string_view find(std::string_view key) const {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        auto it = index_.find(key);
+        return it != index_.end() ? *it : std::string_view();
+    }
+
+    std::size_t size() const {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        return index_.size();
+    }
+
+    KeyPoolStats stats() const {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        return stats_;
+    }
+
+private:
+    static constexpr std::size_t BLOCK_SIZE = 16 * 1024;
+
+    // Текст ключей лежит в блоках, которые не перемещаются, так что
+    // выданные string_view остаются действительными
+    std::string_view store(std::string_view key) {
+        if (blockCapacity_ - blockUsed_ < key.size()) {
+            blockCapacity_ = std::max(BLOCK_SIZE, key.size());
+            blocks_.emplace_back(new char[blockCapacity_]);
+            blockUsed_ = 0;
+        }
+        char* p = blocks_.back().get() + blockUsed_;
+        std::memcpy(p, key.data(), key.size());
+        blockUsed_ += key.size();
+        return std::string_view(p, key.size());
+    }
+
+    const std::size_t maxKeys_;
+    const std::size_t maxKeyLength_;
+    mutable Poco::FastMutex mutex_;
+    std::unordered_set<std::string_view> index_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::size_t blockCapacity_ = 0;
+    std::size_t blockUsed_ = 0;
+    KeyPoolStats stats_;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_KEY_POOL_H
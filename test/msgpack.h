@@ -0,0 +1,608 @@
+#ifndef POCO_TEST_APP_MSGPACK_H
+#define POCO_TEST_APP_MSGPACK_H
+
+// Двоичная сериализация дерева Poco::JSON в MessagePack для внутренних
+// обменов между сервисами.
+//
+// Текстовый путь Object::stringify -> Parser::parse форматирует и снова
+// разбирает каждое число и ищет конец каждой строки по символам.
+// MessagePack хранит числа в двоичном виде, а перед строкой, массивом и
+// объектом - их длину: строка читается одним копированием в заранее
+// выделенную память, а ненужное значение пропускается без разбора (skip()).
+//
+// MsgPackWriter дописывает кодировку в переданный буфер, как JsonWriter:
+// целые - в самой короткой форме, double - float64, float - float32,
+// строки - str, Object/Array - map/array (Object - в порядке getNames() с
+// JSON_PRESERVE_KEY_ORDER), Dynamic::Struct и std::vector<Var> - тоже
+// map/array, пустое значение - nil. Прочие типы Dynamic::Var (например,
+// даты) пишутся строкой Var::convert<std::string>().
+//
+// MsgPackReader передаёт события тому же интерфейсу Poco::JSON::Handler, что
+// Parser и JsonReader, и даёт те же типы, что текстовый разбор: целые -
+// Int64 (или UInt64, если не помещаются), числа с плавающей точкой - double,
+// bin - std::string. Ключи объектов должны быть строками, ext не
+// поддерживается. Разбор итеративный, с явным стеком; длины проверяются по
+// размеру входа до выделения памяти, так что испорченный вход не приводит к
+// огромным выделениям.
+
+#include <Poco/JSON/Handler.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Dynamic/Struct.h>
+#include <Poco/JSONString.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+namespace pocotest {
+
+namespace msgpack {
+
+// Байты-маркеры формата (https://github.com/msgpack/msgpack/blob/master/spec.md)
+enum Marker : unsigned char {
+    NIL = 0xc0,
+    NEVER_USED = 0xc1,
+    BOOL_FALSE = 0xc2,
+    BOOL_TRUE = 0xc3,
+    BIN8 = 0xc4,
+    BIN16 = 0xc5,
+    BIN32 = 0xc6,
+    EXT8 = 0xc7,
+    EXT16 = 0xc8,
+    EXT32 = 0xc9,
+    FLOAT32 = 0xca,
+    FLOAT64 = 0xcb,
+    UINT8 = 0xcc,
+    UINT16 = 0xcd,
+    UINT32 = 0xce,
+    UINT64 = 0xcf,
+    INT8 = 0xd0,
+    INT16 = 0xd1,
+    INT32 = 0xd2,
+    INT64 = 0xd3,
+    FIXEXT1 = 0xd4,
+    FIXEXT16 = 0xd8,
+    STR8 = 0xd9,
+    STR16 = 0xda,
+    STR32 = 0xdb,
+    ARRAY16 = 0xdc,
+    ARRAY32 = 0xdd,
+    MAP16 = 0xde,
+    MAP32 = 0xdf,
+};
+
+namespace detail {
+
+template <typename T>
+void appendBigEndian(T value, std::string& out) {
+    char bytes[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<char>(value >> (8 * (sizeof(T) - 1 - i)));
+    }
+    out.append(bytes, sizeof(T));
+}
+
+template <typename T>
+T readBigEndian(const char* p) {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value = static_cast<T>((value << 8) | static_cast<unsigned char>(p[i]));
+    }
+    return value;
+}
+
+} // namespace detail
+
+} // namespace msgpack
+
+class MsgPackWriter {
+public:
+    // Из опций учитывается только JSON_PRESERVE_KEY_ORDER
+    explicit MsgPackWriter(int options = 0)
+        : options_(options) {
+    }
+
+    int options() const {
+        return options_;
+    }
+
+    // Дописывает кодировку значения в конец out
+    void write(const Poco::Dynamic::Var& value, std::string& out) const {
+        writeValue(value, out);
+    }
+
+    void write(const Poco::JSON::Object& object, std::string& out) const {
+        writeObject(object, out);
+    }
+
+    void write(const Poco::JSON::Array& array, std::string& out) const {
+        writeArray(array, out);
+    }
+
+private:
+    void writeValue(const Poco::Dynamic::Var& value, std::string& out) const {
+        const std::type_info& type = value.type();
+        if (type == typeid(Poco::JSON::Object::Ptr)) {
+            const Poco::JSON::Object::Ptr& object = value.extract<Poco::JSON::Object::Ptr>();
+            if (object.isNull()) {
+                out += static_cast<char>(msgpack::NIL);
+            } else {
+                writeObject(*object, out);
+            }
+        } else if (type == typeid(Poco::JSON::Array::Ptr)) {
+            const Poco::JSON::Array::Ptr& array = value.extract<Poco::JSON::Array::Ptr>();
+            if (array.isNull()) {
+                out += static_cast<char>(msgpack::NIL);
+            } else {
+                writeArray(*array, out);
+            }
+        } else if (type == typeid(std::string)) {
+            writeString(value.extract<std::string>(), out);
+        } else if (value.isEmpty()) {
+            out += static_cast<char>(msgpack::NIL);
+        } else if (type == typeid(bool)) {
+            out += static_cast<char>(value.extract<bool>() ? msgpack::BOOL_TRUE : msgpack::BOOL_FALSE);
+        } else if (type == typeid(Poco::Int64)) {
+            writeSigned(value.extract<Poco::Int64>(), out);
+        } else if (type == typeid(Poco::UInt64)) {
+            writeUnsigned(value.extract<Poco::UInt64>(), out);
+        } else if (type == typeid(int)) {
+            writeSigned(value.extract<int>(), out);
+        } else if (type == typeid(unsigned)) {
+            writeUnsigned(value.extract<unsigned>(), out);
+        } else if (type == typeid(double)) {
+            std::uint64_t bits = 0;
+            const double number = value.extract<double>();
+            std::memcpy(&bits, &number, sizeof(bits));
+            out += static_cast<char>(msgpack::FLOAT64);
+            msgpack::detail::appendBigEndian(bits, out);
+        } else if (type == typeid(float)) {
+            std::uint32_t bits = 0;
+            const float number = value.extract<float>();
+            std::memcpy(&bits, &number, sizeof(bits));
+            out += static_cast<char>(msgpack::FLOAT32);
+            msgpack::detail::appendBigEndian(bits, out);
+        } else if (type == typeid(Poco::JSON::Object)) {
+            writeObject(value.extract<Poco::JSON::Object>(), out);
+        } else if (type == typeid(Poco::JSON::Array)) {
+            writeArray(value.extract<Poco::JSON::Array>(), out);
+        } else if (type == typeid(Poco::DynamicStruct)) {
+            const Poco::DynamicStruct& members = value.extract<Poco::DynamicStruct>();
+            writeHeader(members.size(), 0x80, msgpack::MAP16, msgpack::MAP32, out);
+            for (const auto& member : members) {
+                writeString(member.first, out);
+                writeValue(member.second, out);
+            }
+        } else if (type == typeid(std::vector<Poco::Dynamic::Var>)) {
+            const std::vector<Poco::Dynamic::Var>& elements = value.extract<std::vector<Poco::Dynamic::Var>>();
+            writeHeader(elements.size(), 0x90, msgpack::ARRAY16, msgpack::ARRAY32, out);
+            for (const auto& element : elements) {
+                writeValue(element, out);
+            }
+        } else {
+            writeString(value.convert<std::string>(), out);
+        }
+    }
+
+    void writeObject(const Poco::JSON::Object& object, std::string& out) const {
+        writeHeader(object.size(), 0x80, msgpack::MAP16, msgpack::MAP32, out);
+        if ((options_ & Poco::JSON_PRESERVE_KEY_ORDER) != 0) {
+            for (const auto& name : object.getNames()) {
+                writeString(name, out);
+                writeValue(object.get(name), out);
+            }
+        } else {
+            for (const auto& member : object) {
+                writeString(member.first, out);
+                writeValue(member.second, out);
+            }
+        }
+    }
+
+    void writeArray(const Poco::JSON::Array& array, std::string& out) const {
+        writeHeader(array.size(), 0x90, msgpack::ARRAY16, msgpack::ARRAY32, out);
+        for (const auto& element : array) {
+            writeValue(element, out);
+        }
+    }
+
+    static void writeString(const std::string& value, std::string& out) {
+        if (value.size() <= 31) {
+            out += static_cast<char>(0xa0 | value.size());
+        } else if (value.size() <= 0xff) {
+            out += static_cast<char>(msgpack::STR8);
+            out += static_cast<char>(value.size());
+        } else {
+            writeLength(value.size(), msgpack::STR16, msgpack::STR32, out);
+        }
+        out += value;
+    }
+
+    // Заголовок контейнера: fix-форма до 15 элементов, иначе 16 или 32 бита
+    static void writeHeader(std::size_t size, unsigned char fixMarker,
+                            unsigned char marker16, unsigned char marker32, std::string& out) {
+        if (size <= 15) {
+            out += static_cast<char>(fixMarker | size);
+        } else {
+            writeLength(size, marker16, marker32, out);
+        }
+    }
+
+    static void writeLength(std::size_t size, unsigned char marker16, unsigned char marker32, std::string& out) {
+        if (size <= 0xffff) {
+            out += static_cast<char>(marker16);
+            msgpack::detail::appendBigEndian(static_cast<std::uint16_t>(size), out);
+        } else if (size <= 0xffffffffu) {
+            out += static_cast<char>(marker32);
+            msgpack::detail::appendBigEndian(static_cast<std::uint32_t>(size), out);
+        } else {
+            throw Poco::JSON::JSONException("Value is too large for MessagePack");
+        }
+    }
+
+    static void writeSigned(Poco::Int64 value, std::string& out) {
+        if (value >= 0) {
+            writeUnsigned(static_cast<Poco::UInt64>(value), out);
+        } else if (value >= -32) {
+            out += static_cast<char>(value);
+        } else if (value >= std::numeric_limits<std::int8_t>::min()) {
+            out += static_cast<char>(msgpack::INT8);
+            out += static_cast<char>(value);
+        } else if (value >= std::numeric_limits<std::int16_t>::min()) {
+            out += static_cast<char>(msgpack::INT16);
+            msgpack::detail::appendBigEndian(static_cast<std::uint16_t>(value), out);
+        } else if (value >= std::numeric_limits<std::int32_t>::min()) {
+            out += static_cast<char>(msgpack::INT32);
+            msgpack::detail::appendBigEndian(static_cast<std::uint32_t>(value), out);
+        } else {
+            out += static_cast<char>(msgpack::INT64);
+            msgpack::detail::appendBigEndian(static_cast<std::uint64_t>(value), out);
+        }
+    }
+
+    static void writeUnsigned(Poco::UInt64 value, std::string& out) {
+        if (value <= 0x7f) {
+            out += static_cast<char>(value);
+        } else if (value <= 0xff) {
+            out += static_cast<char>(msgpack::UINT8);
+            out += static_cast<char>(value);
+        } else if (value <= 0xffff) {
+            out += static_cast<char>(msgpack::UINT16);
+            msgpack::detail::appendBigEndian(static_cast<std::uint16_t>(value), out);
+        } else if (value <= 0xffffffffu) {
+            out += static_cast<char>(msgpack::UINT32);
+            msgpack::detail::appendBigEndian(static_cast<std::uint32_t>(value), out);
+        } else {
+            out += static_cast<char>(msgpack::UINT64);
+            msgpack::detail::appendBigEndian(static_cast<std::uint64_t>(value), out);
+        }
+    }
+
+    int options_;
+};
+
+// Кодирует значение в out, заменяя его содержимое; ёмкость out сохраняется
+inline void packTo(const Poco::Dynamic::Var& value, std::string& out, int options = 0) {
+    out.clear();
+    MsgPackWriter(options).write(value, out);
+}
+
+class MsgPackReader {
+public:
+    explicit MsgPackReader(const Poco::JSON::Handler::Ptr& handler = new Poco::JSON::ParseHandler)
+        : handler_(handler) {
+    }
+
+    // Максимальная глубина вложенности; 0 - без ограничения
+    void setDepth(std::size_t depth) {
+        maxDepth_ = depth;
+    }
+
+    std::size_t getDepth() const {
+        return maxDepth_;
+    }
+
+    const Poco::JSON::Handler::Ptr& handler() const {
+        return handler_;
+    }
+
+    // Разбирает одно значение, занимающее весь диапазон; вход не копируется.
+    // Возвращает результат обработчика (asVar())
+    Poco::Dynamic::Var parse(const char* data, std::size_t size) {
+        begin_ = data;
+        p_ = data;
+        end_ = data + size;
+        stack_.clear();
+        handler_->reset();
+        if (p_ == end_) {
+            fail("Empty MessagePack document");
+        }
+        parseDocument();
+        if (p_ != end_) {
+            fail("Excess bytes found after MessagePack value");
+        }
+        return handler_->asVar();
+    }
+
+    Poco::Dynamic::Var parse(std::string_view data) {
+        return parse(data.data(), data.size());
+    }
+
+    // Размер первого значения в data без разбора: длины строк и двоичных
+    // данных пропускаются целиком, у контейнеров - только заголовки
+    static std::size_t skip(const char* data, std::size_t size) {
+        const char* p = data;
+        const char* end = data + size;
+        Poco::UInt64 pending = 1;
+        while (pending > 0) {
+            if (p == end) {
+                throw Poco::JSON::JSONException("Truncated MessagePack value");
+            }
+            --pending;
+            const Header header = readHeader(p, end);
+            if (header.kind == Kind::Array) {
+                pending += header.length;
+            } else if (header.kind == Kind::Map) {
+                pending += 2 * header.length;
+            } else if (header.kind == Kind::String || header.kind == Kind::Binary) {
+                p += header.length;
+            }
+        }
+        return static_cast<std::size_t>(p - data);
+    }
+
+private:
+    enum class Kind { Nil, Bool, Signed, Unsigned, Float, Double, String, Binary, Array, Map };
+
+    // Разобранный маркер: для Signed/Unsigned/Bool - значение, для Float и
+    // Double - биты, для String/Binary/Array/Map - длина
+    struct Header {
+        Kind kind;
+        Poco::UInt64 length;
+    };
+
+    struct Frame {
+        Poco::UInt64 remaining;   // значений (пар для map) до конца контейнера
+        bool object;
+        bool expectKey;
+    };
+
+    // Читает маркер и его аргумент; p после вызова указывает на данные
+    // строки или первый элемент контейнера. Длины проверяются по концу входа
+    static Header readHeader(const char*& p, const char* end) {
+        const unsigned char marker = static_cast<unsigned char>(*p++);
+        if (marker <= 0x7f) {
+            return {Kind::Unsigned, marker};
+        }
+        if (marker >= 0xe0) {
+            return {Kind::Signed, static_cast<Poco::UInt64>(static_cast<Poco::Int64>(static_cast<std::int8_t>(marker)))};
+        }
+        if (marker >= 0x80 && marker <= 0x8f) {
+            return checked({Kind::Map, marker & 0x0fu}, p, end);
+        }
+        if (marker >= 0x90 && marker <= 0x9f) {
+            return checked({Kind::Array, marker & 0x0fu}, p, end);
+        }
+        if (marker >= 0xa0 && marker <= 0xbf) {
+            return checked({Kind::String, marker & 0x1fu}, p, end);
+        }
+        switch (marker) {
+            case msgpack::NIL: return {Kind::Nil, 0};
+            case msgpack::BOOL_FALSE: return {Kind::Bool, 0};
+            case msgpack::BOOL_TRUE: return {Kind::Bool, 1};
+            case msgpack::BIN8: return sized<std::uint8_t>(Kind::Binary, p, end);
+            case msgpack::BIN16: return sized<std::uint16_t>(Kind::Binary, p, end);
+            case msgpack::BIN32: return sized<std::uint32_t>(Kind::Binary, p, end);
+            case msgpack::FLOAT32: return {Kind::Float, take<std::uint32_t>(p, end)};
+            case msgpack::FLOAT64: return {Kind::Double, take<std::uint64_t>(p, end)};
+            case msgpack::UINT8: return {Kind::Unsigned, take<std::uint8_t>(p, end)};
+            case msgpack::UINT16: return {Kind::Unsigned, take<std::uint16_t>(p, end)};
+            case msgpack::UINT32: return {Kind::Unsigned, take<std::uint32_t>(p, end)};
+            case msgpack::UINT64: return {Kind::Unsigned, take<std::uint64_t>(p, end)};
+            case msgpack::INT8:
+                return {Kind::Signed, static_cast<Poco::UInt64>(static_cast<Poco::Int64>(static_cast<std::int8_t>(take<std::uint8_t>(p, end))))};
+            case msgpack::INT16:
+                return {Kind::Signed, static_cast<Poco::UInt64>(static_cast<Poco::Int64>(static_cast<std::int16_t>(take<std::uint16_t>(p, end))))};
+            case msgpack::INT32:
+                return {Kind::Signed, static_cast<Poco::UInt64>(static_cast<Poco::Int64>(static_cast<std::int32_t>(take<std::uint32_t>(p, end))))};
+            case msgpack::INT64: return {Kind::Signed, take<std::uint64_t>(p, end)};
+            case msgpack::STR8: return sized<std::uint8_t>(Kind::String, p, end);
+            case msgpack::STR16: return sized<std::uint16_t>(Kind::String, p, end);
+            case msgpack::STR32: return sized<std::uint32_t>(Kind::String, p, end);
+            case msgpack::ARRAY16: return sized<std::uint16_t>(Kind::Array, p, end);
+            case msgpack::ARRAY32: return sized<std::uint32_t>(Kind::Array, p, end);
+            case msgpack::MAP16: return sized<std::uint16_t>(Kind::Map, p, end);
+            case msgpack::MAP32: return sized<std::uint32_t>(Kind::Map, p, end);
+            default:
+                break;
+        }
+        --p;
+        if (marker == msgpack::NEVER_USED) {
+            throw Poco::JSON::JSONException("Invalid MessagePack marker 0xc1");
+        }
+        throw Poco::JSON::JSONException("MessagePack ext types are not supported");
+    }
+
+    template <typename T>
+    static T take(const char*& p, const char* end) {
+        if (static_cast<std::size_t>(end - p) < sizeof(T)) {
+            throw Poco::JSON::JSONException("Truncated MessagePack value");
+        }
+        const T value = msgpack::detail::readBigEndian<T>(p);
+        p += sizeof(T);
+        return value;
+    }
+
+    // Длина размера T после маркера, проверенная по остатку входа
+    template <typename T>
+    static Header sized(Kind kind, const char*& p, const char* end) {
+        const Header header{kind, take<T>(p, end)};
+        return checked(header, p, end);
+    }
+
+    // Строка занимает length байт, а каждый элемент контейнера - хотя бы
+    // один, так что длина больше остатка входа - признак испорченных данных
+    static Header checked(Header header, const char* p, const char* end) {
+        const Poco::UInt64 available = static_cast<Poco::UInt64>(end - p);
+        const Poco::UInt64 minimum = header.kind == Kind::Map ? 2 * header.length : header.length;
+        if (minimum > available) {
+            throw Poco::JSON::JSONException("MessagePack length exceeds input size");
+        }
+        return header;
+    }
+
+    void parseDocument() {
+        for (;;) {
+            if (!stack_.empty() && stack_.back().expectKey) {
+                parseKey();
+                continue;
+            }
+            if (!parseValue()) {
+                continue;
+            }
+            // Значение закончено: закрываем исчерпанные контейнеры
+            for (;;) {
+                if (stack_.empty()) {
+                    return;
+                }
+                Frame& frame = stack_.back();
+                if (--frame.remaining != 0) {
+                    frame.expectKey = frame.object;
+                    break;
+                }
+                const bool object = frame.object;
+                stack_.pop_back();
+                if (object) {
+                    handler_->endObject();
+                } else {
+                    handler_->endArray();
+                }
+            }
+        }
+    }
+
+    // false, если открыт непустой контейнер
+    bool parseValue() {
+        if (p_ == end_) {
+            fail("Unexpected end of MessagePack document");
+        }
+        const Header header = readChecked();
+        switch (header.kind) {
+            case Kind::Nil:
+                handler_->null();
+                return true;
+            case Kind::Bool:
+                handler_->value(header.length != 0);
+                return true;
+            case Kind::Unsigned:
+                if (header.length <= static_cast<Poco::UInt64>(std::numeric_limits<Poco::Int64>::max())) {
+                    handler_->value(static_cast<Poco::Int64>(header.length));
+                } else {
+                    handler_->value(static_cast<Poco::UInt64>(header.length));
+                }
+                return true;
+            case Kind::Signed:
+                handler_->value(static_cast<Poco::Int64>(header.length));
+                return true;
+            case Kind::Float: {
+                float number = 0.0f;
+                const std::uint32_t bits = static_cast<std::uint32_t>(header.length);
+                std::memcpy(&number, &bits, sizeof(number));
+                handler_->value(static_cast<double>(number));
+                return true;
+            }
+            case Kind::Double: {
+                double number = 0.0;
+                std::memcpy(&number, &header.length, sizeof(number));
+                handler_->value(number);
+                return true;
+            }
+            case Kind::String:
+            case Kind::Binary:
+                takeString(header.length);
+                handler_->value(scratch_);
+                return true;
+            case Kind::Array:
+                handler_->startArray();
+                if (header.length == 0) {
+                    handler_->endArray();
+                    return true;
+                }
+                push(header.length, false);
+                return false;
+            case Kind::Map:
+                handler_->startObject();
+                if (header.length == 0) {
+                    handler_->endObject();
+                    return true;
+                }
+                push(header.length, true);
+                return false;
+        }
+        return true;
+    }
+
+    void parseKey() {
+        if (p_ == end_) {
+            fail("Unexpected end of MessagePack document");
+        }
+        const Header header = readChecked();
+        if (header.kind != Kind::String) {
+            fail("Expected string object key");
+        }
+        takeString(header.length);
+        handler_->key(scratch_);
+        stack_.back().expectKey = false;
+    }
+
+    Header readChecked() {
+        const char* start = p_;
+        try {
+            return readHeader(p_, end_);
+        } catch (const Poco::JSON::JSONException& e) {
+            p_ = start;
+            fail(e.message().c_str());
+        }
+    }
+
+    // Длина уже проверена по концу входа: одно выделение и одно копирование
+    void takeString(Poco::UInt64 length) {
+        scratch_.assign(p_, static_cast<std::size_t>(length));
+        p_ += length;
+    }
+
+    void push(Poco::UInt64 length, bool object) {
+        if (maxDepth_ != 0 && stack_.size() >= maxDepth_) {
+            fail("Maximum MessagePack nesting depth exceeded");
+        }
+        stack_.push_back(Frame{length, object, object});
+    }
+
+    [[noreturn]] void fail(const char* message) const {
+        std::string text(message);
+        text += " at offset ";
+        text += std::to_string(static_cast<std::size_t>(p_ - begin_));
+        throw Poco::JSON::JSONException(text);
+    }
+
+    Poco::JSON::Handler::Ptr handler_;
+    std::size_t maxDepth_ = 0;
+    const char* begin_ = nullptr;
+    const char* p_ = nullptr;
+    const char* end_ = nullptr;
+    std::vector<Frame> stack_;        // открытые контейнеры
+    std::string scratch_;             // строка или ключ
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_MSGPACK_H
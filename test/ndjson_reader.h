@@ -0,0 +1,249 @@
+#ifndef POCO_TEST_APP_NDJSON_READER_H
+#define POCO_TEST_APP_NDJSON_READER_H
+
+// Параллельный разбор JSON Lines (NDJSON): одна запись JSON на строку.
+//
+// Файл отображается в память (Poco::SharedMemory) и делится на отрезки из
+// целых строк, по одному на поток. Каждый поток разбирает свои строки
+// собственным ReusableParser, так что общего состояния у потоков нет, кроме
+// номера отрезка с ошибкой.
+// Результаты собираются в порядке строк файла, либо вместо деревьев
+// накапливается только статистика (NdjsonStats).
+//
+// Пустые строки (и строки только из пробельных символов) пропускаются,
+// завершающий '\r' отбрасывается. Ошибка разбора записи останавливает
+// потоки с более поздними отрезками (они проверяют общий флаг перед каждой
+// строкой); более ранние отрезки дочитываются, чтобы найти первую ошибку.
+// Бросается JSONException с номером первой некорректной строки.
+
+#include "reusable_parser.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/SharedMemory.h>
+#include <Poco/File.h>
+#include <Poco/Exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace pocotest {
+
+// Делит data не более чем на parts отрезков примерно равного размера.
+// Каждый отрезок, кроме последнего, заканчивается сразу после '\n', так что
+// строки не разрываются; пустые отрезки не возвращаются
+inline std::vector<std::string_view> splitLines(std::string_view data, std::size_t parts) {
+    std::vector<std::string_view> chunks;
+    parts = std::max<std::size_t>(parts, 1);
+    const std::size_t target = data.size() / parts + 1;
+
+    std::size_t begin = 0;
+    while (begin < data.size()) {
+        std::size_t end = begin + target;
+        if (end >= data.size()) {
+            end = data.size();
+        } else {
+            const std::size_t newline = data.find('\n', end - 1);
+            end = newline == std::string_view::npos ? data.size() : newline + 1;
+        }
+        chunks.push_back(data.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+// Сводная статистика по записям
+struct NdjsonStats {
+    std::size_t records = 0;         // непустые строки
+    std::size_t blankLines = 0;
+    std::size_t bytes = 0;           // байт во всех строках, включая '\n'
+    std::size_t maxRecordBytes = 0;
+    std::size_t objects = 0;         // записи - объекты JSON
+    std::size_t members = 0;         // ключей верхнего уровня во всех объектах
+
+    void merge(const NdjsonStats& other) {
+        records += other.records;
+        blankLines += other.blankLines;
+        bytes += other.bytes;
+        maxRecordBytes = std::max(maxRecordBytes, other.maxRecordBytes);
+        objects += other.objects;
+        members += other.members;
+    }
+};
+
+class NdjsonReader {
+public:
+    // threads == 0 - по числу ядер
+    explicit NdjsonReader(unsigned threads = 0) {
+        setThreads(threads);
+    }
+
+    void setThreads(unsigned threads) {
+        threads_ = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    unsigned getThreads() const {
+        return threads_;
+    }
+
+    // Разбирает все записи; результаты - в порядке строк
+    std::vector<Poco::Dynamic::Var> parse(std::string_view data) const {
+        std::vector<std::vector<Poco::Dynamic::Var>> parts;
+        run(data, parts, [](std::vector<Poco::Dynamic::Var>& out, NdjsonStats&, Poco::Dynamic::Var&& record) {
+            out.push_back(std::move(record));
+        });
+
+        std::size_t total = 0;
+        for (const auto& part : parts) {
+            total += part.size();
+        }
+        std::vector<Poco::Dynamic::Var> records;
+        records.reserve(total);
+        for (auto& part : parts) {
+            std::move(part.begin(), part.end(), std::back_inserter(records));
+        }
+        return records;
+    }
+
+    // Разбирает все записи, не сохраняя деревья
+    NdjsonStats stats(std::string_view data) const {
+        std::vector<std::vector<Poco::Dynamic::Var>> parts;
+        return run(data, parts, [](std::vector<Poco::Dynamic::Var>&, NdjsonStats& stats, Poco::Dynamic::Var&& record) {
+            if (record.type() == typeid(Poco::JSON::Object::Ptr)) {
+                ++stats.objects;
+                stats.members += record.extract<Poco::JSON::Object::Ptr>()->size();
+            }
+        });
+    }
+
+    // То же для файла, отображённого в память. Ошибки открытия - как у
+    // Poco::File (FileNotFoundException и т.п.)
+    std::vector<Poco::Dynamic::Var> parseFile(const std::string& path) const {
+        const Poco::File file(path);
+        if (file.getSize() == 0) {
+            return {};
+        }
+        const Poco::SharedMemory mapping(file, Poco::SharedMemory::AM_READ);
+        return parse(std::string_view(mapping.begin(), static_cast<std::size_t>(mapping.end() - mapping.begin())));
+    }
+
+    NdjsonStats statsFile(const std::string& path) const {
+        const Poco::File file(path);
+        if (file.getSize() == 0) {
+            return {};
+        }
+        const Poco::SharedMemory mapping(file, Poco::SharedMemory::AM_READ);
+        return stats(std::string_view(mapping.begin(), static_cast<std::size_t>(mapping.end() - mapping.begin())));
+    }
+
+private:
+    // Состояние одного потока: результаты, статистика и первая ошибка
+    struct Worker {
+        std::vector<Poco::Dynamic::Var> records;
+        NdjsonStats stats;
+        std::size_t lines = 0;        // строк до ошибки или всего в отрезке
+        bool failed = false;          // ошибка Poco с текстом message
+        std::string message;
+        std::exception_ptr error;     // любая другая ошибка
+    };
+
+    // Разбирает отрезок index; onRecord(records, stats, value) вызывается
+    // для каждой записи по порядку. failedChunk - наименьший номер отрезка
+    // с ошибкой (или chunks.size()); отрезки после него не дочитываются
+    template <typename OnRecord>
+    static void parseChunk(std::string_view data, std::size_t index, Worker& worker, OnRecord& onRecord,
+                           std::atomic<std::size_t>& failedChunk) {
+        ReusableParser parser;
+        std::string line;
+        const char* p = data.data();
+        const char* end = p + data.size();
+        try {
+            while (p != end && failedChunk.load(std::memory_order_relaxed) > index) {
+                const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+                const char* next = newline != nullptr ? newline + 1 : end;
+                const char* stop = newline != nullptr ? newline : end;
+                if (stop != p && stop[-1] == '\r') {
+                    --stop;
+                }
+                worker.stats.bytes += static_cast<std::size_t>(next - p);
+                if (std::all_of(p, stop, [](char c) { return c == ' ' || c == '\t' || c == '\r'; })) {
+                    ++worker.stats.blankLines;
+                } else {
+                    line.assign(p, stop);
+                    onRecord(worker.records, worker.stats, parser.parse(line));
+                    ++worker.stats.records;
+                    worker.stats.maxRecordBytes = std::max(worker.stats.maxRecordBytes, line.size());
+                }
+                ++worker.lines;
+                p = next;
+            }
+        } catch (const Poco::Exception& e) {
+            worker.failed = true;
+            worker.message = e.message().empty() ? e.displayText() : e.message();
+        } catch (...) {
+            worker.error = std::current_exception();
+        }
+        if (worker.failed || worker.error) {
+            std::size_t current = failedChunk.load();
+            while (current > index && !failedChunk.compare_exchange_weak(current, index)) {
+            }
+        }
+    }
+
+    template <typename OnRecord>
+    NdjsonStats run(std::string_view data, std::vector<std::vector<Poco::Dynamic::Var>>& parts,
+                    OnRecord onRecord) const {
+        const std::vector<std::string_view> chunks = splitLines(data, threads_);
+        std::vector<Worker> workers(chunks.size());
+        std::atomic<std::size_t> failedChunk(chunks.size());
+        if (chunks.size() == 1) {
+            parseChunk(chunks[0], 0, workers[0], onRecord, failedChunk);
+        } else {
+            std::vector<std::thread> threads;
+            threads.reserve(chunks.size());
+            for (std::size_t i = 0; i < chunks.size(); ++i) {
+                threads.emplace_back([&, i]() {
+                    parseChunk(chunks[i], i, workers[i], onRecord, failedChunk);
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        // Отрезки до первой ошибки разобраны целиком, поэтому номер строки
+        // считается по их числу строк; недочитанные отрезки идут после неё
+        NdjsonStats stats;
+        std::size_t lines = 0;
+        parts.reserve(workers.size());
+        for (auto& worker : workers) {
+            if (worker.error) {
+                std::rethrow_exception(worker.error);
+            }
+            if (worker.failed) {
+                throw Poco::JSON::JSONException("Line " + std::to_string(lines + worker.lines + 1), worker.message);
+            }
+            lines += worker.lines;
+            stats.merge(worker.stats);
+            parts.push_back(std::move(worker.records));
+        }
+        return stats;
+    }
+
+    unsigned threads_ = 1;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_NDJSON_READER_H
@@ -0,0 +1,316 @@
+#ifndef POCO_TEST_APP_QUERY_PLAN_H
+#define POCO_TEST_APP_QUERY_PLAN_H
+
+// Путь Poco::JSON::Query, разобранный один раз.
+//
+// Query::find() на каждый вызов заново режет путь на сегменты, компилирует
+// регулярное выражение для индексов и копирует встреченные по пути Object и
+// Array, переданные по значению. QueryPlan разбирает путь в конструкторе
+// (имена ключей и индексы массивов) и применяется к любому числу корней.
+// Результат find() совпадает с Query(root).find(path), включая особенности
+// Poco: индекс у не-массива игнорируется, а ключ у не-объекта даёт пустое
+// значение.
+//
+// Дополнительно поддерживаются подстановки: сегмент "*" - все значения
+// объекта (в порядке обхода Object), индекс "[*]" - все элементы массива.
+// find() возвращает первое совпадение, findAll() - все непустые.
+//
+// Планы неизменяемы, так что один план можно применять из нескольких
+// потоков. QueryPlanCache хранит скомпилированные планы по строке пути.
+
+#include "json_number.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Mutex.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace pocotest {
+
+class QueryPlan {
+public:
+    explicit QueryPlan(const std::string& path)
+        : path_(path) {
+        compile();
+    }
+
+    const std::string& path() const {
+        return path_;
+    }
+
+    bool hasWildcards() const {
+        return wildcards_;
+    }
+
+    // Первое совпадение или пустое значение, как Query::find
+    Poco::Dynamic::Var find(const Poco::Dynamic::Var& root) const {
+        if (!wildcards_) {
+            return walk(root);
+        }
+        Poco::Dynamic::Var result;
+        visit(root, 0, [&](const Poco::Dynamic::Var& match) {
+            result = match;
+            return false;
+        });
+        return result;
+    }
+
+    // Дописывает в out все непустые совпадения; возвращает их число
+    std::size_t findAll(const Poco::Dynamic::Var& root, std::vector<Poco::Dynamic::Var>& out) const {
+        const std::size_t before = out.size();
+        if (!wildcards_) {
+            Poco::Dynamic::Var result = walk(root);
+            if (!result.isEmpty()) {
+                out.push_back(std::move(result));
+            }
+        } else {
+            visit(root, 0, [&](const Poco::Dynamic::Var& match) {
+                out.push_back(match);
+                return true;
+            });
+        }
+        return out.size() - before;
+    }
+
+    Poco::JSON::Object::Ptr findObject(const Poco::Dynamic::Var& root) const {
+        const Poco::Dynamic::Var result = find(root);
+        if (result.type() == typeid(Poco::JSON::Object::Ptr)) {
+            return result.extract<Poco::JSON::Object::Ptr>();
+        } else if (result.type() == typeid(Poco::JSON::Object)) {
+            return new Poco::JSON::Object(result.extract<Poco::JSON::Object>());
+        }
+        return nullptr;
+    }
+
+    Poco::JSON::Array::Ptr findArray(const Poco::Dynamic::Var& root) const {
+        const Poco::Dynamic::Var result = find(root);
+        if (result.type() == typeid(Poco::JSON::Array::Ptr)) {
+            return result.extract<Poco::JSON::Array::Ptr>();
+        } else if (result.type() == typeid(Poco::JSON::Array)) {
+            return new Poco::JSON::Array(result.extract<Poco::JSON::Array>());
+        }
+        return nullptr;
+    }
+
+    // Как Query::findValue: def, если значения нет или оно не приводится к T
+    template <typename T>
+    T findValue(const Poco::Dynamic::Var& root, const T& def) const {
+        T result = def;
+        const Poco::Dynamic::Var value = find(root);
+        if (!value.isEmpty()) {
+            try {
+                result = number::convertValue<T>(value);
+            } catch (...) {
+            }
+        }
+        return result;
+    }
+
+    std::string findValue(const Poco::Dynamic::Var& root, const char* def) const {
+        return findValue<std::string>(root, def);
+    }
+
+private:
+    static constexpr std::size_t ANY = static_cast<std::size_t>(-1);  // "*" / "[*]"
+
+    struct Segment {
+        std::string name;               // пусто - сегмент из одних индексов
+        bool anyMember = false;         // "*"
+        std::vector<std::size_t> indexes;
+    };
+
+    // Разбивает путь так же, как Query::find: сегменты через '.', индексы -
+    // все вхождения "[digits]" в сегменте, имя - текст до первого из них
+    void compile() {
+        std::size_t begin = 0;
+        for (;;) {
+            const std::size_t dot = path_.find('.', begin);
+            const std::string token = path_.substr(begin, dot == std::string::npos ? std::string::npos : dot - begin);
+            Segment segment;
+            std::size_t first = std::string::npos;
+            for (std::size_t pos = 0; pos < token.size(); ++pos) {
+                if (token[pos] != '[') {
+                    continue;
+                }
+                std::size_t close = pos + 1;
+                if (token.compare(close, 2, "*]") == 0) {
+                    segment.indexes.push_back(ANY);
+                    wildcards_ = true;
+                    close += 1;
+                } else {
+                    while (close < token.size() && token[close] >= '0' && token[close] <= '9') {
+                        ++close;
+                    }
+                    if (close == pos + 1 || close == token.size() || token[close] != ']') {
+                        continue;
+                    }
+                    segment.indexes.push_back(static_cast<unsigned>(
+                        Poco::NumberParser::parse(token.substr(pos + 1, close - pos - 1))));
+                }
+                if (first == std::string::npos) {
+                    first = pos;
+                }
+                pos = close;
+            }
+            segment.name = token.substr(0, first);
+            if (segment.name == "*") {
+                segment.anyMember = true;
+                wildcards_ = true;
+            }
+            // Пустой сегмент без индексов (например, "a..b") ничего не делает
+            if (!segment.name.empty() || !segment.indexes.empty()) {
+                segments_.push_back(std::move(segment));
+            }
+            if (dot == std::string::npos) {
+                break;
+            }
+            begin = dot + 1;
+        }
+    }
+
+    // Значение ключа name или пустое значение, если node - не объект
+    static Poco::Dynamic::Var member(const Poco::Dynamic::Var& node, const std::string& name) {
+        if (node.type() == typeid(Poco::JSON::Object::Ptr)) {
+            return node.extract<Poco::JSON::Object::Ptr>()->get(name);
+        } else if (node.type() == typeid(Poco::JSON::Object)) {
+            return node.extract<Poco::JSON::Object>().get(name);
+        }
+        return Poco::Dynamic::Var();
+    }
+
+    // Массив или nullptr, если node - не массив
+    static const Poco::JSON::Array* asArray(const Poco::Dynamic::Var& node) {
+        if (node.type() == typeid(Poco::JSON::Array::Ptr)) {
+            return node.extract<Poco::JSON::Array::Ptr>().get();
+        } else if (node.type() == typeid(Poco::JSON::Array)) {
+            return &node.extract<Poco::JSON::Array>();
+        }
+        return nullptr;
+    }
+
+    // Путь без подстановок: тот же порядок шагов, что в Query::find
+    Poco::Dynamic::Var walk(const Poco::Dynamic::Var& root) const {
+        Poco::Dynamic::Var result = root;
+        for (const Segment& segment : segments_) {
+            if (result.isEmpty()) {
+                break;
+            }
+            if (!segment.name.empty()) {
+                result = member(result, segment.name);
+            }
+            for (std::size_t index : segment.indexes) {
+                if (result.isEmpty()) {
+                    break;
+                }
+                if (const Poco::JSON::Array* array = asArray(result)) {
+                    result = array->get(static_cast<unsigned>(index));
+                }
+            }
+        }
+        return result;
+    }
+
+    // Обход с подстановками; onMatch(value) возвращает false, чтобы
+    // остановить обход. Возвращает false, если обход остановлен
+    template <typename OnMatch>
+    bool visit(const Poco::Dynamic::Var& node, std::size_t segment, OnMatch&& onMatch) const {
+        if (node.isEmpty()) {
+            return true;
+        }
+        if (segment == segments_.size()) {
+            return onMatch(node);
+        }
+        const Segment& current = segments_[segment];
+        if (current.anyMember) {
+            if (node.type() == typeid(Poco::JSON::Object::Ptr)) {
+                for (const auto& entry : *node.extract<Poco::JSON::Object::Ptr>()) {
+                    if (!visitIndexes(entry.second, segment, 0, onMatch)) {
+                        return false;
+                    }
+                }
+            } else if (node.type() == typeid(Poco::JSON::Object)) {
+                for (const auto& entry : node.extract<Poco::JSON::Object>()) {
+                    if (!visitIndexes(entry.second, segment, 0, onMatch)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        if (!current.name.empty()) {
+            return visitIndexes(member(node, current.name), segment, 0, onMatch);
+        }
+        return visitIndexes(node, segment, 0, onMatch);
+    }
+
+    template <typename OnMatch>
+    bool visitIndexes(const Poco::Dynamic::Var& node, std::size_t segment, std::size_t index,
+                      OnMatch&& onMatch) const {
+        const std::vector<std::size_t>& indexes = segments_[segment].indexes;
+        if (index == indexes.size() || node.isEmpty()) {
+            return visit(node, segment + 1, onMatch);
+        }
+        const Poco::JSON::Array* array = asArray(node);
+        if (array == nullptr) {
+            // Как в Query::find: индекс у не-массива пропускается
+            return visitIndexes(node, segment, index + 1, onMatch);
+        }
+        if (indexes[index] != ANY) {
+            return visitIndexes(array->get(static_cast<unsigned>(indexes[index])), segment, index + 1, onMatch);
+        }
+        for (const auto& element : *array) {
+            if (!visitIndexes(element, segment, index + 1, onMatch)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string path_;
+    std::vector<Segment> segments_;
+    bool wildcards_ = false;
+};
+
+// Скомпилированные планы по строке пути; безопасен для нескольких потоков
+class QueryPlanCache {
+public:
+    using PlanPtr = std::shared_ptr<const QueryPlan>;
+
+    // План для path; компилируется при первом обращении
+    PlanPtr get(const std::string& path) {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        auto it = plans_.find(path);
+        if (it != plans_.end()) {
+            return it->second;
+        }
+        PlanPtr plan = std::make_shared<const QueryPlan>(path);
+        plans_.emplace(path, plan);
+        return plan;
+    }
+
+    std::size_t size() const {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        return plans_.size();
+    }
+
+    void clear() {
+        Poco::FastMutex::ScopedLock lock(mutex_);
+        plans_.clear();
+    }
+
+private:
+    mutable Poco::FastMutex mutex_;
+    std::unordered_map<std::string, PlanPtr> plans_;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_QUERY_PLAN_H
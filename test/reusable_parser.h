@@ -0,0 +1,97 @@
+#ifndef POCO_TEST_APP_REUSABLE_PARSER_H
+#define POCO_TEST_APP_REUSABLE_PARSER_H
+
+// Парсер для разбора множества документов одним экземпляром.
+//
+// Poco::JSON::Parser открывает и закрывает поток pdjson на каждый вызов
+// parse(), но состояние обработчика (стек ParseHandler, текущий ключ,
+// результат) сбрасывается только явным Parser::reset(); после ошибки разбора
+// оно остаётся в промежуточном состоянии. Поэтому тесты создают новый Parser
+// на каждый документ. ReusableParser сбрасывает состояние перед каждым
+// разбором и после ошибки, так что один экземпляр можно использовать для
+// любой последовательности документов, в том числе некорректных. Сам Parser,
+// его ParseHandler и буфер для чтения из потока создаются один раз.
+
+#include "json_profile.h"
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/Dynamic/Var.h>
+
+#include <cstddef>
+#include <istream>
+#include <string>
+
+namespace pocotest {
+
+class ReusableParser {
+public:
+    explicit ReusableParser(bool preserveObjectOrder = false)
+        : handler_(new Poco::JSON::ParseHandler(preserveObjectOrder))
+        , parser_(handler_) {
+    }
+
+    ReusableParser(const ReusableParser&) = delete;
+    ReusableParser& operator=(const ReusableParser&) = delete;
+
+    // Разбирает документ; при ошибке бросает исключение Poco, оставляя парсер
+    // готовым к следующему документу
+    Poco::Dynamic::Var parse(const std::string& json) {
+        POCO_TEST_APP_PROFILE_SCOPE(Parse);
+        parser_.reset();
+        try {
+            Poco::Dynamic::Var result = parser_.parse(json);
+            // Результат уже принадлежит вызывающему; обработчик не должен
+            // удерживать ссылки на дерево до следующего разбора
+            parser_.reset();
+            ++documents_;
+            return result;
+        } catch (...) {
+            parser_.reset();
+            ++errors_;
+            throw;
+        }
+    }
+
+    // Читает поток целиком в сохраняемый между вызовами буфер и разбирает его
+    Poco::Dynamic::Var parse(std::istream& in) {
+        buffer_.clear();
+        char chunk[8192];
+        while (in.read(chunk, sizeof(chunk)) || in.gcount() > 0) {
+            buffer_.append(chunk, static_cast<std::size_t>(in.gcount()));
+        }
+        return parse(buffer_);
+    }
+
+    // Явный сброс: после него парсер эквивалентен только что созданному
+    void reset() {
+        parser_.reset();
+    }
+
+    Poco::JSON::Parser& parser() {
+        return parser_;
+    }
+
+    std::size_t documents() const {
+        return documents_;
+    }
+
+    std::size_t errors() const {
+        return errors_;
+    }
+
+    std::size_t bufferCapacity() const {
+        return buffer_.capacity();
+    }
+
+private:
+    Poco::JSON::Handler::Ptr handler_;
+    Poco::JSON::Parser parser_;
+    std::string buffer_;
+    std::size_t documents_ = 0;
+    std::size_t errors_ = 0;
+};
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_REUSABLE_PARSER_H
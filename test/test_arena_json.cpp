@@ -0,0 +1,208 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Exception.h>
+
+#include "arena_json.h"
+#include "key_pool.h"
+#include "json_cases.h"
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::ArenaDocument;
+using pocotest::ArenaParser;
+using pocotest::ArenaValue;
+using pocotest::KeyPool;
+using pocotest::condensed;
+
+namespace {
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ArenaJSONTests)
+
+// Дерево из арены должно совпадать с деревом обычного ParseHandler
+BOOST_AUTO_TEST_CASE(TestArenaMatchesParseHandler) {
+    const std::vector<std::string> documents = {
+        "{}",
+        "[]",
+        R"({"company": "Poco", "active": true, "count": 42, "ratio": 0.5, "none": null})",
+        R"([1, -2, 3.25, "four", false, null, [], {}])",
+        R"({"menu": {"id": "file", "menuitem": [{"value": "New"}, {"value": "Open", "extra": [1, [2, [3]]]}]}})",
+        R"({"escaped": "line\nbreak \"quoted\" back\\slash ©"})",
+        R"({"max_int64": 9223372036854775807, "min_int64": -9223372036854775808, "big": 18446744073709551615})",
+    };
+
+    ArenaParser arena_parser;
+    for (const auto& json_str : documents) {
+        BOOST_TEST_CONTEXT("JSON: " << json_str) {
+            Parser parser;
+            Poco::Dynamic::Var expected = parser.parse(json_str);
+
+            ArenaDocument doc = arena_parser.parse(json_str);
+            BOOST_CHECK_EQUAL(condensed(doc.root().toVar()), condensed(expected));
+        }
+    }
+}
+
+// Тестируем доступ к узлам дерева из арены
+BOOST_AUTO_TEST_CASE(TestArenaAccessors) {
+    ArenaParser parser;
+    ArenaDocument doc = parser.parse(
+        R"({"name": "Alice", "age": 30, "score": 4.5, "student": false, "tags": ["a", "b"], "address": {"city": "Paris"}, "nothing": null})");
+
+    const ArenaValue& root = doc.root();
+    BOOST_REQUIRE(root.isObject());
+    BOOST_CHECK_EQUAL(root.size(), 7u);
+
+    BOOST_REQUIRE(root.find("name"));
+    BOOST_CHECK_EQUAL(root.find("name")->asString(), "Alice");
+    BOOST_CHECK_EQUAL(root.find("age")->asInt64(), 30);
+    BOOST_CHECK_EQUAL(root.find("age")->asDouble(), 30.0);
+    BOOST_CHECK_EQUAL(root.find("score")->asDouble(), 4.5);
+    BOOST_CHECK_EQUAL(root.find("student")->asBool(), false);
+    BOOST_CHECK(root.find("nothing")->isNull());
+    BOOST_CHECK(root.find("missing") == nullptr);
+
+    const ArenaValue* tags = root.find("tags");
+    BOOST_REQUIRE(tags && tags->isArray());
+    BOOST_CHECK_EQUAL(tags->size(), 2u);
+    BOOST_CHECK_EQUAL(tags->at(1).asString(), "b");
+    BOOST_CHECK_THROW(tags->at(2), Poco::RangeException);
+
+    const ArenaValue* address = root.find("address");
+    BOOST_REQUIRE(address && address->isObject());
+    BOOST_CHECK_EQUAL(address->keyAt(0), "city");
+    BOOST_CHECK_EQUAL(address->valueAt(0).asString(), "Paris");
+
+    // Обращение к узлу как к значению другого типа
+    BOOST_CHECK_THROW(root.find("name")->asInt64(), Poco::BadCastException);
+    BOOST_CHECK_THROW(root.find("age")->asString(), Poco::BadCastException);
+    BOOST_CHECK_THROW(root.at(0), Poco::BadCastException);
+}
+
+// Повторяющиеся ключи: как и в Poco::JSON::Object, действует последний
+BOOST_AUTO_TEST_CASE(TestArenaDuplicateKeys) {
+    ArenaParser parser;
+    ArenaDocument doc = parser.parse(R"({"key": 1, "key": 2})");
+    BOOST_REQUIRE(doc.root().find("key"));
+    BOOST_CHECK_EQUAL(doc.root().find("key")->asInt64(), 2);
+}
+
+// Документы, полученные одним парсером, независимы друг от друга
+BOOST_AUTO_TEST_CASE(TestArenaDocumentsIndependent) {
+    ArenaParser parser;
+    ArenaDocument first = parser.parse(R"({"id": 1, "name": "first"})");
+    ArenaDocument second = parser.parse(R"({"id": 2, "name": "second", "list": [1, 2, 3]})");
+
+    BOOST_CHECK_EQUAL(first.root().find("name")->asString(), "first");
+    BOOST_CHECK_EQUAL(second.root().find("name")->asString(), "second");
+    BOOST_CHECK(first.arenaBytes() > 0);
+    BOOST_CHECK(second.arenaBytes() > first.arenaBytes());
+
+    // Перемещение документа не меняет адреса узлов в арене
+    const ArenaValue* list = second.root().find("list");
+    ArenaDocument moved = std::move(second);
+    BOOST_CHECK_EQUAL(moved.root().find("list"), list);
+    BOOST_CHECK_EQUAL(list->at(2).asInt64(), 3);
+}
+
+// Парсер в режиме арены остаётся работоспособным после ошибки
+BOOST_AUTO_TEST_CASE(TestArenaParseErrors) {
+    ArenaParser parser;
+    const std::vector<std::string> invalid_json_cases = {
+        "{", "[", "{\"key\": }", "[\"item\", ]", "{\"a\": [1, {\"b\": ", ""
+    };
+
+    for (const auto& json_str : invalid_json_cases) {
+        BOOST_TEST_CONTEXT("Invalid JSON: " << json_str) {
+            BOOST_CHECK_THROW(parser.parse(json_str), Poco::Exception);
+            ArenaDocument doc = parser.parse(R"({"ok": [true]})");
+            BOOST_REQUIRE(doc.root().isObject());
+            BOOST_CHECK_EQUAL(doc.root().size(), 1u);
+            BOOST_CHECK_EQUAL(doc.root().find("ok")->at(0).asBool(), true);
+        }
+    }
+}
+
+// Большой документ: 100 ключей, как в TestMemoryAndPerformance
+BOOST_AUTO_TEST_CASE(TestArenaWideObject) {
+    Object::Ptr large_obj = new Object();
+    for (int j = 0; j < 100; ++j) {
+        large_obj->set("key_" + std::to_string(j), "value_" + std::to_string(j));
+    }
+    std::stringstream ss;
+    large_obj->stringify(ss);
+
+    ArenaParser parser;
+    ArenaDocument doc = parser.parse(ss.str());
+    BOOST_CHECK_EQUAL(doc.root().size(), 100u);
+    for (int j = 0; j < 100; j += 7) {
+        const ArenaValue* value = doc.root().find("key_" + std::to_string(j));
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->asString(), "value_" + std::to_string(j));
+    }
+}
+
+// С общим пулом ключи документов указывают в пул и не занимают арену
+BOOST_AUTO_TEST_CASE(TestArenaSharedKeyPool) {
+    const std::string json = R"({"id": 1, "name": "n", "nested": {"id": 2, "tags": ["id"]}})";
+    ArenaParser copying;
+    const std::size_t copiedBytes = copying.parse(json).arenaBytes();
+
+    KeyPool::Ptr pool = new KeyPool();
+    ArenaParser first;
+    ArenaParser second;
+    first.setKeyPool(pool);
+    second.setKeyPool(pool);
+    BOOST_CHECK(first.getKeyPool() == pool);
+
+    ArenaDocument a = first.parse(json);
+    ArenaDocument b = second.parse(json);
+    BOOST_CHECK_EQUAL(condensed(a.root().toVar()), condensed(copying.parse(json).root().toVar()));
+    BOOST_CHECK_LT(a.arenaBytes(), copiedBytes);
+    BOOST_CHECK_EQUAL(pool->size(), 4u);
+
+    // Один и тот же ключ во всех документах - одна копия в пуле
+    const std::string_view id = pool->find("id");
+    BOOST_REQUIRE(id.data() != nullptr);
+    BOOST_CHECK_EQUAL(a.root().keyAt(0).data(), id.data());
+    BOOST_CHECK_EQUAL(b.root().keyAt(0).data(), id.data());
+    BOOST_CHECK_EQUAL(b.root().find("nested")->keyAt(0).data(), id.data());
+    BOOST_CHECK_EQUAL(a.root().find(id)->asInt64(), 1);
+    BOOST_CHECK_EQUAL(b.root().find("nested")->find(id)->asInt64(), 2);
+    // Повтор схемы и документ с другим порядком ключей тем же парсером
+    ArenaDocument again = first.parse(json);
+    BOOST_CHECK_EQUAL(again.root().find("nested")->keyAt(1).data(), pool->find("tags").data());
+    ArenaDocument reordered = first.parse(R"({"name": "r", "extra": 0, "id": 3})");
+    BOOST_CHECK_EQUAL(reordered.root().keyAt(0).data(), pool->find("name").data());
+    BOOST_CHECK_EQUAL(reordered.root().find(id)->asInt64(), 3);
+    BOOST_CHECK_EQUAL(pool->size(), 5u);
+    // Строковые значения не интернируются
+    BOOST_CHECK(b.root().find("nested")->find("tags")->at(0).asString().data() != id.data());
+
+    // Документ держит пул живым
+    pool.reset();
+    first.setKeyPool(nullptr);
+    second.setKeyPool(nullptr);
+    BOOST_CHECK_EQUAL(a.root().keyAt(1), "name");
+    BOOST_CHECK_EQUAL(b.root().find("nested")->keyAt(1), "tags");
+
+    // Ключи, не принятые пулом, копируются в арену как обычно
+    ArenaParser limited;
+    limited.setKeyPool(new KeyPool(1));
+    ArenaDocument c = limited.parse(json);
+    BOOST_CHECK_EQUAL(condensed(c.root().toVar()), condensed(a.root().toVar()));
+    BOOST_CHECK_EQUAL(limited.getKeyPool()->stats().rejected, 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
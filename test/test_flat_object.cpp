@@ -0,0 +1,171 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSONString.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Exception.h>
+
+#include "flat_object.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::FlatObject;
+
+namespace {
+
+std::string keyFor(int i) {
+    return "key_" + std::to_string(i);
+}
+
+std::vector<std::string> memberNames(const FlatObject& object) {
+    std::vector<std::string> names;
+    for (const auto& member : object) {
+        names.push_back(member.first);
+    }
+    return names;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FlatObjectTests)
+
+// Поиск одинаков в обоих режимах индекса и при переходе между ними
+BOOST_AUTO_TEST_CASE(TestLookupAcrossSizes) {
+    for (std::size_t smallLimit : {std::size_t(0), std::size_t(8), FlatObject::DEFAULT_SMALL_LIMIT}) {
+        FlatObject flat(smallLimit);
+        Object reference;
+        for (int i = 0; i < 300; ++i) {
+            flat.set(keyFor(i), i);
+            reference.set(keyFor(i), i);
+            BOOST_REQUIRE_EQUAL(flat.size(), reference.size());
+            BOOST_CHECK_EQUAL(flat.isHashed(), flat.size() > smallLimit);
+            for (int j = 0; j <= i + 1; j += 7) {
+                BOOST_CHECK_EQUAL(flat.has(keyFor(j)), reference.has(keyFor(j)));
+            }
+        }
+        for (int i = 0; i < 300; ++i) {
+            BOOST_REQUIRE(flat.find(keyFor(i)) != nullptr);
+            BOOST_CHECK_EQUAL(flat.getValue<int>(keyFor(i)), reference.getValue<int>(keyFor(i)));
+        }
+        BOOST_CHECK(flat.find("key_300") == nullptr);
+        BOOST_CHECK(flat.find("") == nullptr);
+        BOOST_CHECK(flat.get("missing").isEmpty());
+    }
+}
+
+// Обход в порядке вставки; повторный set не двигает ключ
+BOOST_AUTO_TEST_CASE(TestInsertionOrder) {
+    std::mt19937 rng(13);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 200; ++i) {
+        keys.push_back(keyFor(i));
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    FlatObject flat;
+    for (const auto& key : keys) {
+        flat.set(key, key.size());
+    }
+    BOOST_CHECK(memberNames(flat) == keys);
+    BOOST_CHECK(flat.getNames() == keys);
+
+    flat.set(keys[5], "replaced");
+    BOOST_CHECK(memberNames(flat) == keys);
+    BOOST_CHECK_EQUAL(flat.getValue<std::string>(keys[5]), "replaced");
+    BOOST_CHECK_EQUAL(flat.size(), keys.size());
+}
+
+// remove() сохраняет порядок остальных ключей и возвращает малый режим
+BOOST_AUTO_TEST_CASE(TestRemove) {
+    FlatObject flat(12);
+    std::vector<std::string> expected;
+    for (int i = 0; i < 20; ++i) {
+        flat.set(keyFor(i), i);
+        expected.push_back(keyFor(i));
+    }
+    BOOST_CHECK(flat.isHashed());
+
+    for (int i = 0; i < 20; i += 2) {
+        flat.remove(keyFor(i));
+        expected.erase(std::find(expected.begin(), expected.end(), keyFor(i)));
+        BOOST_CHECK(!flat.has(keyFor(i)));
+        BOOST_CHECK(memberNames(flat) == expected);
+    }
+    BOOST_CHECK_EQUAL(flat.size(), 10u);
+    BOOST_CHECK(!flat.isHashed());
+    for (int i = 1; i < 20; i += 2) {
+        BOOST_CHECK_EQUAL(flat.getValue<int>(keyFor(i)), i);
+    }
+
+    flat.remove("missing");
+    BOOST_CHECK_EQUAL(flat.size(), 10u);
+    flat.set(keyFor(0), 0);
+    BOOST_CHECK_EQUAL(flat.getNames().back(), keyFor(0));
+
+    flat.clear();
+    BOOST_CHECK_EQUAL(flat.size(), 0u);
+    BOOST_CHECK(!flat.has(keyFor(1)));
+}
+
+// get/getValue/isNull ведут себя как у Object
+BOOST_AUTO_TEST_CASE(TestValueAccessMatchesObject) {
+    Object reference;
+    FlatObject flat;
+    reference.set("name", "Alice");
+    reference.set("age", 30);
+    reference.set("ratio", 0.5);
+    reference.set("active", true);
+    reference.set("nothing", Poco::Dynamic::Var());
+    flat.set("name", "Alice");
+    flat.set("age", 30);
+    flat.set("ratio", 0.5);
+    flat.set("active", true);
+    flat.set("nothing", Poco::Dynamic::Var());
+
+    BOOST_CHECK_EQUAL(flat.getValue<std::string>("name"), reference.getValue<std::string>("name"));
+    BOOST_CHECK_EQUAL(flat.getValue<int>("age"), reference.getValue<int>("age"));
+    BOOST_CHECK_EQUAL(flat.getValue<std::string>("age"), reference.getValue<std::string>("age"));
+    BOOST_CHECK_EQUAL(flat.getValue<double>("ratio"), reference.getValue<double>("ratio"));
+    BOOST_CHECK_EQUAL(flat.getValue<bool>("active"), reference.getValue<bool>("active"));
+    BOOST_CHECK_EQUAL(flat.isNull("nothing"), reference.isNull("nothing"));
+    BOOST_CHECK_EQUAL(flat.isNull("missing"), reference.isNull("missing"));
+    BOOST_CHECK_EQUAL(flat.isNull("name"), reference.isNull("name"));
+
+    BOOST_CHECK_THROW(reference.getValue<int>("missing"), Poco::InvalidAccessException);
+    BOOST_CHECK_THROW(flat.getValue<int>("missing"), Poco::InvalidAccessException);
+
+    // find() отдаёт хранимое значение, его можно менять на месте
+    Poco::Dynamic::Var* age = flat.find("age");
+    BOOST_REQUIRE(age != nullptr);
+    *age = 31;
+    BOOST_CHECK_EQUAL(flat.getValue<int>("age"), 31);
+}
+
+// Преобразование в Object и обратно сохраняет порядок ключей
+BOOST_AUTO_TEST_CASE(TestObjectRoundTrip) {
+    Object ordered(Poco::JSON_PRESERVE_KEY_ORDER);
+    for (int i = 99; i >= 0; --i) {
+        ordered.set(keyFor(i), i * 2);
+    }
+    Array::Ptr nested = new Array();
+    nested->add(1);
+    ordered.set("nested", nested);
+
+    const FlatObject::Ptr flat = FlatObject::fromObject(ordered);
+    BOOST_CHECK_EQUAL(flat->size(), ordered.size());
+    BOOST_CHECK(flat->getNames() == ordered.getNames());
+    BOOST_CHECK_EQUAL(flat->getValue<int>("key_7"), 14);
+    BOOST_CHECK(flat->get("nested").extract<Array::Ptr>() == nested);
+
+    const Object::Ptr back = flat->toObject();
+    BOOST_CHECK(back->getNames() == ordered.getNames());
+    BOOST_CHECK_EQUAL(back->getValue<int>("key_99"), 198);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,332 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Exception.h>
+
+#include "bench_corpus.h"
+#include "json_binding.h"
+#include "json_cases.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::binding::JsonBinding;
+using pocotest::condensed;
+
+namespace {
+
+struct Metrics {
+    double cpu = 0.0;
+    double mem = 0.0;
+    int rps = 0;
+};
+
+// Запись large_document без attributes; поля по алфавиту
+struct Record {
+    std::string description;
+    int id = 0;
+    Metrics metrics;
+    std::string name;
+    std::vector<std::string> tags;
+};
+
+// Все поддерживаемые типы полей
+struct Sample {
+    bool flag = false;
+    int small = 7;
+    Poco::UInt64 big = 0;
+    std::uint8_t byte = 0;
+    double ratio = 0.5;
+    std::string text = "default";
+    std::optional<std::string> note;
+    std::optional<Metrics> extra;
+    std::vector<int> values;
+    std::vector<Metrics> history;
+    std::vector<std::vector<std::string>> matrix;
+};
+
+struct Empty {};
+
+bool operator==(const Metrics& a, const Metrics& b) {
+    return a.cpu == b.cpu && a.mem == b.mem && a.rps == b.rps;
+}
+
+bool operator==(const Record& a, const Record& b) {
+    return a.description == b.description && a.id == b.id && a.metrics == b.metrics && a.name == b.name
+        && a.tags == b.tags;
+}
+
+bool operator==(const Sample& a, const Sample& b) {
+    return a.flag == b.flag && a.small == b.small && a.big == b.big && a.byte == b.byte && a.ratio == b.ratio
+        && a.text == b.text && a.note == b.note && a.extra == b.extra && a.values == b.values
+        && a.history == b.history && a.matrix == b.matrix;
+}
+
+} // namespace
+
+namespace pocotest {
+namespace binding {
+
+template <>
+struct Schema<Metrics> {
+    static constexpr auto fields = std::make_tuple(
+        field("cpu", &Metrics::cpu), field("mem", &Metrics::mem), field("rps", &Metrics::rps));
+};
+
+template <>
+struct Schema<Record> {
+    static constexpr auto fields = std::make_tuple(
+        field("description", &Record::description), field("id", &Record::id), field("metrics", &Record::metrics),
+        field("name", &Record::name), field("tags", &Record::tags));
+};
+
+template <>
+struct Schema<Sample> {
+    static constexpr auto fields = std::make_tuple(
+        field("flag", &Sample::flag), field("small", &Sample::small), field("big", &Sample::big),
+        field("byte", &Sample::byte), field("ratio", &Sample::ratio), field("text", &Sample::text),
+        field("note", &Sample::note), field("extra", &Sample::extra), field("values", &Sample::values),
+        field("history", &Sample::history), field("matrix", &Sample::matrix));
+};
+
+template <>
+struct Schema<Empty> {
+    static constexpr auto fields = std::make_tuple();
+};
+
+} // namespace binding
+} // namespace pocotest
+
+namespace {
+
+Array::Ptr makeRecords(int count) {
+    std::mt19937 rng(20250101u);
+    return bench::makeLargeDocument(rng, count);
+}
+
+// Запись, заполненная из дерева через getValue, как в обработчиках
+Record fromTree(const Object& object) {
+    Record record;
+    record.description = object.getValue<std::string>("description");
+    record.id = object.getValue<int>("id");
+    const Object::Ptr metrics = object.getObject("metrics");
+    record.metrics.cpu = metrics->getValue<double>("cpu");
+    record.metrics.mem = metrics->getValue<double>("mem");
+    record.metrics.rps = metrics->getValue<int>("rps");
+    record.name = object.getValue<std::string>("name");
+    for (const auto& tag : *object.getArray("tags")) {
+        record.tags.push_back(tag.convert<std::string>());
+    }
+    return record;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonBindingTests)
+
+// Разбор в структуру совпадает с деревом и getValue; attributes, которых
+// нет в схеме, пропускаются вместе с вложенными значениями
+BOOST_AUTO_TEST_CASE(TestParseMatchesTree) {
+    const Array::Ptr records = makeRecords(50);
+    JsonBinding<Record> binding;
+    Record record;
+    for (std::size_t i = 0; i < records->size(); ++i) {
+        const Object::Ptr object = records->getObject(static_cast<unsigned>(i));
+        BOOST_TEST_CONTEXT("record " << i) {
+            binding.parse(condensed(object), record);
+            BOOST_CHECK(record == fromTree(*object));
+        }
+    }
+}
+
+// Тот же обработчик работает с Poco::JSON::Parser
+BOOST_AUTO_TEST_CASE(TestPocoParserWithBindingHandler) {
+    const Array::Ptr records = makeRecords(20);
+    JsonBinding<Record> binding;
+    Parser parser(binding.handler());
+    Record record;
+    binding.handler()->setTarget(&record);
+    for (std::size_t i = 0; i < records->size(); ++i) {
+        const Object::Ptr object = records->getObject(static_cast<unsigned>(i));
+        BOOST_TEST_CONTEXT("record " << i) {
+            parser.reset();
+            const Poco::Dynamic::Var result = parser.parse(condensed(object));
+            BOOST_CHECK(result.isEmpty());
+            BOOST_CHECK(record == fromTree(*object));
+        }
+    }
+
+    // Корень-массив записей
+    std::vector<Record> all;
+    JsonBinding<std::vector<Record>> list;
+    list.parse(condensed(records), all);
+    BOOST_REQUIRE_EQUAL(all.size(), records->size());
+    BOOST_CHECK(all.back() == fromTree(*records->getObject(static_cast<unsigned>(records->size() - 1))));
+}
+
+// Все типы полей, null у optional, пропуск неизвестных ключей на любой
+// глубине, последний из повторяющихся ключей
+BOOST_AUTO_TEST_CASE(TestFieldTypes) {
+    JsonBinding<Sample> binding;
+    const Sample sample = binding.parse(R"({
+        "flag": true, "small": -42, "big": 18446744073709551615, "byte": 255, "ratio": 3,
+        "text": "a\"b\\cé", "note": null, "extra": {"cpu": 1.5, "skip": {"a": [1, {"b": []}]}, "rps": 2},
+        "unknown": [{"x": [1, 2, {"y": null}]}, "z"], "values": [1, 2, 3],
+        "history": [{}, {"mem": 0.25}], "matrix": [[], ["a", "b"]], "small": -43, "other": 1})");
+
+    BOOST_CHECK(sample.flag);
+    BOOST_CHECK_EQUAL(sample.small, -43);
+    BOOST_CHECK_EQUAL(sample.big, std::numeric_limits<Poco::UInt64>::max());
+    BOOST_CHECK_EQUAL(static_cast<int>(sample.byte), 255);
+    BOOST_CHECK_EQUAL(sample.ratio, 3.0);
+    BOOST_CHECK_EQUAL(sample.text, "a\"b\\c\xC3\xA9");
+    BOOST_CHECK(!sample.note);
+    BOOST_REQUIRE(sample.extra);
+    BOOST_CHECK_EQUAL(sample.extra->cpu, 1.5);
+    BOOST_CHECK_EQUAL(sample.extra->mem, 0.0);
+    BOOST_CHECK_EQUAL(sample.extra->rps, 2);
+    BOOST_CHECK(sample.values == std::vector<int>({1, 2, 3}));
+    BOOST_REQUIRE_EQUAL(sample.history.size(), 2u);
+    BOOST_CHECK(sample.history[0] == Metrics());
+    BOOST_CHECK_EQUAL(sample.history[1].mem, 0.25);
+    BOOST_REQUIRE_EQUAL(sample.matrix.size(), 2u);
+    BOOST_CHECK(sample.matrix[0].empty());
+    BOOST_CHECK(sample.matrix[1] == std::vector<std::string>({"a", "b"}));
+
+    const Sample note = binding.parse(R"({"note": "x", "extra": null})");
+    BOOST_CHECK(note.note == std::optional<std::string>("x"));
+    BOOST_CHECK(!note.extra);
+
+    JsonBinding<Empty> empty;
+    empty.parse(R"({"a": 1, "b": {"c": [2]}})");
+    std::string out;
+    empty.stringify(Empty(), out);
+    BOOST_CHECK_EQUAL(out, "{}");
+}
+
+// Разбор в заполненную структуру даёт тот же результат, что в новую:
+// отсутствующие поля получают значения по умолчанию
+BOOST_AUTO_TEST_CASE(TestReuseResetsMissingFields) {
+    JsonBinding<Sample> binding;
+    Sample sample = binding.parse(R"({"flag": true, "small": 1, "text": "x", "note": "n", "extra": {"rps": 5},
+                                      "values": [1], "history": [{"rps": 1}], "matrix": [["m"]]})");
+    binding.parse(R"({"ratio": 2.5, "extra": {"cpu": 1}})", sample);
+
+    Sample expected;
+    expected.ratio = 2.5;
+    expected.extra = Metrics();
+    expected.extra->cpu = 1.0;
+    BOOST_CHECK(sample == expected);
+
+    binding.parse("{}", sample);
+    BOOST_CHECK(sample == Sample());
+}
+
+// Несовпадение типа и выход за диапазон - JSONException с именем поля;
+// после ошибки JsonBinding пригоден для следующего документа
+BOOST_AUTO_TEST_CASE(TestTypeErrors) {
+    JsonBinding<Sample> binding;
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {R"({"flag": 1})", "field 'flag': expected boolean, got integer"},
+        {R"({"small": "1"})", "field 'small': expected integer, got string"},
+        {R"({"small": 1.5})", "field 'small': expected integer, got number"},
+        {R"({"small": 2147483648})", "field 'small': integer 2147483648 out of range"},
+        {R"({"byte": 256})", "field 'byte': integer 256 out of range"},
+        {R"({"byte": -1})", "field 'byte': integer -1 out of range"},
+        {R"({"big": -1})", "field 'big': integer -1 out of range"},
+        {R"({"ratio": true})", "field 'ratio': expected number, got boolean"},
+        {R"({"text": null})", "field 'text': expected string, got null"},
+        {R"({"values": {}})", "field 'values': expected array, got object"},
+        {R"({"values": [1, "2"]})", "array element: expected integer, got string"},
+        {R"({"extra": {"rps": []}})", "field 'rps': expected integer, got array"},
+        {R"({"history": [1]})", "array element: expected object, got integer"},
+        {R"([])", "expected object, got array"},
+    };
+    for (const auto& [json, message] : cases) {
+        BOOST_TEST_CONTEXT(json) {
+            try {
+                binding.parse(json);
+                BOOST_ERROR("no exception");
+            } catch (const JSONException& e) {
+                BOOST_CHECK_EQUAL(e.message(), message);
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(binding.parse(R"({"small": 3})").small, 3);
+
+    pocotest::binding::BindingHandler<Sample> handler;
+    BOOST_CHECK_THROW(handler.startObject(), Poco::NullPointerException);
+}
+
+// При ключах схемы по алфавиту вывод совпадает с condense дерева с теми же
+// значениями; разбор вывода возвращает ту же структуру
+BOOST_AUTO_TEST_CASE(TestStringifyMatchesCondense) {
+    const Array::Ptr records = makeRecords(50);
+    JsonBinding<Record> binding;
+    std::string out;
+    for (std::size_t i = 0; i < records->size(); ++i) {
+        Object::Ptr object = new Object(*records->getObject(static_cast<unsigned>(i)));
+        object->remove("attributes");
+        const Record record = fromTree(*object);
+        BOOST_TEST_CONTEXT("record " << i) {
+            binding.stringify(record, out);
+            BOOST_CHECK_EQUAL(out, condensed(object));
+            BOOST_CHECK(binding.parse(out) == record);
+        }
+    }
+
+    JsonBinding<std::vector<Record>> list;
+    std::vector<Record> all;
+    list.parse(condensed(records), all);
+    list.stringify(all, out);
+    BOOST_CHECK(list.parse(out) == all);
+
+    // write() дописывает, stringify() заменяет
+    binding.write(all.front(), out);
+    BOOST_CHECK_EQUAL(out.back(), '}');
+    BOOST_CHECK_EQUAL(out.front(), '[');
+}
+
+// Значения, которые пишутся иначе, чем в дереве по умолчанию: null у
+// optional, экранирование, вложенные массивы; круговой разбор
+BOOST_AUTO_TEST_CASE(TestStringifyRoundTrip) {
+    Sample sample;
+    sample.flag = true;
+    sample.small = std::numeric_limits<int>::min();
+    sample.big = std::numeric_limits<Poco::UInt64>::max();
+    sample.byte = 9;
+    sample.ratio = 0.1;
+    sample.text = "line\n\t\"q\" \x01 caf\xC3\xA9";
+    sample.history = {Metrics(), {1e-7, 3.0e20, -1}};
+    sample.matrix = {{}, {"a"}};
+
+    JsonBinding<Sample> binding;
+    std::string out;
+    binding.stringify(sample, out);
+    BOOST_CHECK_EQUAL(out,
+        "{\"flag\":true,\"small\":-2147483648,\"big\":18446744073709551615,\"byte\":9,\"ratio\":0.1,"
+        "\"text\":\"line\\n\\t\\\"q\\\" \\u0001 caf\xC3\xA9\",\"note\":null,\"extra\":null,\"values\":[],"
+        "\"history\":[{\"cpu\":0,\"mem\":0,\"rps\":0},{\"cpu\":0.0000001,\"mem\":3e+20,\"rps\":-1}],"
+        "\"matrix\":[[],[\"a\"]]}");
+    BOOST_CHECK(binding.parse(out) == sample);
+
+    // Poco разбирает вывод в то же дерево
+    Parser parser;
+    const Object::Ptr tree = parser.parse(out).extract<Object::Ptr>();
+    BOOST_CHECK_EQUAL(tree->getValue<std::string>("text"), sample.text);
+    BOOST_CHECK(tree->isNull("note"));
+    BOOST_CHECK_EQUAL(tree->getArray("history")->getObject(1)->getValue<double>("mem"), 3.0e20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
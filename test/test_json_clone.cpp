@@ -0,0 +1,175 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSONString.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Exception.h>
+
+#include "json_clone.h"
+#include "json_cases.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::CowTree;
+using pocotest::condensed;
+
+namespace {
+
+Object::Ptr parseObject(const std::string& json) {
+    Parser parser;
+    return parser.parse(json).extract<Object::Ptr>();
+}
+
+const Object* objectAt(const Poco::Dynamic::Var& root, const std::string& key) {
+    return root.extract<Object::Ptr>()->getObject(key).get();
+}
+
+const char* const templateJson = R"({
+    "headers": {"content-type": "application/json", "accept": ["a", "b"]},
+    "body": {"id": 0, "items": [{"sku": "x", "meta": {"qty": 1}}, {"sku": "y", "meta": {"qty": 2}}]},
+    "trace": [1, 2, 3]
+})";
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonCloneTests)
+
+// Глубокая копия совпадает с копией через stringify/parse и не разделяет
+// узлы с оригиналом
+BOOST_AUTO_TEST_CASE(TestDeepCloneMatchesRoundTrip) {
+    Object::Ptr original = parseObject(templateJson);
+    Array::Ptr strings = new Array();
+    for (const auto& text : pocotest::escapeTestStrings()) {
+        strings->add(text);
+    }
+    original->set("strings", strings);
+    original->set("by_value", Object(*parseObject(R"({"inner": {"v": 1}})")));
+
+    Parser parser;
+    const Poco::Dynamic::Var roundTrip = parser.parse(condensed(original));
+    const Poco::Dynamic::Var clone = pocotest::cloneValue(original);
+    BOOST_REQUIRE(clone.type() == typeid(Object::Ptr));
+    BOOST_CHECK_EQUAL(condensed(clone), condensed(roundTrip));
+
+    const Object::Ptr copy = clone.extract<Object::Ptr>();
+    BOOST_CHECK(copy.get() != original.get());
+    BOOST_CHECK(copy->getObject("body").get() != original->getObject("body").get());
+    BOOST_CHECK(copy->getArray("trace").get() != original->getArray("trace").get());
+    BOOST_CHECK(copy->get("by_value").type() == typeid(Object));
+
+    copy->getObject("body")->getArray("items")->getObject(1)->getObject("meta")->set("qty", 99);
+    copy->getObject("headers")->set("content-type", "text/plain");
+    copy->getArray("trace")->add(4);
+    BOOST_CHECK_EQUAL(condensed(original), condensed(roundTrip));
+
+    // Пустые и null-значения копируются как есть
+    BOOST_CHECK(pocotest::cloneValue(Poco::Dynamic::Var()).isEmpty());
+    BOOST_CHECK(pocotest::cloneValue(Object::Ptr()).extract<Object::Ptr>().isNull());
+    BOOST_CHECK_EQUAL(pocotest::cloneValue(std::string("text")).extract<std::string>(), "text");
+}
+
+BOOST_AUTO_TEST_CASE(TestClonePreservesKeyOrder) {
+    Object::Ptr ordered = new Object(Poco::JSON_PRESERVE_KEY_ORDER);
+    for (const char* key : {"zeta", "alpha", "mid"}) {
+        Object::Ptr nested = new Object(Poco::JSON_PRESERVE_KEY_ORDER);
+        nested->set("z", 1);
+        nested->set("a", 2);
+        ordered->set(key, nested);
+    }
+    const Object::Ptr copy = pocotest::cloneObject(*ordered);
+    BOOST_CHECK(copy->getNames() == ordered->getNames());
+    BOOST_CHECK(copy->getObject("mid")->getNames() == ordered->getObject("mid")->getNames());
+    BOOST_CHECK_EQUAL(condensed(copy), condensed(ordered));
+}
+
+// Копии CowTree разделяют узлы; правка копирует только путь к узлу
+BOOST_AUTO_TEST_CASE(TestCowSharesUntouchedSubtrees) {
+    const Object::Ptr templ = parseObject(templateJson);
+    const std::string before = condensed(templ);
+
+    CowTree request(templ);
+    BOOST_CHECK(request.root().extract<Object::Ptr>().get() == templ.get());
+
+    request.editObject("body").set("id", 42);
+    BOOST_CHECK_EQUAL(request.copiedNodes(), 2u);
+    BOOST_CHECK_EQUAL(condensed(templ), before);
+    BOOST_CHECK_EQUAL(request.root().extract<Object::Ptr>()->getObject("body")->getValue<int>("id"), 42);
+    BOOST_CHECK(objectAt(request.root(), "headers") == templ->getObject("headers").get());
+    BOOST_CHECK(objectAt(request.root(), "body") != templ->getObject("body").get());
+
+    // Узлы уже принадлежат этому дереву - повторная правка ничего не копирует
+    request.editObject("body").set("id", 43);
+    request.editObject().set("extra", true);
+    BOOST_CHECK_EQUAL(request.copiedNodes(), 2u);
+
+    // Вложенный путь через массив; соседний элемент остаётся общим
+    request.editObject("body.items[1].meta").set("qty", 7);
+    BOOST_CHECK_EQUAL(request.copiedNodes(), 5u);
+    const Array::Ptr items = request.root().extract<Object::Ptr>()->getObject("body")->getArray("items");
+    const Array::Ptr templItems = templ->getObject("body")->getArray("items");
+    BOOST_CHECK(items->getObject(0).get() == templItems->getObject(0).get());
+    BOOST_CHECK_EQUAL(templItems->getObject(1)->getObject("meta")->getValue<int>("qty"), 2);
+    BOOST_CHECK_EQUAL(items->getObject(1)->getObject("meta")->getValue<int>("qty"), 7);
+
+    // Копия CowTree снова разделяет узлы: правка одной не видна в другой
+    CowTree second = request;
+    second.editArray("trace").add(4);
+    request.editArray("headers.accept").add("c");
+    BOOST_CHECK_EQUAL(condensed(request.root().extract<Object::Ptr>()->getArray("trace")), "[1,2,3]");
+    BOOST_CHECK_EQUAL(condensed(second.root().extract<Object::Ptr>()->getArray("trace")), "[1,2,3,4]");
+    BOOST_CHECK_EQUAL(condensed(second.root().extract<Object::Ptr>()->getObject("headers")->getArray("accept")),
+                      "[\"a\",\"b\"]");
+    BOOST_CHECK_EQUAL(condensed(templ), before);
+
+    // Дерево с корнем-массивом
+    Parser parser;
+    const Poco::Dynamic::Var list = parser.parse(R"([{"a": 1}, {"a": 2}])");
+    CowTree listTree(list);
+    listTree.editObject("[1]").set("a", 3);
+    BOOST_CHECK_EQUAL(condensed(listTree.root()), R"([{"a":1},{"a":3}])");
+    BOOST_CHECK_EQUAL(condensed(list), R"([{"a":1},{"a":2}])");
+}
+
+// Повторная правка пути по ключам объектов, который уже принадлежит
+// дереву, ничего не копирует, и ссылка от прошлой правки остаётся в дереве
+BOOST_AUTO_TEST_CASE(TestCowRepeatedObjectEditCopiesNothing) {
+    const Object::Ptr templ = parseObject(R"({"a": {"b": {"c": 1}, "d": [1]}, "e": {"f": 2}})");
+    CowTree tree(templ);
+
+    Object& first = tree.editObject("a.b");
+    BOOST_CHECK_EQUAL(tree.copiedNodes(), 3u);
+    for (int i = 0; i < 3; ++i) {
+        BOOST_CHECK(&tree.editObject("a.b") == &first);
+        tree.editArray("a.d");
+    }
+    BOOST_CHECK_EQUAL(tree.copiedNodes(), 4u);
+
+    first.set("c", 5);
+    const Object::Ptr root = tree.root().extract<Object::Ptr>();
+    BOOST_CHECK_EQUAL(root->getObject("a")->getObject("b")->getValue<int>("c"), 5);
+    BOOST_CHECK_EQUAL(templ->getObject("a")->getObject("b")->getValue<int>("c"), 1);
+    BOOST_CHECK(root->getObject("e").get() == templ->getObject("e").get());
+}
+
+BOOST_AUTO_TEST_CASE(TestCowRejectsInvalidPaths) {
+    CowTree tree(parseObject(templateJson));
+    BOOST_CHECK_THROW(tree.editObject("missing"), Poco::NotFoundException);
+    BOOST_CHECK_THROW(tree.editObject("trace[3]"), Poco::NotFoundException);
+    BOOST_CHECK_THROW(tree.editObject("trace"), Poco::BadCastException);
+    BOOST_CHECK_THROW(tree.editArray("body"), Poco::BadCastException);
+    BOOST_CHECK_THROW(tree.editObject("body[0]"), Poco::BadCastException);
+    BOOST_CHECK_THROW(tree.editObject("body.id"), Poco::BadCastException);
+    BOOST_CHECK_THROW(tree.editObject("body..items"), Poco::InvalidArgumentException);
+    BOOST_CHECK_THROW(tree.editObject("body.items[x]"), Poco::InvalidArgumentException);
+    BOOST_CHECK_THROW(tree.editObject("body.items[0]meta"), Poco::InvalidArgumentException);
+    BOOST_CHECK_THROW(CowTree(Poco::Dynamic::Var(42)), Poco::InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
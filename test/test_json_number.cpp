@@ -0,0 +1,259 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Exception.h>
+
+#include "json_number.h"
+#include "json_reader.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pocotest::number;
+
+namespace {
+
+std::uint64_t bitsOf(double value) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+std::string format(double value) {
+    char buffer[MAX_DOUBLE_CHARS];
+    return std::string(buffer, formatDouble(value, buffer));
+}
+
+bool parse(const std::string& text, double& value) {
+    return parseDouble(text.data(), text.data() + text.size(), value);
+}
+
+// Значения на краях диапазона double и на границах десятичной записи
+std::vector<double> limitDoubles() {
+    using limits = std::numeric_limits<double>;
+    return {
+        0.0, -0.0, 1.0, -1.0, 0.1, 0.5, 3.14159, 123.456, -2.5e3,
+        limits::max(), limits::lowest(), limits::min(), limits::denorm_min(), -limits::denorm_min(),
+        limits::epsilon(), 1e14, 1e15, 1e16, 123456789012345.0, 1234567890123456.0,
+        1e-15, 1e-16, 1.5e-15, 1e100, 1e-100, 1e22, 1e23, 9007199254740992.0, 9007199254740993.0,
+        0.30000000000000004, 2.2250738585072011e-308, 5e-324,
+    };
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonNumberTests)
+
+// Целые: границы Int64/UInt64, переполнение и некорректный текст
+BOOST_AUTO_TEST_CASE(TestIntegerLimits) {
+    const std::vector<std::pair<std::string, Poco::Int64>> signedCases = {
+        {"0", 0}, {"-0", 0}, {"7", 7}, {"-42", -42},
+        {"9223372036854775807", std::numeric_limits<Poco::Int64>::max()},
+        {"-9223372036854775808", std::numeric_limits<Poco::Int64>::min()},
+    };
+    for (const auto& entry : signedCases) {
+        Poco::Int64 value = 1;
+        BOOST_CHECK(parseInt64(entry.first.data(), entry.first.data() + entry.first.size(), value));
+        BOOST_CHECK_EQUAL(value, entry.second);
+    }
+
+    const std::string maxUnsigned = "18446744073709551615";
+    Poco::UInt64 unsignedValue = 0;
+    BOOST_CHECK(parseUInt64(maxUnsigned.data(), maxUnsigned.data() + maxUnsigned.size(), unsignedValue));
+    BOOST_CHECK_EQUAL(unsignedValue, std::numeric_limits<Poco::UInt64>::max());
+
+    for (const std::string text : {"9223372036854775808", "-9223372036854775809", "18446744073709551616",
+                                   "99999999999999999999", "", "-", "1a", "+1", "1.0", " 1"}) {
+        BOOST_TEST_CONTEXT("text: " << text) {
+            Poco::Int64 value = 0;
+            BOOST_CHECK(!parseInt64(text.data(), text.data() + text.size(), value));
+        }
+    }
+    for (const std::string text : {"18446744073709551616", "-1", "", "1e3"}) {
+        BOOST_CHECK(!parseUInt64(text.data(), text.data() + text.size(), unsignedValue));
+    }
+
+    // Результат совпадает с NumberParser на случайных числах
+    std::mt19937_64 rng(15);
+    for (int i = 0; i < 10000; ++i) {
+        const Poco::Int64 expected = static_cast<Poco::Int64>(rng()) >> (rng() % 64);
+        const std::string text = std::to_string(expected);
+        Poco::Int64 value = 0;
+        Poco::Int64 reference = 0;
+        BOOST_REQUIRE(parseInt64(text.data(), text.data() + text.size(), value));
+        BOOST_REQUIRE(Poco::NumberParser::tryParse64(text, reference));
+        BOOST_REQUIRE_EQUAL(value, reference);
+    }
+}
+
+// parseDouble побитово совпадает с NumberParser::parseFloat
+BOOST_AUTO_TEST_CASE(TestParseDoubleMatchesPoco) {
+    std::vector<std::string> texts = {
+        "0.0", "-0.0", "0e0", "1.5", "-2.5e+3", "1E-5", "0.1", "0.30000000000000004",
+        "9007199254740993.0", "9007199254740992e0", "1e22", "1e23", "123456789e-22", "4.9e-324",
+        "2.2250738585072011e-308", "2.2250738585072014e-308", "1.7976931348623157e308",
+        "3.141592653589793238462643383279", "0.000000000000000000000000000001",
+        "123456789012345678901234567890.5", "1e-400", "-1e-400", "7.0e-10", "100000000000000000000.0",
+    };
+    std::mt19937_64 rng(16);
+    std::uniform_int_distribution<int> digitCount(1, 20);
+    std::uniform_int_distribution<int> exponent(-330, 310);
+    for (int i = 0; i < 20000; ++i) {
+        double value = 0.0;
+        const std::uint64_t bits = rng();
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value)) {
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+            texts.push_back(buffer);
+        }
+        std::string digits = std::to_string(rng() % 10 + 1);
+        for (int d = digitCount(rng); d > 0; --d) {
+            digits += static_cast<char>('0' + rng() % 10);
+        }
+        texts.push_back(digits.substr(0, 1) + "." + digits.substr(1) + "e" + std::to_string(exponent(rng) % 25));
+        texts.push_back("-" + digits + "e" + std::to_string(exponent(rng)));
+    }
+
+    for (const auto& text : texts) {
+        BOOST_TEST_CONTEXT("text: " << text) {
+            const double expected = Poco::NumberParser::parseFloat(text);
+            double value = 0.0;
+            if (parse(text, value)) {
+                BOOST_REQUIRE_EQUAL(bitsOf(value), bitsOf(expected));
+            } else {
+                // Вне диапазона double - решает NumberParser
+                BOOST_REQUIRE(std::isinf(expected) || expected == 0.0);
+            }
+        }
+    }
+
+    double value = 0.0;
+    for (const std::string text : {"", "-", "1.0x", "abc", "1e", "inf", "nan", "-inf", ".5", "+1"}) {
+        BOOST_CHECK(!parse(text, value));
+    }
+}
+
+// formatDouble совпадает с Dynamic::Var и читается обратно в то же число
+BOOST_AUTO_TEST_CASE(TestFormatDoubleMatchesVar) {
+    BOOST_CHECK_EQUAL(format(0.0), "0");
+    BOOST_CHECK_EQUAL(format(-0.0), "0");
+    BOOST_CHECK_EQUAL(format(0.1), "0.1");
+    BOOST_CHECK_EQUAL(format(-2500.0), "-2500");
+    BOOST_CHECK_EQUAL(format(1e14), "100000000000000");
+    BOOST_CHECK_EQUAL(format(1e15), "1e+15");
+    BOOST_CHECK_EQUAL(format(1.5e-15), "0.0000000000000015");
+    BOOST_CHECK_EQUAL(format(1e-16), "1e-16");
+    BOOST_CHECK_EQUAL(format(std::numeric_limits<double>::max()), "1.7976931348623157e+308");
+    BOOST_CHECK_EQUAL(format(std::numeric_limits<double>::denorm_min()), "5e-324");
+    BOOST_CHECK_EQUAL(format(std::numeric_limits<double>::quiet_NaN()), "nan");
+    BOOST_CHECK_EQUAL(format(std::numeric_limits<double>::infinity()), "inf");
+    BOOST_CHECK_EQUAL(format(-std::numeric_limits<double>::infinity()), "-inf");
+
+    std::vector<double> values = limitDoubles();
+    values.push_back(std::numeric_limits<double>::quiet_NaN());
+    values.push_back(std::numeric_limits<double>::infinity());
+    values.push_back(-std::numeric_limits<double>::infinity());
+    std::mt19937_64 rng(17);
+    for (int i = 0; i < 20000; ++i) {
+        double value = 0.0;
+        const std::uint64_t bits = rng();
+        std::memcpy(&value, &bits, sizeof(value));
+        values.push_back(value);
+        values.push_back(static_cast<double>(rng() % 1000000) / 1000.0);
+    }
+
+    for (double value : values) {
+        const std::string text = format(value);
+        BOOST_TEST_CONTEXT("value: " << text) {
+            BOOST_REQUIRE_EQUAL(text, Poco::Dynamic::Var(value).convert<std::string>());
+            if (std::isfinite(value) && value != 0.0) {
+                BOOST_REQUIRE_EQUAL(bitsOf(Poco::NumberParser::parseFloat(text)), bitsOf(value));
+            }
+        }
+    }
+}
+
+// convertValue даёт то же, что Var::convert, или то же исключение
+BOOST_AUTO_TEST_CASE(TestConvertValueMatchesConvert) {
+    std::vector<Poco::Dynamic::Var> values = {
+        Poco::Dynamic::Var(Poco::Int64(42)), Poco::Dynamic::Var(Poco::Int64(-42)),
+        Poco::Dynamic::Var(std::numeric_limits<Poco::Int64>::max()),
+        Poco::Dynamic::Var(std::numeric_limits<Poco::Int64>::min()),
+        Poco::Dynamic::Var(std::numeric_limits<Poco::UInt64>::max()),
+        Poco::Dynamic::Var(Poco::Int64(1) << 53), Poco::Dynamic::Var((Poco::Int64(1) << 53) + 1),
+        Poco::Dynamic::Var(7), Poco::Dynamic::Var(7u), Poco::Dynamic::Var(-1),
+        Poco::Dynamic::Var(std::numeric_limits<int>::max()), Poco::Dynamic::Var(std::numeric_limits<int>::min()),
+        Poco::Dynamic::Var(std::numeric_limits<unsigned>::max()),
+        Poco::Dynamic::Var(0.5), Poco::Dynamic::Var(1e300), Poco::Dynamic::Var(-3.0),
+        Poco::Dynamic::Var(true), Poco::Dynamic::Var(std::string("12")), Poco::Dynamic::Var(),
+    };
+    for (double value : limitDoubles()) {
+        values.push_back(Poco::Dynamic::Var(value));
+    }
+
+    for (const auto& value : values) {
+        BOOST_TEST_CONTEXT("type: " << value.type().name()) {
+            auto check = [&value](auto typed) {
+                using T = decltype(typed);
+                bool threw = false;
+                T expected{};
+                try {
+                    expected = value.convert<T>();
+                } catch (const Poco::Exception&) {
+                    threw = true;
+                }
+                if (threw) {
+                    BOOST_CHECK_THROW(convertValue<T>(value), Poco::Exception);
+                } else {
+                    BOOST_CHECK(convertValue<T>(value) == expected);
+                }
+            };
+            check(int());
+            check(unsigned());
+            check(Poco::Int64());
+            check(Poco::UInt64());
+            check(double());
+            check(bool());
+            check(std::string());
+        }
+    }
+}
+
+// JsonReader на краевых числах даёт те же типы и значения, что Parser
+BOOST_AUTO_TEST_CASE(TestReaderNumbersMatchParser) {
+    const std::vector<std::string> documents = {
+        "0", "-0", "9223372036854775807", "-9223372036854775808", "9223372036854775808",
+        "18446744073709551615", "0.0", "-0.0", "1e400", "-1e400", "1e-400", "4.9e-324",
+        "1.7976931348623157e308", "0.1", "123456789012345678901234567890.5", "1E+2", "-2.5e-3",
+    };
+    pocotest::JsonReader reader;
+    for (const auto& json : documents) {
+        BOOST_TEST_CONTEXT("JSON: " << json) {
+            Poco::JSON::Parser parser;
+            const Poco::Dynamic::Var expected = parser.parse(json);
+            const Poco::Dynamic::Var actual = reader.parse(std::string_view(json));
+            BOOST_REQUIRE(actual.type() == expected.type());
+            if (expected.type() == typeid(double)) {
+                BOOST_CHECK_EQUAL(bitsOf(actual.extract<double>()), bitsOf(expected.extract<double>()));
+            } else {
+                BOOST_CHECK_EQUAL(actual.convert<std::string>(), expected.convert<std::string>());
+            }
+        }
+    }
+
+    // Целое больше UInt64 отвергается, как у Parser
+    BOOST_CHECK_THROW(reader.parse(std::string_view("18446744073709551616")), Poco::Exception);
+    BOOST_CHECK_THROW(Poco::JSON::Parser().parse("18446744073709551616"), Poco::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
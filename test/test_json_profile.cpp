@@ -0,0 +1,267 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Dynamic/Var.h>
+
+#include "alloc_counter.h"
+#include "bench_corpus.h"
+#include "json_profile.h"
+#include "json_reader.h"
+#include "json_writer.h"
+#include "json_cases.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::AllocationScope;
+using pocotest::condensed;
+namespace profile = pocotest::profile;
+
+namespace {
+
+// Потолок выделений Poco на узел дерева (объект, массив, ключ или скаляр) и
+// постоянная часть на документ - с запасом на различия сборок Poco.
+// Превышение - регрессия в Parser, ParseHandler, Object или Stringifier
+// после обновления Poco; фактические числа печатаются с --log_level=message
+constexpr std::size_t MAX_POCO_ALLOCATIONS_PER_NODE = 8;
+constexpr std::size_t POCO_ALLOCATION_SLACK = 64;
+
+// Документы той же структуры, что в корпусе бенчмарков, но меньшего размера
+std::vector<bench::CorpusDocument> smallCorpus() {
+    std::mt19937 rng(20250101u);
+    std::vector<bench::CorpusDocument> corpus;
+    corpus.push_back(bench::makeDocument("flat_object", bench::makeFlatObject(rng, 64)));
+    corpus.push_back(bench::makeDocument("deep_nesting", bench::makeDeepNesting(16)));
+    corpus.push_back(bench::makeDocument("number_array", bench::makeNumberArray(rng, 512)));
+    corpus.push_back(bench::makeDocument("string_logs", bench::makeStringLogs(rng, 32)));
+    corpus.push_back(bench::makeDocument("large_document", bench::makeLargeDocument(rng, 16)));
+    return corpus;
+}
+
+// Число узлов дерева: контейнеры, ключи и скаляры
+std::size_t countNodes(const Poco::Dynamic::Var& value) {
+    if (value.type() == typeid(Object::Ptr)) {
+        std::size_t nodes = 1;
+        for (const auto& member : *value.extract<Object::Ptr>()) {
+            nodes += 1 + countNodes(member.second);
+        }
+        return nodes;
+    }
+    if (value.type() == typeid(Array::Ptr)) {
+        std::size_t nodes = 1;
+        for (const auto& element : *value.extract<Array::Ptr>()) {
+            nodes += countNodes(element);
+        }
+        return nodes;
+    }
+    return 1;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonProfileTests)
+
+// Вложенные замеры: время и выделения внутренней стадии входят во внешнюю,
+// но не в её собственное время
+BOOST_AUTO_TEST_CASE(TestScopesNestAndAccumulate) {
+    profile::Registry& registry = profile::registry();
+    registry.reset();
+    BOOST_CHECK(registry.empty());
+
+    std::vector<std::string> keep;
+    keep.reserve(2);
+    {
+        const profile::Scope parse(profile::Stage::Parse);
+        for (int i = 0; i < 2; ++i) {
+            const profile::Scope build(profile::Stage::Build);
+            keep.emplace_back(100, 'x');
+        }
+    }
+
+    const profile::StageStats parse = registry.stats(profile::Stage::Parse);
+    const profile::StageStats build = registry.stats(profile::Stage::Build);
+    BOOST_CHECK_EQUAL(parse.calls, 1u);
+    BOOST_CHECK_EQUAL(build.calls, 2u);
+    BOOST_CHECK_EQUAL(build.allocations, 2u);
+    BOOST_CHECK_GE(build.bytes, 202u);
+    BOOST_CHECK_EQUAL(parse.allocations, build.allocations);
+    BOOST_CHECK_EQUAL(parse.bytes, build.bytes);
+    BOOST_CHECK_GE(parse.nanoseconds, build.nanoseconds);
+    BOOST_CHECK_EQUAL(parse.selfNanoseconds, parse.nanoseconds - build.nanoseconds);
+    BOOST_CHECK_EQUAL(build.selfNanoseconds, build.nanoseconds);
+    BOOST_CHECK_EQUAL(registry.stats(profile::Stage::Escape).calls, 0u);
+
+    std::ostringstream dump;
+    registry.dump(dump);
+    BOOST_CHECK(dump.str().find("parse") != std::string::npos);
+    BOOST_CHECK(dump.str().find("build") != std::string::npos);
+    BOOST_CHECK(dump.str().find("escape") == std::string::npos);
+
+    registry.reset();
+    BOOST_CHECK(registry.empty());
+    BOOST_CHECK_EQUAL(registry.stats(profile::Stage::Parse).nanoseconds, 0u);
+}
+
+// Обёртки над Parser и Stringifier дают тот же результат, а TimedHandler
+// замеряет каждое событие разбора
+BOOST_AUTO_TEST_CASE(TestPocoStagesMatchPlainCalls) {
+    const std::vector<bench::CorpusDocument> corpus = smallCorpus();
+    profile::Registry& registry = profile::registry();
+    registry.reset();
+
+    Parser parser(new profile::TimedHandler(new ParseHandler));
+    std::size_t nodes = 0;
+    for (const auto& doc : corpus) {
+        BOOST_TEST_CONTEXT("document " << doc.name) {
+            parser.reset();
+            const Poco::Dynamic::Var tree = profile::parse(parser, doc.json);
+            std::ostringstream ss;
+            profile::stringify(tree, ss);
+            BOOST_CHECK_EQUAL(ss.str(), condensed(doc.tree));
+            nodes += countNodes(doc.tree);
+        }
+    }
+
+    const profile::StageStats parse = registry.stats(profile::Stage::Parse);
+    const profile::StageStats build = registry.stats(profile::Stage::Build);
+    BOOST_CHECK_EQUAL(parse.calls, corpus.size());
+    BOOST_CHECK_EQUAL(registry.stats(profile::Stage::Stringify).calls, corpus.size());
+    // Каждый узел - хотя бы одно событие, контейнер - два
+    BOOST_CHECK_GE(build.calls, nodes);
+    BOOST_CHECK_GE(parse.nanoseconds, build.nanoseconds);
+    BOOST_CHECK_GE(parse.allocations, build.allocations);
+    BOOST_CHECK_GT(build.allocations, 0u);
+    registry.reset();
+}
+
+// Замеры в JsonReader и JsonWriter есть только в сборке с
+// POCO_TEST_APP_PROFILE
+BOOST_AUTO_TEST_CASE(TestHotPathScopesFollowBuildFlag) {
+    const std::string json = R"({"name": "line\nbreak", "values": [1, 2.5, true, null]})";
+    profile::Registry& registry = profile::registry();
+    registry.reset();
+
+    pocotest::JsonReader reader;
+    const Poco::Dynamic::Var tree = reader.parse(std::string_view(json));
+    std::string out;
+    pocotest::stringifyTo(tree, out);
+    BOOST_CHECK_EQUAL(out, condensed(tree));
+
+    if (profile::ENABLED) {
+        BOOST_CHECK_EQUAL(registry.stats(profile::Stage::Parse).calls, 1u);
+        BOOST_CHECK_EQUAL(registry.stats(profile::Stage::Tokenize).calls, 1u);
+        BOOST_CHECK_EQUAL(registry.stats(profile::Stage::Stringify).calls, 1u);
+        // Два ключа и одна строка-значение
+        BOOST_CHECK_EQUAL(registry.stats(profile::Stage::Escape).calls, 3u);
+    } else {
+        BOOST_CHECK(registry.empty());
+    }
+    registry.reset();
+}
+
+// Повторный разбор JsonReader без дерева и сериализация в буфер прошлого
+// документа не выделяют память вовсе
+BOOST_AUTO_TEST_CASE(TestReaderAndWriterDoNotAllocate) {
+    for (const auto& doc : smallCorpus()) {
+        BOOST_TEST_CONTEXT("document " << doc.name) {
+            pocotest::JsonReader reader(new pocotest::SaxHandler);
+            reader.parse(std::string_view(doc.json));
+            std::string out;
+            pocotest::stringifyTo(doc.tree, out);
+
+            const AllocationScope scope;
+            reader.parse(std::string_view(doc.json));
+            pocotest::stringifyTo(doc.tree, out);
+            BOOST_CHECK_EQUAL(scope.delta().allocations, 0u);
+            BOOST_CHECK_EQUAL(out, condensed(doc.tree));
+        }
+    }
+}
+
+// Выделения Poco на документ не превышают потолка, а JsonReader с тем же
+// ParseHandler выделяет не больше, чем Parser
+BOOST_AUTO_TEST_CASE(TestAllocationsPerDocumentAreBounded) {
+    for (const auto& doc : smallCorpus()) {
+        BOOST_TEST_CONTEXT("document " << doc.name) {
+            const std::size_t nodes = countNodes(doc.tree);
+            const std::size_t ceiling = MAX_POCO_ALLOCATIONS_PER_NODE * nodes + POCO_ALLOCATION_SLACK;
+
+            Parser parser;
+            parser.parse(doc.json);
+            parser.reset();
+            std::size_t parseAllocations = 0;
+            {
+                const AllocationScope scope;
+                const Poco::Dynamic::Var tree = parser.parse(doc.json);
+                parseAllocations = scope.delta().allocations;
+            }
+
+            std::size_t stringifyAllocations = 0;
+            {
+                const AllocationScope scope;
+                std::ostringstream ss;
+                Stringifier::condense(doc.tree, ss);
+                stringifyAllocations = scope.delta().allocations;
+            }
+
+            pocotest::JsonReader reader;
+            reader.parse(std::string_view(doc.json));
+            std::size_t readerAllocations = 0;
+            {
+                const AllocationScope scope;
+                const Poco::Dynamic::Var tree = reader.parse(std::string_view(doc.json));
+                readerAllocations = scope.delta().allocations;
+            }
+
+            BOOST_TEST_MESSAGE(doc.name << ": " << nodes << " nodes, Parser::parse " << parseAllocations
+                               << ", Stringifier::condense " << stringifyAllocations
+                               << ", JsonReader " << readerAllocations << " allocations");
+            BOOST_CHECK_LE(parseAllocations, ceiling);
+            BOOST_CHECK_LE(stringifyAllocations, ceiling);
+            BOOST_CHECK_LE(readerAllocations, parseAllocations);
+        }
+    }
+}
+
+// Разбор и сериализация, повторённые много раз, возвращают всю выделенную
+// память: число освобождений равно числу выделений
+BOOST_AUTO_TEST_CASE(TestNoLeaksAcrossDocuments) {
+    const std::vector<bench::CorpusDocument> corpus = smallCorpus();
+    const auto roundTrip = [](const std::string& json) {
+        Parser parser;
+        const Poco::Dynamic::Var tree = parser.parse(json);
+        std::ostringstream ss;
+        Stringifier::condense(tree, ss);
+
+        pocotest::JsonReader reader;
+        const Poco::Dynamic::Var copy = reader.parse(std::string_view(json));
+        std::string out;
+        pocotest::stringifyTo(copy, out);
+    };
+
+    for (const auto& doc : corpus) {
+        BOOST_TEST_CONTEXT("document " << doc.name) {
+            // Первый проход - ленивая инициализация статических данных Poco
+            roundTrip(doc.json);
+
+            const AllocationScope scope;
+            for (int i = 0; i < 20; ++i) {
+                roundTrip(doc.json);
+            }
+            const pocotest::AllocationStats delta = scope.delta();
+            BOOST_CHECK_GT(delta.allocations, 0u);
+            BOOST_CHECK_EQUAL(delta.deallocations, delta.allocations);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
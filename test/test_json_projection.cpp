@@ -0,0 +1,190 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Query.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Exception.h>
+
+#include "json_projection.h"
+#include "json_cases.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::JsonProjection;
+
+namespace {
+
+// Пустой Var (значение не найдено) отличается от null
+std::string shown(const Poco::Dynamic::Var& value) {
+    return value.isEmpty() ? "<empty>" : pocotest::condensed(value);
+}
+
+const char* const orderDocument = R"({
+    "id": 42,
+    "customer": {"name": "Ann \"A\" Lee", "tags": ["vip", "eu"], "address": {"city": "Riga", "zip": "LV-1010"}},
+    "items": [
+        {"sku": "a-1", "qty": 2, "price": 9.5, "meta": {"x": [1, {"y": "]}"}]}},
+        {"sku": "b-2", "qty": 1, "price": 120, "meta": null},
+        {"sku": "c-3", "qty": 5, "price": 0.25, "meta": {"notes": "{[\"}"}}
+    ],
+    "paid": true,
+    "coupon": null,
+    "matrix": [[1, 2], [3, [4, 5]]],
+    "empty": {},
+    "none": []
+})";
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonProjectionTests)
+
+// Для путей, согласованных с типами документа, результат равен Query::find
+BOOST_AUTO_TEST_CASE(TestProjectionMatchesQuery) {
+    Parser parser;
+    const Poco::Dynamic::Var root = parser.parse(orderDocument);
+    Query query(root);
+
+    const std::vector<std::string> paths = {
+        "id", "customer", "customer.name", "customer.tags[1]", "customer.address.city",
+        "items", "items[0].sku", "items[0].meta.x[1].y", "items[1].price", "items[1].meta",
+        "items[2].meta.notes", "items[3].sku", "paid", "coupon", "matrix[1][1][0]", "matrix[0]",
+        "empty", "none", "missing", "customer.missing.deeper",
+    };
+    JsonProjection projection(paths);
+    const std::vector<Poco::Dynamic::Var> values = projection.parse(orderDocument);
+    BOOST_REQUIRE_EQUAL(values.size(), paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        BOOST_CHECK_MESSAGE(shown(values[i]) == shown(query.find(paths[i])), "path: " << paths[i]);
+    }
+
+    // Пустой путь - весь документ
+    JsonProjection whole({""});
+    BOOST_CHECK_EQUAL(shown(whole.parse(orderDocument)[0]), shown(root));
+    BOOST_CHECK_EQUAL(whole.skippedBytes(), 0u);
+
+    // Индекс у не-массива и ключ у не-объекта дают пустое значение
+    JsonProjection mismatched({"id[0]", "items.sku", "customer.name.first"});
+    for (const auto& value : mismatched.parse(orderDocument)) {
+        BOOST_CHECK(value.isEmpty());
+    }
+}
+
+// Ненужные поля широкого документа не разбираются
+BOOST_AUTO_TEST_CASE(TestProjectionSkipsUnrequested) {
+    std::string json = "{";
+    for (int i = 0; i < 200; ++i) {
+        json += "\"field" + std::to_string(i) + "\": {\"value\": " + std::to_string(i)
+            + ", \"text\": \"some {text} [" + std::to_string(i) + "]\", \"list\": [1, 2.5, true, null]}, ";
+    }
+    json += "\"last\": \"done\"}";
+
+    JsonProjection projection({"field7.value", "field150.text", "last"});
+    std::vector<Poco::Dynamic::Var> values;
+    projection.parse(json.data(), json.size(), values);
+    BOOST_REQUIRE_EQUAL(values.size(), 3u);
+    BOOST_CHECK_EQUAL(values[0].convert<int>(), 7);
+    BOOST_CHECK_EQUAL(values[1].convert<std::string>(), "some {text} [150]");
+    BOOST_CHECK_EQUAL(values[2].convert<std::string>(), "done");
+    BOOST_CHECK_GT(projection.skippedBytes(), json.size() * 3 / 4);
+
+    // Тот же объект разбирает следующий документ
+    values = projection.parse(R"({"last": "again", "field7": {"value": -1}})");
+    BOOST_CHECK_EQUAL(values[0].convert<int>(), -1);
+    BOOST_CHECK(values[1].isEmpty());
+    BOOST_CHECK_EQUAL(values[2].convert<std::string>(), "again");
+}
+
+// Вложенные и повторяющиеся пути, повторяющиеся ключи
+BOOST_AUTO_TEST_CASE(TestNestedAndDuplicatePaths) {
+    JsonProjection projection({"a.b", "a", "a.b", "a.list[1]", "c"});
+    const std::vector<Poco::Dynamic::Var> values =
+        projection.parse(R"({"a": {"b": 1, "list": [10, 20]}, "c": "x"})");
+    BOOST_CHECK_EQUAL(shown(values[0]), "1");
+    BOOST_CHECK_EQUAL(shown(values[1]), R"({"b":1,"list":[10,20]})");
+    BOOST_CHECK_EQUAL(shown(values[2]), "1");
+    BOOST_CHECK_EQUAL(shown(values[3]), "20");
+    BOOST_CHECK_EQUAL(shown(values[4]), R"("x")");
+
+    // Как в Parser, побеждает последнее значение ключа
+    JsonProjection last({"k", "o.x", "o.y"});
+    std::vector<Poco::Dynamic::Var> repeated =
+        last.parse(R"({"k": 1, "o": {"x": 1, "y": 2}, "k": 2, "o": {"x": 3}})");
+    BOOST_CHECK_EQUAL(shown(repeated[0]), "2");
+    BOOST_CHECK_EQUAL(shown(repeated[1]), "3");
+    BOOST_CHECK(repeated[2].isEmpty());
+}
+
+// Ключи с escape-последовательностями сравниваются после декодирования
+BOOST_AUTO_TEST_CASE(TestEscapedKeys) {
+    JsonProjection projection({"caf\xC3\xA9.tab\tkey", "plain"});
+    const std::vector<Poco::Dynamic::Var> values =
+        projection.parse(R"({"café": {"tab\tkey": [1]}, "plain": "p", "\"q\"": 0})");
+    BOOST_CHECK_EQUAL(shown(values[0]), "[1]");
+    BOOST_CHECK_EQUAL(shown(values[1]), R"("p")");
+}
+
+// Запрошенные значения и структура документа проверяются полностью
+BOOST_AUTO_TEST_CASE(TestProjectionRejectsMalformed) {
+    std::vector<std::string> documents = pocotest::malformedJsonCases();
+    documents.push_back("{\"skipped\": [1, 2}");
+    documents.push_back("{\"skipped\": \"abc");
+    documents.push_back("{\"skipped\": {\"x\": \"}\"]}");
+    documents.push_back("{\"key\": 1} 2");
+
+    JsonProjection whole({""});
+    JsonProjection fields({"key", "number", "bad_escape", "control_char", "unclosed_string", "trailing"});
+    for (const auto& json_str : documents) {
+        BOOST_TEST_CONTEXT("Invalid JSON: " << json_str) {
+            BOOST_CHECK_THROW(whole.parse(json_str), JSONException);
+            // Корневой массив для путей по ключам пропускается целиком
+            if (json_str.compare(0, 1, "[") != 0) {
+                BOOST_CHECK_THROW(fields.parse(json_str), JSONException);
+            }
+        }
+    }
+
+    // В пропускаемых значениях проверяется только парность скобок
+    BOOST_CHECK_NO_THROW(fields.parse(R"({"other": [tru, 1.2.3], "key": 1})"));
+    BOOST_CHECK_THROW(fields.parse(R"({"key": tru})"), JSONException);
+}
+
+BOOST_AUTO_TEST_CASE(TestProjectionDepthLimit) {
+    const std::string deep = std::string(20, '[') + std::string(20, ']');
+    const std::string json = "{\"a\": {\"b\": " + deep + "}, \"c\": 1}";
+
+    JsonProjection requested({"a.b"});
+    JsonProjection skipped({"c"});
+    BOOST_CHECK_NO_THROW(requested.parse(json));
+    BOOST_CHECK_NO_THROW(skipped.parse(json));
+
+    requested.setDepth(21);
+    skipped.setDepth(21);
+    BOOST_CHECK_EQUAL(requested.getDepth(), 21u);
+    BOOST_CHECK_THROW(requested.parse(json), JSONException);
+    BOOST_CHECK_THROW(skipped.parse(json), JSONException);
+
+    requested.setDepth(22);
+    skipped.setDepth(22);
+    BOOST_CHECK_NO_THROW(requested.parse(json));
+    BOOST_CHECK_EQUAL(skipped.parse(json)[0].convert<int>(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestInvalidPaths) {
+    const std::vector<std::string> invalid = {
+        "a..b", ".a", "a.", "a[", "a[]", "a[x]", "a[1]b", "a[-1]", "a]", "a[1].",
+    };
+    for (const auto& path : invalid) {
+        BOOST_CHECK_THROW(JsonProjection({path}), Poco::InvalidArgumentException);
+    }
+    BOOST_CHECK_NO_THROW(JsonProjection({"a[1][2].b", "[0]", "[0].a", "", "a b"}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
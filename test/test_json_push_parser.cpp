@@ -0,0 +1,216 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+
+#include "json_push_parser.h"
+#include "json_reader.h"
+#include "json_cases.h"
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::JsonPushParser;
+using pocotest::condensed;
+
+namespace {
+
+// Корректные документы из json_cases.h, документы из остальных тестов
+// test_json.cpp и случаи, на которых граница куска попадает внутрь каждого
+// вида токена
+std::vector<std::string> validDocuments() {
+    std::vector<std::string> documents = pocotest::validJsonCases();
+    documents.insert(documents.end(), {
+        "  \t\r\n{ }  ",
+        "42",
+        "-0.5e-3 ",
+        "\"top level\"",
+        "null",
+        R"([1, -2, 3.25, "four", false, null, [], {}, [[[]]]])",
+        R"({"escaped": "line\nbreak \"quoted\" back\\slash \/ \b\f\r\t \u00e9 \ud83d\ude00 ©"})",
+        R"({"max_int64": 9223372036854775807, "min_int64": -9223372036854775808, "big": 18446744073709551615})",
+        R"({"exp": [1e10, 1E-5, -2.5e+3, 0.0, -0]})",
+        R"({"utf8": "é € 😀", "ключ": "значение"})",
+        "{\"test\":123}",
+        "[1, 2, 3]",
+        R"({"company": "Poco", "active": true, "count": 42})",
+        R"({"id": 1, "name": "test", "tags": ["a", "b"], "active": true})",
+        R"({"id": 7, "items": [1, 2, {"x": "y"}]})",
+        R"({"name": "first", "nested": {"v": 1}})",
+        R"({"after": "error"})",
+        R"({"small": true})",
+    });
+    return documents;
+}
+
+std::vector<std::string> malformedDocuments() {
+    std::vector<std::string> documents = pocotest::malformedJsonCases();
+    documents.insert(documents.end(), {
+        "   ",
+        "{\"a\": [1, 2, {\"b\": ", // обрыв внутри вложенной структуры
+        "01", "1.", ".5", "-", "1e", "tru", "truex", "nul", "[true false]",
+        "[1 2]", "{\"a\" 1}", "{}{}", "[1]x", "{\"a\": 1}}",
+        "\"\\ud800\"", "\"\\udc00\"", "\"\\ud800\\u0041\"", "\"\\u12\"",
+        "\"\xff\"", "\"\xc0\x80\"", "\"\xed\xa0\x80\"", "\"abc\xe2\x88\"", "\"abc\xc3",
+    });
+    return documents;
+}
+
+// Разбирает документ, разрезанный на куски по offsets
+Poco::Dynamic::Var feedSplit(JsonPushParser& parser, const std::string& json,
+                             const std::vector<std::size_t>& offsets) {
+    std::size_t start = 0;
+    for (std::size_t offset : offsets) {
+        parser.feed(std::string_view(json).substr(start, offset - start));
+        start = offset;
+    }
+    parser.feed(std::string_view(json).substr(start));
+    return parser.finish();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonPushParserTests)
+
+// Любое разбиение корректного документа даёт то же дерево, что и разбор
+// целиком
+BOOST_AUTO_TEST_CASE(TestMatchesOneShotAtEverySplit) {
+    JsonPushParser parser;
+    for (const auto& json_str : validDocuments()) {
+        Parser one_shot;
+        const std::string expected = condensed(one_shot.parse(json_str));
+        BOOST_TEST_CONTEXT("JSON: " << json_str) {
+            parser.feed(json_str);
+            BOOST_CHECK_EQUAL(condensed(parser.finish()), expected);
+            for (std::size_t split = 0; split <= json_str.size(); ++split) {
+                BOOST_TEST_CONTEXT("split at " << split) {
+                    BOOST_CHECK_EQUAL(condensed(feedSplit(parser, json_str, {split})), expected);
+                }
+            }
+
+            // По одному байту: каждый токен пересекает границу куска
+            JsonPushParser::Status status = JsonPushParser::Status::NeedMore;
+            for (char c : json_str) {
+                status = parser.feed(&c, 1);
+            }
+            // Число в конце входа может продолжиться в следующем куске
+            const char last = json_str.back();
+            if (!pocotest::detail::isDigit(last)) {
+                BOOST_CHECK(status == JsonPushParser::Status::Complete);
+                BOOST_CHECK(parser.isComplete());
+            }
+            BOOST_CHECK_EQUAL(condensed(parser.finish()), expected);
+            BOOST_CHECK_EQUAL(parser.bytesConsumed(), json_str.size());
+        }
+    }
+}
+
+// Ошибка обнаруживается при любом разбиении некорректного документа
+BOOST_AUTO_TEST_CASE(TestRejectsMalformedAtEverySplit) {
+    JsonPushParser parser;
+    for (const auto& json_str : malformedDocuments()) {
+        BOOST_TEST_CONTEXT("Invalid JSON: " << json_str) {
+            for (std::size_t split = 0; split <= json_str.size(); ++split) {
+                BOOST_TEST_CONTEXT("split at " << split) {
+                    BOOST_CHECK_THROW(feedSplit(parser, json_str, {split}), JSONException);
+                }
+            }
+            std::vector<std::size_t> every_byte;
+            for (std::size_t offset = 1; offset < json_str.size(); ++offset) {
+                every_byte.push_back(offset);
+            }
+            BOOST_CHECK_THROW(feedSplit(parser, json_str, every_byte), JSONException);
+
+            // После ошибки тот же экземпляр разбирает следующий документ
+            parser.feed(std::string_view("{\"after\": \"error\"}"));
+            BOOST_CHECK_EQUAL(condensed(parser.finish()), "{\"after\":\"error\"}");
+        }
+    }
+}
+
+// Длинные строки и числа, разрезанные мелкими кусками; внутренний буфер
+// хранит только незаконченный токен, а не весь документ
+BOOST_AUTO_TEST_CASE(TestLongTokensAcrossChunks) {
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        text += "chunk \\\"" + std::to_string(i) + "\\\" \\u00e9 \\ud83d\\ude00 ё\\n";
+    }
+    const std::string json = "{\"text\": \"" + text + "\", \"big\": 1" + std::string(100, '0') +
+                              ".5, \"long_int\": " + std::string(80, '7') + "e-70, \"tail\": [true]}";
+
+    Parser one_shot;
+    const std::string expected = condensed(one_shot.parse(json));
+    for (std::size_t chunk : {1u, 3u, 7u, 64u, 65u, 4096u}) {
+        BOOST_TEST_CONTEXT("chunk " << chunk) {
+            JsonPushParser parser;
+            JsonPushParser::Status status = JsonPushParser::Status::NeedMore;
+            for (std::size_t offset = 0; offset < json.size(); offset += chunk) {
+                status = parser.feed(std::string_view(json).substr(offset, chunk));
+            }
+            BOOST_CHECK_LT(parser.pendingCapacity(), json.size() / 10);
+            BOOST_CHECK(status == JsonPushParser::Status::Complete);
+            BOOST_CHECK_EQUAL(condensed(parser.finish()), expected);
+        }
+    }
+}
+
+// Состояние документа: завершение, пробелы после конца, число верхнего
+// уровня, повторное использование
+BOOST_AUTO_TEST_CASE(TestStatusAndReuse) {
+    JsonPushParser parser;
+    BOOST_CHECK(parser.feed(std::string_view("{\"a\":")) == JsonPushParser::Status::NeedMore);
+    BOOST_CHECK(!parser.isComplete());
+    BOOST_CHECK_EQUAL(parser.bytesConsumed(), 5u);
+    BOOST_CHECK(parser.feed(std::string_view(" [1, 2")) == JsonPushParser::Status::NeedMore);
+    BOOST_CHECK(parser.feed(std::string_view("]}")) == JsonPushParser::Status::Complete);
+    BOOST_CHECK(parser.feed(std::string_view(" \r\n")) == JsonPushParser::Status::Complete);
+    BOOST_CHECK_EQUAL(condensed(parser.finish()), "{\"a\":[1,2]}");
+
+    // Документ из одного числа заканчивается только в finish()
+    BOOST_CHECK(parser.feed(std::string_view("12")) == JsonPushParser::Status::NeedMore);
+    BOOST_CHECK(parser.feed(std::string_view("34")) == JsonPushParser::Status::NeedMore);
+    BOOST_CHECK_EQUAL(parser.finish().convert<Poco::Int64>(), 1234);
+    BOOST_CHECK(parser.feed(std::string_view("5 ")) == JsonPushParser::Status::Complete);
+    BOOST_CHECK_EQUAL(parser.finish().convert<Poco::Int64>(), 5);
+
+    // Лишние символы после конца документа
+    BOOST_CHECK(parser.feed(std::string_view("[]")) == JsonPushParser::Status::Complete);
+    BOOST_CHECK_THROW(parser.feed(std::string_view(" x")), JSONException);
+
+    // reset() отбрасывает незаконченный документ
+    parser.feed(std::string_view("{\"unfinished\": [\"abc"));
+    parser.reset();
+    BOOST_CHECK_THROW(parser.finish(), JSONException);
+    parser.feed(std::string_view("[\"abc\"]"));
+    BOOST_CHECK_EQUAL(condensed(parser.finish()), "[\"abc\"]");
+}
+
+// Ограничение глубины - как у JsonReader, при любом разбиении
+BOOST_AUTO_TEST_CASE(TestDepthLimit) {
+    // Пустой внутренний массив глубину не увеличивает: 12 скобок - 11 уровней
+    const std::string nested = std::string(12, '[') + std::string(12, ']');
+    const std::string allowed = "[[[[[[[[[[]]]]]]]]]]";
+
+    JsonPushParser parser;
+    parser.setDepth(10);
+    BOOST_CHECK_EQUAL(parser.getDepth(), 10u);
+    pocotest::JsonReader reader;
+    reader.setDepth(10);
+    BOOST_CHECK_THROW(reader.parse(std::string_view(nested)), JSONException);
+    BOOST_CHECK_NO_THROW(reader.parse(std::string_view(allowed)));
+    for (std::size_t split = 0; split <= nested.size(); ++split) {
+        BOOST_TEST_CONTEXT("split at " << split) {
+            BOOST_CHECK_THROW(feedSplit(parser, nested, {split}), JSONException);
+            BOOST_CHECK_NO_THROW(feedSplit(parser, allowed, {std::min(split, allowed.size())}));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
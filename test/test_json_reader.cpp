@@ -0,0 +1,475 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Exception.h>
+#include <Poco/TemporaryFile.h>
+
+#include "json_reader.h"
+#include "json_writer.h"
+#include "json_cases.h"
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::JsonReader;
+using pocotest::JsonWriter;
+using pocotest::condensed;
+
+namespace {
+
+const std::vector<std::string>& validDocuments() {
+    static const std::vector<std::string> documents = {
+        "{}",
+        "[]",
+        "  \t\r\n{ }  ",
+        "42",
+        "-0.5e-3",
+        "\"top level\"",
+        "null",
+        R"({"company": "Poco", "active": true, "count": 42, "ratio": 0.5, "none": null})",
+        R"([1, -2, 3.25, "four", false, null, [], {}, [[[]]]])",
+        R"({"menu": {"id": "file", "menuitem": [{"value": "New"}, {"value": "Open", "extra": [1, [2, [3]]]}]}})",
+        R"({"escaped": "line\nbreak \"quoted\" back\\slash \/ \b\f\r\t \u00e9 \ud83d\ude00 ©"})",
+        R"({"max_int64": 9223372036854775807, "min_int64": -9223372036854775808, "big": 18446744073709551615})",
+        R"({"exp": [1e10, 1E-5, -2.5e+3, 0.0, -0]})",
+        R"({"b": 1, "a": 2, "b": 3})",
+    };
+    return documents;
+}
+
+// Поток, генерирующий массив из records записей по мере чтения: документ
+// любого размера без хранения в памяти
+class RecordStreamBuf : public std::streambuf {
+public:
+    explicit RecordStreamBuf(std::size_t records)
+        : records_(records) {
+    }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        if (!nextPiece()) {
+            return traits_type::eof();
+        }
+        char* data = &piece_[0];
+        setg(data, data, data + piece_.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    bool nextPiece() {
+        if (index_ > records_) {
+            return false;
+        }
+        piece_.clear();
+        if (index_ == 0) {
+            piece_ += '[';
+        }
+        if (index_ < records_) {
+            if (index_ > 0) {
+                piece_ += ",\n";
+            }
+            piece_ += R"({"id": )" + std::to_string(index_) +
+                      R"(, "name": "record \u00e9 )" + std::to_string(index_) +
+                      R"(", "tags": ["a", "\u00A9", "c"], "score": 0.5, "ok": true, "none": null})";
+        } else {
+            piece_ += ']';
+        }
+        ++index_;
+        return true;
+    }
+
+    std::size_t records_;
+    std::size_t index_ = 0;
+    std::string piece_;
+};
+
+// Считает события, не строя дерево
+class CountingHandler : public pocotest::SaxHandler {
+public:
+    void reset() override {
+        objects = 0;
+        values = 0;
+        depth = 0;
+        maxDepth = 0;
+    }
+
+    void startObject() override {
+        ++objects;
+        enter();
+    }
+
+    void endObject() override {
+        --depth;
+    }
+
+    void startArray() override {
+        enter();
+    }
+
+    void endArray() override {
+        --depth;
+    }
+
+    void null() override {
+        ++values;
+    }
+
+    void value(Poco::Int64) override {
+        ++values;
+    }
+
+    void value(const std::string&) override {
+        ++values;
+    }
+
+    void value(double) override {
+        ++values;
+    }
+
+    void value(bool) override {
+        ++values;
+    }
+
+    std::size_t objects = 0;
+    std::size_t values = 0;
+    std::size_t depth = 0;
+    std::size_t maxDepth = 0;
+
+private:
+    void enter() {
+        ++depth;
+        maxDepth = std::max(maxDepth, depth);
+    }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonReaderTests)
+
+// Разбор string_view должен давать то же дерево, что и Parser::parse
+BOOST_AUTO_TEST_CASE(TestReaderMatchesParser) {
+    JsonReader reader;
+    for (const auto& json_str : validDocuments()) {
+        BOOST_TEST_CONTEXT("JSON: " << json_str) {
+            Parser parser;
+            Poco::Dynamic::Var expected = parser.parse(json_str);
+            Poco::Dynamic::Var actual = reader.parse(std::string_view(json_str));
+            BOOST_CHECK_EQUAL(condensed(actual), condensed(expected));
+        }
+    }
+}
+
+// Разбор фрагмента буфера: за концом диапазона может лежать что угодно
+BOOST_AUTO_TEST_CASE(TestReaderParsesSubrange) {
+    const std::string buffer = R"(garbage{"id": 7, "tags": ["a", "b"]}{"next": "document")";
+    const std::size_t begin = buffer.find('{');
+    const std::size_t end = buffer.find('}') + 1;
+
+    JsonReader reader;
+    Poco::Dynamic::Var result = reader.parse(buffer.data() + begin, end - begin);
+    Object::Ptr obj = result.extract<Object::Ptr>();
+    BOOST_CHECK_EQUAL(obj->getValue<int>("id"), 7);
+    BOOST_CHECK_EQUAL(obj->getArray("tags")->size(), 2u);
+
+    // Число на границе диапазона не должно "дочитываться" из буфера
+    const std::string digits = "12345";
+    Poco::Dynamic::Var number = reader.parse(digits.data(), 3);
+    BOOST_CHECK_EQUAL(number.convert<int>(), 123);
+}
+
+// Некорректные документы отвергаются так же, как Parser
+BOOST_AUTO_TEST_CASE(TestReaderRejectsMalformed) {
+    const std::vector<std::string> invalid_json_cases = {
+        "{", "}", "[", "]",
+        "{\"key\": }",
+        "{\"key\":",
+        "[\"item\", ]",
+        "{\"key\": \"value\",}",
+        "{\"key\": \"value\" \"key2\": \"value2\"}",
+        "{key: \"value\"}",
+        "'single_quoted'",
+        "{\"unclosed_string\": \"value}",
+        "{\"bad_escape\": \"\\x\"}",
+        "{\"number\": 123abc}",
+        "{\"control_char\": \"\x01\"}",
+        "/* comment */ {}",
+        "",
+        "   ",
+        "01", "1.", ".5", "-", "1e", "tru", "truex",
+        "[1 2]", "{\"a\" 1}", "{}{}", "[1]x",
+        "\"\\ud800\"", "\"\\udc00\"",
+        "\"\xff\"", "\"\xc0\x80\"", "\"\xed\xa0\x80\"",
+    };
+
+    JsonReader reader;
+    for (const auto& json_str : invalid_json_cases) {
+        BOOST_TEST_CONTEXT("Invalid JSON: " << json_str) {
+            BOOST_CHECK_THROW(reader.parse(std::string_view(json_str)), JSONException);
+            // Тот же экземпляр после ошибки разбирает корректный документ
+            BOOST_CHECK_NO_THROW(reader.parse(std::string_view("{}")));
+        }
+    }
+}
+
+// Ограничение глубины вложенности
+BOOST_AUTO_TEST_CASE(TestReaderDepthLimit) {
+    const std::string nested = std::string(100, '[') + std::string(100, ']');
+
+    JsonReader reader;
+    BOOST_CHECK_NO_THROW(reader.parse(std::string_view(nested)));
+
+    reader.setDepth(10);
+    BOOST_CHECK_EQUAL(reader.getDepth(), 10u);
+    BOOST_CHECK_THROW(reader.parse(std::string_view(nested)), JSONException);
+    BOOST_CHECK_NO_THROW(reader.parse(std::string_view("[[[[[[[[[[]]]]]]]]]]")));
+}
+
+// Результат записи в буфер совпадает с Stringifier::condense
+BOOST_AUTO_TEST_CASE(TestWriterMatchesStringifier) {
+    std::string out;
+    for (const auto& json_str : validDocuments()) {
+        BOOST_TEST_CONTEXT("JSON: " << json_str) {
+            Parser parser;
+            Poco::Dynamic::Var tree = parser.parse(json_str);
+            pocotest::stringifyTo(tree, out);
+            BOOST_CHECK_EQUAL(out, condensed(tree));
+        }
+    }
+}
+
+// Значения, построенные вручную: типы, которых нет в результатах Parser
+BOOST_AUTO_TEST_CASE(TestWriterValueTypes) {
+    Object::Ptr obj = new Object();
+    obj->set("int", 42);
+    obj->set("unsigned", 42u);
+    obj->set("int64", std::numeric_limits<Poco::Int64>::min());
+    obj->set("uint64", std::numeric_limits<Poco::UInt64>::max());
+    obj->set("double", 3.14159);
+    obj->set("float", 0.25f);
+    obj->set("nan", std::numeric_limits<double>::quiet_NaN());
+    obj->set("bool", true);
+    obj->set("empty", Poco::Dynamic::Var());
+    obj->set("char", 'x');
+    obj->set("short", static_cast<short>(-7));
+
+    Array::Ptr arr = new Array();
+    arr->add(Object());
+    arr->add(Array());
+    obj->set("array", arr);
+
+    std::string out;
+    pocotest::stringifyTo(obj, out);
+    BOOST_CHECK_EQUAL(out, condensed(obj));
+}
+
+// Экранирование строк совпадает с Poco::toJSON во всех режимах
+BOOST_AUTO_TEST_CASE(TestWriterEscaping) {
+    std::string all_bytes;
+    for (int c = 1; c < 256; ++c) {
+        all_bytes += static_cast<char>(c);
+    }
+    const std::vector<std::string> test_strings = {
+        "",
+        "plain",
+        "\"quotes\"",
+        "back\\slash",
+        "slash/in/path",
+        "line\nbreak\r\ttab\b\f",
+        std::string("nul\0byte", 8),
+        "\x01\x1f\x7f",
+        "utf8 © ∑ 😀",
+        all_bytes,
+    };
+    const std::vector<int> option_sets = {
+        Poco::JSON_WRAP_STRINGS,
+        Poco::JSON_WRAP_STRINGS | Poco::JSON_LOWERCASE_HEX,
+        Poco::JSON_WRAP_STRINGS | Poco::JSON_ESCAPE_UNICODE,
+        0,
+    };
+
+    std::string out;
+    for (int options : option_sets) {
+        for (const auto& str : test_strings) {
+            BOOST_TEST_CONTEXT("options " << options << ", string: " << str) {
+                Object::Ptr obj = new Object();
+                obj->set(str, str);
+                pocotest::stringifyTo(obj, out, options);
+                BOOST_CHECK_EQUAL(out, condensed(obj, options));
+
+                pocotest::stringifyTo(str, out, options);
+                BOOST_CHECK_EQUAL(out, condensed(str, options));
+            }
+        }
+    }
+}
+
+// С JSON_PRESERVE_KEY_ORDER порядок ключей тот же, что у condense: объект
+// с порядком вставки пишется в порядке вставки, остальные - по std::map.
+// Без опции все объекты обходятся по std::map
+BOOST_AUTO_TEST_CASE(TestWriterPreservesKeyOrder) {
+    Parser parser(new ParseHandler(true));
+    const Poco::Dynamic::Var parsed =
+        parser.parse(R"({"z": 1, "a": {"y": 2, "b": 3}, "m": [{"k": 4, "c": 5}], "b": {}})");
+
+    Object::Ptr built = new Object(Poco::JSON_PRESERVE_KEY_ORDER);
+    built->set("zeta", 1);
+    Object::Ptr plain = new Object();
+    plain->set("y", 2);
+    plain->set("b", 3);
+    built->set("plain", plain);
+    Object::Ptr nested = new Object(Poco::JSON_PRESERVE_KEY_ORDER);
+    nested->set("y", 2);
+    nested->set("b", 3);
+    Array::Ptr list = new Array();
+    list->add(nested);
+    built->set("list", list);
+    built->set("alpha", Object(*nested));
+
+    const int preserve = Poco::JSON_WRAP_STRINGS | Poco::JSON_PRESERVE_KEY_ORDER;
+    for (const Poco::Dynamic::Var& tree : {parsed, Poco::Dynamic::Var(built), Parser().parse(R"({"z": 1, "a": 2})")}) {
+        BOOST_TEST_CONTEXT("expected " << condensed(tree)) {
+            std::string out;
+            pocotest::stringifyTo(tree, out, preserve);
+            BOOST_CHECK_EQUAL(out, condensed(tree));
+        }
+    }
+
+    std::string out;
+    pocotest::stringifyTo(parsed, out, preserve);
+    BOOST_CHECK_EQUAL(out, R"({"z":1,"a":{"y":2,"b":3},"m":[{"k":4,"c":5}],"b":{}})");
+    pocotest::stringifyTo(built, out, preserve);
+    BOOST_CHECK_EQUAL(out, R"({"zeta":1,"plain":{"b":3,"y":2},"list":[{"y":2,"b":3}],"alpha":{"y":2,"b":3}})");
+
+    pocotest::stringifyTo(parsed, out);
+    BOOST_CHECK_EQUAL(out, R"({"a":{"b":3,"y":2},"b":{},"m":[{"c":5,"k":4}],"z":1})");
+    pocotest::stringifyTo(built, out);
+    BOOST_CHECK_EQUAL(out, R"({"alpha":{"b":3,"y":2},"list":[{"b":3,"y":2}],"plain":{"b":3,"y":2},"zeta":1})");
+}
+
+// Буфер дописывается и сохраняет ёмкость между документами
+BOOST_AUTO_TEST_CASE(TestWriterReusesBuffer) {
+    Parser parser;
+    Poco::Dynamic::Var big = parser.parse(R"({"data": ")" + std::string(10000, 'x') + R"("})");
+    Poco::Dynamic::Var small = Parser().parse(R"([1,2])");
+
+    std::string out;
+    pocotest::stringifyTo(big, out);
+    const std::size_t capacity = out.capacity();
+    pocotest::stringifyTo(small, out);
+    BOOST_CHECK_EQUAL(out, "[1,2]");
+    BOOST_CHECK_EQUAL(out.capacity(), capacity);
+
+    // write() дописывает в конец, не очищая буфер
+    JsonWriter writer;
+    out = "prefix:";
+    writer.write(small, out);
+    BOOST_CHECK_EQUAL(out, "prefix:[1,2]");
+}
+
+// Запись и разбор через буферы без потоков дают исходный документ
+BOOST_AUTO_TEST_CASE(TestReaderWriterRoundTrip) {
+    JsonReader reader;
+    std::string out;
+    for (const auto& json_str : validDocuments()) {
+        BOOST_TEST_CONTEXT("JSON: " << json_str) {
+            Poco::Dynamic::Var tree = reader.parse(std::string_view(json_str));
+            pocotest::stringifyTo(tree, out);
+            const std::string first = out;
+            pocotest::stringifyTo(reader.parse(std::string_view(first)), out);
+            BOOST_CHECK_EQUAL(out, first);
+        }
+    }
+}
+
+// Потоковый разбор при любом размере блока и любом положении границ блоков
+// даёт то же дерево, что и разбор буфера
+BOOST_AUTO_TEST_CASE(TestStreamMatchesBuffer) {
+    JsonReader buffer_reader;
+    JsonReader stream_reader;
+    for (const auto& json_str : validDocuments()) {
+        const std::string expected = condensed(buffer_reader.parse(std::string_view(json_str)));
+        for (std::size_t chunk : {16u, 17u, 23u, 64u, 65536u}) {
+            stream_reader.setChunkSize(chunk);
+            for (std::size_t shift = 0; shift < 20; ++shift) {
+                BOOST_TEST_CONTEXT("chunk " << chunk << ", shift " << shift << ", JSON: " << json_str) {
+                    std::istringstream in(std::string(shift, ' ') + json_str);
+                    BOOST_CHECK_EQUAL(condensed(stream_reader.parse(in)), expected);
+                }
+            }
+        }
+    }
+}
+
+// Ошибки обнаруживаются и на границах блоков, в том числе обрезанный UTF-8
+BOOST_AUTO_TEST_CASE(TestStreamRejectsMalformed) {
+    std::vector<std::string> documents = pocotest::malformedJsonCases();
+    documents.push_back("\"abc\xe2\x88\"");
+    documents.push_back("\"abcdefghijklmn\xc3");
+    documents.push_back("[\"" + std::string(30, 'x') + "\\u12\"]");
+    documents.push_back("[" + std::string(30, ' ') + "1.]");
+
+    JsonReader reader;
+    reader.setChunkSize(16);
+    for (const auto& json_str : documents) {
+        BOOST_TEST_CONTEXT("Invalid JSON: " << json_str) {
+            std::istringstream in(json_str);
+            BOOST_CHECK_THROW(reader.parse(in), JSONException);
+        }
+    }
+    std::istringstream valid("{}");
+    BOOST_CHECK_NO_THROW(reader.parse(valid));
+}
+
+// Память читателя не зависит от размера документа: блок фиксирован,
+// буфер строк - по самой длинной строке
+BOOST_AUTO_TEST_CASE(TestStreamBoundedMemory) {
+    const std::size_t records = 100000;
+    RecordStreamBuf buf(records);
+    std::istream in(&buf);
+
+    Poco::SharedPtr<CountingHandler> handler = new CountingHandler();
+    JsonReader reader(handler);
+    reader.setChunkSize(4096);
+    reader.parse(in);
+
+    BOOST_CHECK_EQUAL(handler->objects, records);
+    BOOST_CHECK_EQUAL(handler->values, records * 8);
+    BOOST_CHECK_EQUAL(handler->maxDepth, 3u);
+    BOOST_CHECK_EQUAL(handler->depth, 0u);
+    BOOST_CHECK_GT(reader.bytesConsumed(), records * 90);
+    BOOST_CHECK_EQUAL(reader.chunkCapacity(), 4096u);
+    BOOST_CHECK_LT(reader.scratchCapacity(), 256u);
+}
+
+// Разбор файла и ошибка открытия
+BOOST_AUTO_TEST_CASE(TestParseFile) {
+    Poco::TemporaryFile file;
+    {
+        std::ofstream out(file.path(), std::ios::binary);
+        out << R"({"menu": {"id": "file", "items": [1, 2, 3]}})";
+    }
+
+    JsonReader reader;
+    Poco::Dynamic::Var result = reader.parseFile(file.path());
+    BOOST_CHECK_EQUAL(condensed(result), R"({"menu":{"id":"file","items":[1,2,3]}})");
+
+    BOOST_CHECK_THROW(reader.parseFile(file.path() + ".missing"), Poco::FileNotFoundException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
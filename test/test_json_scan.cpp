@@ -0,0 +1,277 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+
+#include "json_scan.h"
+#include "json_reader.h"
+#include "json_writer.h"
+#include "json_cases.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::JsonReader;
+using pocotest::condensed;
+namespace scan = pocotest::scan;
+
+namespace {
+
+// Уровни, которые можно проверить на этом процессоре
+std::vector<scan::Level> availableLevels() {
+    std::vector<scan::Level> levels = {scan::Level::Scalar};
+    if (scan::supportedLevel() >= scan::Level::SSE42) {
+        levels.push_back(scan::Level::SSE42);
+    }
+    if (scan::supportedLevel() >= scan::Level::AVX2) {
+        levels.push_back(scan::Level::AVX2);
+    }
+    return levels;
+}
+
+// Временно переключает уровень для JsonReader
+struct LevelGuard {
+    explicit LevelGuard(scan::Level level)
+        : previous(scan::activeLevel()) {
+        scan::setLevel(level);
+    }
+
+    ~LevelGuard() {
+        scan::setLevel(previous);
+    }
+
+    scan::Level previous;
+};
+
+// Эталонная побайтная проверка UTF-8
+const char* validateUtf8Reference(const char* p, const char* end) {
+    while (p != end) {
+        const std::size_t length = scan::utf8SequenceLength(p, end);
+        if (length == 0) {
+            return p;
+        }
+        p += length;
+    }
+    return end;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonScanTests)
+
+// Каждая функция каждого уровня совпадает со скалярной при любом положении
+// искомого байта и любой длине хвоста после векторных блоков
+BOOST_AUTO_TEST_CASE(TestKernelsMatchScalar) {
+    const scan::Kernels& scalar = scan::kernels(scan::Level::Scalar);
+    const std::string fillers[] = {"a", " ", "\xc3\xa9"};
+    const char specials[] = {'"', '\\', '/', '\0', '\x1f', '\x20', ' ', '\t', '\n', '\r', 'x', '\x7e', '\x7f', '\x80', '\xff',
+                             '{', '}', '[', ']', '\x5c', '\x7c', '\xdb', '\xfb'};
+
+    for (scan::Level level : availableLevels()) {
+        const scan::Kernels& k = scan::kernels(level);
+        BOOST_TEST_CONTEXT("level " << scan::levelName(level)) {
+            BOOST_CHECK(k.level == level);
+            for (const auto& filler : fillers) {
+                std::string buffer;
+                while (buffer.size() < 80) {
+                    buffer += filler;
+                }
+                for (char special : specials) {
+                    for (std::size_t pos = 0; pos <= buffer.size(); ++pos) {
+                        std::string data = buffer;
+                        if (pos < data.size()) {
+                            data[pos] = special;
+                        }
+                        const char* begin = data.data();
+                        const char* end = begin + data.size();
+                        for (std::size_t offset = 0; offset < 40; ++offset) {
+                            BOOST_REQUIRE_EQUAL(k.stringRun(begin + offset, end) - begin,
+                                                scalar.stringRun(begin + offset, end) - begin);
+                            BOOST_REQUIRE_EQUAL(k.skipWhitespace(begin + offset, end) - begin,
+                                                scalar.skipWhitespace(begin + offset, end) - begin);
+                            BOOST_REQUIRE_EQUAL(k.asciiRun(begin + offset, end) - begin,
+                                                scalar.asciiRun(begin + offset, end) - begin);
+                            BOOST_REQUIRE_EQUAL(k.escapeRun(begin + offset, end) - begin,
+                                                scalar.escapeRun(begin + offset, end) - begin);
+                            BOOST_REQUIRE_EQUAL(k.escapeUnicodeRun(begin + offset, end) - begin,
+                                                scalar.escapeUnicodeRun(begin + offset, end) - begin);
+                            BOOST_REQUIRE_EQUAL(k.structuralRun(begin + offset, end) - begin,
+                                                scalar.structuralRun(begin + offset, end) - begin);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Векторная проверка UTF-8 совпадает с побайтной на случайных данных
+BOOST_AUTO_TEST_CASE(TestValidateUtf8MatchesReference) {
+    const std::vector<std::string> pieces = {
+        "a", "json ", "\xc2\xa9", "\xe2\x88\x91", "\xf0\x9f\x98\x80",
+        "\xc0\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff", "\x80", "\xe2\x88",
+    };
+    std::mt19937 rng(20250101u);
+    std::uniform_int_distribution<std::size_t> pick(0, pieces.size() - 1);
+    std::uniform_int_distribution<int> valid_only(0, 3);
+
+    for (scan::Level level : availableLevels()) {
+        const scan::Kernels& k = scan::kernels(level);
+        for (int round = 0; round < 2000; ++round) {
+            std::string data;
+            const bool clean = valid_only(rng) != 0;
+            const std::size_t count = 1 + round % 64;
+            for (std::size_t i = 0; i < count; ++i) {
+                std::size_t piece = pick(rng);
+                if (clean) {
+                    piece %= 5;
+                }
+                data += pieces[piece];
+            }
+            const char* begin = data.data();
+            const char* end = begin + data.size();
+            BOOST_TEST_CONTEXT("level " << scan::levelName(level) << ", round " << round) {
+                BOOST_REQUIRE_EQUAL(scan::validateUtf8(k, begin, end) - begin,
+                                    validateUtf8Reference(begin, end) - begin);
+            }
+        }
+    }
+}
+
+// Некорректные документы отвергаются на каждом уровне
+BOOST_AUTO_TEST_CASE(TestReaderRejectsMalformedAtEveryLevel) {
+    std::vector<std::string> documents = pocotest::malformedJsonCases();
+    // Ошибки за пределами первого векторного блока
+    const std::string padding(70, ' ');
+    documents.push_back("{\"long\": \"" + std::string(100, 'x') + "\x01\"}");
+    documents.push_back("[" + padding + "\"" + std::string(100, 'x') + "\xc3\x28\"]");
+    documents.push_back("[" + padding + "1" + padding + "2]");
+    documents.push_back("{\"unterminated\": \"" + std::string(100, 'x'));
+
+    for (scan::Level level : availableLevels()) {
+        LevelGuard guard(level);
+        JsonReader reader;
+        for (const auto& json_str : documents) {
+            BOOST_TEST_CONTEXT("level " << scan::levelName(level) << ", JSON: " << json_str) {
+                BOOST_CHECK_THROW(reader.parse(std::string_view(json_str)), JSONException);
+            }
+        }
+    }
+}
+
+// Строки с экранированием и Unicode разбираются одинаково на каждом уровне
+BOOST_AUTO_TEST_CASE(TestReaderEscapingAtEveryLevel) {
+    std::vector<std::string> test_strings = pocotest::escapeTestStrings();
+    test_strings.push_back(std::string(1000, 'x'));
+    test_strings.push_back(std::string(100, 'x') + "\"" + std::string(100, '\\') + "\n\xc2\xa9" + std::string(40, 'y'));
+    test_strings.push_back(std::string(64, ' ') + "\xe2\x88\x91\xf0\x9f\x98\x80" + std::string(64, '\t'));
+
+    for (scan::Level level : availableLevels()) {
+        LevelGuard guard(level);
+        JsonReader reader;
+        for (const auto& input : test_strings) {
+            BOOST_TEST_CONTEXT("level " << scan::levelName(level) << ", string: " << input) {
+                Object::Ptr obj = new Object();
+                obj->set("str", input);
+                std::stringstream ss;
+                obj->stringify(ss, 0);
+
+                Poco::Dynamic::Var parsed = reader.parse(std::string_view(ss.str()));
+                BOOST_CHECK_EQUAL(parsed.extract<Object::Ptr>()->getValue<std::string>("str"), input);
+            }
+        }
+    }
+}
+
+// Большие документы (как в TestMemoryAndPerformance) дают одно и то же
+// дерево на каждом уровне
+BOOST_AUTO_TEST_CASE(TestReaderLargeDocumentsAtEveryLevel) {
+    Array::Ptr numbers = new Array();
+    for (int i = 0; i < 5000; ++i) {
+        numbers->add(i * 7 - 1000);
+    }
+    Object::Ptr obj = new Object();
+    obj->set("numbers", numbers);
+    obj->set("moderate_string", std::string(1000, 'x'));
+
+    std::stringstream pretty;
+    obj->stringify(pretty, 4);
+    const std::string expected = condensed(obj);
+
+    for (scan::Level level : availableLevels()) {
+        LevelGuard guard(level);
+        JsonReader reader;
+        BOOST_TEST_CONTEXT("level " << scan::levelName(level)) {
+            BOOST_CHECK_EQUAL(condensed(reader.parse(std::string_view(expected))), expected);
+            BOOST_CHECK_EQUAL(condensed(reader.parse(std::string_view(pretty.str()))), expected);
+        }
+    }
+}
+
+// Запись строк JsonWriter на каждом уровне совпадает с текущим выводом
+// Object::stringify - для строк из TestStringEscapingAndUnicode и
+// TestEncodingAndSpecialCharacters и для длинных строк, где экранируемые
+// байты попадают в разные места векторных блоков
+BOOST_AUTO_TEST_CASE(TestWriterEscapingAtEveryLevel) {
+    std::vector<std::string> test_strings = pocotest::escapeTestStrings();
+    for (const auto& test_case : pocotest::encodingTestCases()) {
+        test_strings.push_back(test_case.input);
+    }
+    const std::string log_line = "2025-01-01T00:00:00Z INFO request handled path=/api/v1/items status=200";
+    test_strings.push_back(log_line + log_line + log_line);
+    for (const char* special : {"\"", "\\", "/", "\n", "\x01", "\x7f", "\xc2\xa9", "\xf0\x9f\x98\x80", "\xff"}) {
+        for (std::size_t pos : {0u, 15u, 16u, 31u, 32u, 33u, 63u, 64u, 100u}) {
+            std::string str(101, 'x');
+            str.insert(pos, special);
+            test_strings.push_back(str);
+        }
+    }
+    std::string all_bytes;
+    for (int c = 1; c < 256; ++c) {
+        all_bytes += static_cast<char>(c);
+    }
+    test_strings.push_back(all_bytes + all_bytes);
+    // Байты продолжения UTF-8 сразу после ASCII
+    test_strings.push_back(std::string(40, 'a') + "\x80\x80" + std::string(40, 'b') + "\xbf");
+
+    const std::vector<int> option_sets = {
+        Poco::JSON_WRAP_STRINGS,
+        Poco::JSON_WRAP_STRINGS | Poco::JSON_LOWERCASE_HEX,
+        Poco::JSON_WRAP_STRINGS | Poco::JSON_ESCAPE_UNICODE,
+        Poco::JSON_WRAP_STRINGS | Poco::JSON_ESCAPE_UNICODE | Poco::JSON_LOWERCASE_HEX,
+    };
+
+    for (scan::Level level : availableLevels()) {
+        LevelGuard guard(level);
+        for (int options : option_sets) {
+            const pocotest::JsonWriter writer(options);
+            std::string out;
+            for (const auto& input : test_strings) {
+                BOOST_TEST_CONTEXT("level " << scan::levelName(level) << ", options " << options
+                                   << ", string: " << input) {
+                    Object::Ptr obj = new Object();
+                    obj->set("str", input);
+                    obj->setEscapeUnicode((options & Poco::JSON_ESCAPE_UNICODE) != 0);
+                    obj->setLowercaseHex((options & Poco::JSON_LOWERCASE_HEX) != 0);
+                    std::stringstream ss;
+                    obj->stringify(ss, 0);
+
+                    out.clear();
+                    writer.write(obj, out);
+                    BOOST_CHECK_EQUAL(out, ss.str());
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,173 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/Template.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/TemporaryFile.h>
+#include <Poco/Timestamp.h>
+#include <Poco/Path.h>
+#include <Poco/File.h>
+
+#include "json_template.h"
+#include "json_cases.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::CompiledTemplate;
+using pocotest::condensed;
+
+namespace {
+
+Object::Ptr sampleData() {
+    Parser parser;
+    return parser.parse(R"({
+        "title": "Report",
+        "empty": "",
+        "count": 3,
+        "ratio": 0.5,
+        "enabled": true,
+        "disabled": false,
+        "none": null,
+        "meta": {"owner": "ops", "tags": []},
+        "users": [
+            {"name": "alice", "admin": true, "roles": ["read", "write"]},
+            {"name": "bob", "admin": false, "roles": []},
+            {"name": "carol", "roles": ["read"]}
+        ]
+    })").extract<Object::Ptr>();
+}
+
+std::string renderPoco(const std::string& source, const Object::Ptr& data) {
+    Template tpl;
+    tpl.parse(source);
+    std::ostringstream out;
+    tpl.render(data, out);
+    return out.str();
+}
+
+void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JsonTemplateTests)
+
+// Вывод совпадает с Poco::JSON::Template на тех же данных
+BOOST_AUTO_TEST_CASE(TestMatchesPocoTemplate) {
+    const std::vector<std::string> sources = {
+        "plain text without commands",
+        "<? echo title ?>: <?= count ?> / <?=ratio?>",
+        "{\"template\": \"<? echo title ?>\", \"missing\": \"<? echo nothing.here ?>\"}",
+        "<? echo meta ?>|<? echo users[1].name ?>|<? echo enabled ?>",
+        "<? if enabled ?>on<? else ?>off<? endif ?>",
+        "<? if disabled ?>a<? elsif empty ?>b<? elif none ?>c<? elif meta.tags ?>d<? else ?>e<? endif ?>",
+        "<? if count ?>count<? endif ?><? if meta ?> meta<? endif ?><? if title ?> title<? endif ?>",
+        "<? ifexist disabled ?>exists<? endif ?><? ifexist absent ?>absent<? else ?> no<? endif ?>",
+        "<? for user users ?>\n- <? echo user.name ?>\n<? endfor ?>\ndone",
+        "<? for user users ?><? echo user.name ?>:<? for role user.roles ?>[<? echo role ?>]<? endfor ?>"
+        "<? if user.admin ?>*<? endif ?>;<? endfor ?>",
+        "<? for user users ?><? echo title ?>/<? echo user.roles[0] ?> <? endfor ?><? for x absent ?>never<? endfor ?>",
+        "<? if enabled ?>\r\nline\r\n<? endif ?>\r\ntail",
+    };
+    for (const auto& source : sources) {
+        BOOST_TEST_CONTEXT("Template: " << source) {
+            const Object::Ptr data = sampleData();
+            const std::string expected = renderPoco(source, sampleData());
+            BOOST_CHECK_EQUAL(CompiledTemplate(source).render(data), expected);
+        }
+    }
+}
+
+// render() дописывает в буфер и не меняет данные, в отличие от <? for ?> в Poco
+BOOST_AUTO_TEST_CASE(TestRendersIntoReusedBuffer) {
+    const CompiledTemplate tpl("<? for user users ?><? echo user.name ?>,<? endfor ?>");
+    const Object::Ptr data = sampleData();
+    const std::string before = condensed(data);
+
+    std::string out = "prefix:";
+    tpl.render(data, out);
+    BOOST_CHECK_EQUAL(out, "prefix:alice,bob,carol,");
+    BOOST_CHECK_EQUAL(condensed(data), before);
+
+    out.clear();
+    const std::size_t capacity = out.capacity();
+    tpl.render(data, out);
+    BOOST_CHECK_EQUAL(out, "alice,bob,carol,");
+    BOOST_CHECK_EQUAL(out.capacity(), capacity);
+
+    // Переменная цикла закрывает одноимённый ключ данных только внутри цикла
+    Object::Ptr shadowed = sampleData();
+    shadowed->set("user", "outer");
+    BOOST_CHECK_EQUAL(CompiledTemplate("<? for user users ?><? echo user.name ?> <? endfor ?><? echo user ?>")
+                          .render(shadowed),
+                      "alice bob carol outer");
+}
+
+BOOST_AUTO_TEST_CASE(TestRejectsMalformed) {
+    const std::vector<std::string> invalid = {
+        "<? unknown ?>",
+        "<? echo title",
+        "<? echo ?>",
+        "<? for user ?>",
+        "<? endif ?>",
+        "<? endfor ?>",
+        "<? else ?>",
+        "<? for user users ?><? endif ?>",
+        "<? if title ?><? endfor ?>",
+        "<? if title ?>never closed",
+        "<? for user users ?>never closed",
+        "<? include ?>",
+    };
+    for (const auto& source : invalid) {
+        BOOST_TEST_CONTEXT("Template: " << source) {
+            BOOST_CHECK_THROW(CompiledTemplate tpl(source), Poco::Exception);
+        }
+    }
+    BOOST_CHECK_THROW(CompiledTemplate("<? include \"no_such_file.tpl\" ?>"), Poco::FileNotFoundException);
+}
+
+// Кэш перекомпилирует шаблон после изменения его файла или включения
+BOOST_AUTO_TEST_CASE(TestCacheInvalidation) {
+    Poco::TemporaryFile dir;
+    dir.createDirectories();
+    const std::string main = Poco::Path(dir.path(), "main.tpl").toString();
+    const std::string part = Poco::Path(dir.path(), "part.tpl").toString();
+    writeFile(part, "[<? echo user.name ?>]");
+    writeFile(main, "<? for user users ?><? include \"part.tpl\" ?><? endfor ?>");
+
+    pocotest::CompiledTemplateCache cache;
+    const Object::Ptr data = sampleData();
+    CompiledTemplate::Ptr tpl = cache.get(main);
+    BOOST_CHECK_EQUAL(tpl->render(data), "[alice][bob][carol]");
+    BOOST_CHECK_EQUAL(tpl->files().size(), 2u);
+    BOOST_CHECK(cache.get(main) == tpl);
+    BOOST_CHECK_EQUAL(cache.compilations(), 1u);
+
+    // Время изменения сдвигается явно: у файловой системы может быть
+    // секундная точность
+    writeFile(part, "(<? echo user.name ?>)");
+    Poco::File(part).setLastModified(Poco::Timestamp() + 2 * Poco::Timestamp::resolution());
+    BOOST_CHECK(tpl->isStale());
+    CompiledTemplate::Ptr updated = cache.get(main);
+    BOOST_CHECK(updated != tpl);
+    BOOST_CHECK_EQUAL(updated->render(data), "(alice)(bob)(carol)");
+    BOOST_CHECK_EQUAL(cache.compilations(), 2u);
+
+    // Старый шаблон остаётся рабочим у тех, кто его держит
+    BOOST_CHECK_EQUAL(tpl->render(data), "[alice][bob][carol]");
+
+    Poco::File(part).remove();
+    BOOST_CHECK(updated->isStale());
+    BOOST_CHECK_THROW(cache.get(main), Poco::FileNotFoundException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
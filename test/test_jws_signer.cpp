@@ -0,0 +1,297 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Crypto/RSAKey.h>
+#include <Poco/Exception.h>
+
+#include "bench_corpus.h"
+#include "jws_signer.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::JwsBatchSigner;
+using pocotest::JwsKey;
+using pocotest::JwsSigner;
+
+namespace {
+
+std::vector<Object::Ptr> makeRecords(int count) {
+    std::mt19937 rng(20250101u);
+    const Array::Ptr records = bench::makeLargeDocument(rng, count);
+    std::vector<Object::Ptr> result;
+    for (const auto& record : *records) {
+        result.push_back(record.extract<Object::Ptr>());
+    }
+    return result;
+}
+
+std::string canonical(const Object& object) {
+    std::string out;
+    pocotest::canonicalizeTo(object, out);
+    return out;
+}
+
+Object::Ptr parseObject(const std::string& json, bool preserveOrder = false) {
+    Parser parser(new ParseHandler(preserveOrder));
+    return parser.parse(json).extract<Object::Ptr>();
+}
+
+// Генерация ключа RSA дорогая, поэтому одна на все тесты
+const Poco::Crypto::RSAKey& rsaKey() {
+    static const Poco::Crypto::RSAKey key(Poco::Crypto::RSAKey::KL_2048, Poco::Crypto::RSAKey::EXP_LARGE);
+    return key;
+}
+
+// Только открытая часть rsaKey()
+Poco::Crypto::RSAKey rsaPublicKey() {
+    std::stringstream pem;
+    rsaKey().save(&pem);
+    return Poco::Crypto::RSAKey(&pem);
+}
+
+// Меняет символ в середине отрезка [begin, end) токена
+std::string tamper(std::string token, std::size_t begin, std::size_t end) {
+    char& c = token[begin + (end - begin) / 2];
+    c = c == 'A' ? 'B' : 'A';
+    return token;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(JwsSignerTests)
+
+// Ключи по порядку байтов на всех уровнях, без пробелов, независимо от
+// порядка вставки
+BOOST_AUTO_TEST_CASE(TestCanonicalFormIsSortedAndCompact) {
+    const std::string json = R"({"b": 1, "a": {"z": [true, null, "x"], "y": 2.5}, "A": "café", "_": -3})";
+    const std::string expected = "{\"A\":\"caf\xC3\xA9\",\"_\":-3,\"a\":{\"y\":2.5,\"z\":[true,null,\"x\"]},\"b\":1}";
+    BOOST_CHECK_EQUAL(canonical(*parseObject(json)), expected);
+    BOOST_CHECK_EQUAL(canonical(*parseObject(json, true)), expected);
+
+    Object built(Poco::JSON_PRESERVE_KEY_ORDER);
+    built.set("b", 1);
+    Object::Ptr nested = new Object(Poco::JSON_PRESERVE_KEY_ORDER);
+    Array::Ptr list = new Array();
+    list->add(true);
+    list->add(Poco::Dynamic::Var());
+    list->add("x");
+    nested->set("z", list);
+    nested->set("y", 2.5);
+    built.set("a", nested);
+    built.set("A", "caf\xC3\xA9");
+    built.set("_", -3);
+    BOOST_CHECK_EQUAL(canonical(built), expected);
+}
+
+// Одна и та же нагрузка, собранная объектами с порядком вставки и без
+// него (в том числе объектами внутри массивов), подписывается одинаково
+BOOST_AUTO_TEST_CASE(TestKeyOrderDoesNotChangeToken) {
+    const auto build = [](int options) {
+        Object::Ptr payload = new Object(options);
+        payload->set("sub", "1234567890");
+        Array::Ptr roles = new Array();
+        for (const char* role : {"writer", "admin"}) {
+            Object::Ptr entry = new Object(options);
+            entry->set("name", role);
+            entry->set("level", 2);
+            entry->set("active", true);
+            roles->add(entry);
+        }
+        payload->set("roles", roles);
+        Object nested(options);
+        nested.set("z", 1);
+        nested.set("a", Poco::Dynamic::Var());
+        payload->set("meta", nested);
+        payload->set("iat", 1516239022);
+        return payload;
+    };
+    const Object::Ptr ordered = build(Poco::JSON_PRESERVE_KEY_ORDER);
+    const Object::Ptr plain = build(0);
+    BOOST_REQUIRE(ordered->getNames() != plain->getNames());
+
+    JwsSigner signer(JwsKey::hmac("order secret"));
+    const std::string token = signer.sign(*plain);
+    BOOST_CHECK_EQUAL(signer.canonical(),
+                      R"({"iat":1516239022,"meta":{"a":null,"z":1},"roles":[{"active":true,"level":2,"name":"writer"},)"
+                      R"({"active":true,"level":2,"name":"admin"}],"sub":"1234567890"})");
+    BOOST_CHECK_EQUAL(signer.sign(*ordered), token);
+    BOOST_CHECK(signer.verify(*ordered, token));
+
+    // Разбор с сохранением порядка и stringify в порядке вставки не меняют
+    // канонический вид
+    std::ostringstream insertionOrder;
+    Stringifier::condense(ordered, insertionOrder);
+    BOOST_CHECK_EQUAL(canonical(*parseObject(insertionOrder.str(), true)), canonical(*plain));
+}
+
+// Разбор канонического текста, Stringifier и форматированный вывод Poco
+// не меняют канонический вид
+BOOST_AUTO_TEST_CASE(TestCanonicalizationSurvivesRoundTrips) {
+    std::vector<Object::Ptr> objects = makeRecords(50);
+    objects.push_back(parseObject(R"({"n": [0, -1, 1.5, 0.1, 1e-7, 12345678901234, 3.0e20], "s": "\"\\\b\f\n\r\t\u0001"})"));
+
+    for (const auto& object : objects) {
+        const std::string first = canonical(*object);
+        BOOST_TEST_CONTEXT("canonical: " << first) {
+            BOOST_CHECK_EQUAL(canonical(*parseObject(first)), first);
+            BOOST_CHECK_EQUAL(canonical(*parseObject(first, true)), first);
+
+            std::ostringstream condensed;
+            Stringifier::condense(object, condensed);
+            BOOST_CHECK_EQUAL(canonical(*parseObject(condensed.str(), true)), first);
+
+            std::ostringstream pretty;
+            Stringifier::stringify(object, pretty, 2);
+            BOOST_CHECK_EQUAL(canonical(*parseObject(pretty.str())), first);
+        }
+    }
+}
+
+// HS256 совпадает с независимым расчётом (Python hmac/hashlib)
+BOOST_AUTO_TEST_CASE(TestHmacKnownToken) {
+    Object payload;
+    payload.set("sub", "1234567890");
+    payload.set("name", "John Doe");
+    payload.set("admin", true);
+    payload.set("iat", 1516239022);
+
+    JwsSigner signer(JwsKey::hmac("your-256-bit-secret"));
+    const std::string expected =
+        "eyJhbGciOiJIUzI1NiJ9"
+        ".eyJhZG1pbiI6dHJ1ZSwiaWF0IjoxNTE2MjM5MDIyLCJuYW1lIjoiSm9obiBEb2UiLCJzdWIiOiIxMjM0NTY3ODkwIn0"
+        ".9FCBYR4uLrFA-63HYgnUX1A5tBqB0Y7Me1PaOq2ADz0";
+    BOOST_CHECK_EQUAL(signer.sign(payload), expected);
+    BOOST_CHECK_EQUAL(signer.canonical(), R"({"admin":true,"iat":1516239022,"name":"John Doe","sub":"1234567890"})");
+    // Контекст переиспользуется: повторная подпись даёт тот же токен
+    BOOST_CHECK_EQUAL(signer.sign(payload), expected);
+    BOOST_CHECK(signer.verify(expected));
+    BOOST_CHECK(signer.verify(payload, expected));
+}
+
+// Изменение любой части токена, другой ключ или другой payload - отказ;
+// некорректный токен - false, а не исключение
+BOOST_AUTO_TEST_CASE(TestHmacRejectsTampering) {
+    const std::vector<Object::Ptr> records = makeRecords(20);
+    JwsSigner signer(JwsKey::hmac("secret"));
+    JwsSigner other(JwsKey::hmac("secret2"));
+    std::string token;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        BOOST_TEST_CONTEXT("record " << i) {
+            signer.sign(*records[i], token);
+            BOOST_CHECK(signer.verify(token));
+            BOOST_CHECK(signer.verify(*records[i], token));
+            BOOST_CHECK(!other.verify(token));
+            BOOST_CHECK(!signer.verify(*records[(i + 1) % records.size()], token));
+
+            const std::size_t first = token.find('.');
+            const std::size_t second = token.find('.', first + 1);
+            BOOST_CHECK(!signer.verify(tamper(token, 0, first)));
+            BOOST_CHECK(!signer.verify(tamper(token, first + 1, second)));
+            BOOST_CHECK(!signer.verify(tamper(token, second + 1, token.size())));
+            BOOST_CHECK(!signer.verify(token.substr(0, token.size() - 1)));
+            BOOST_CHECK(!signer.verify(token + "A"));
+        }
+    }
+
+    for (const std::string bad : {"", ".", "..", "a.b", "a.b.c.d", "eyJhbGciOiJIUzI1NiJ9..",
+                                  "eyJhbGciOiJIUzI1NiJ9.e30.@@@", "eyJhbGciOiJSUzI1NiJ9.e30.AAAA"}) {
+        BOOST_CHECK_MESSAGE(!signer.verify(bad), "token: " << bad);
+    }
+}
+
+// RS256: подпись PKCS#1 v1.5 детерминирована, проверка открытым ключом,
+// подпись открытым ключом - исключение
+BOOST_AUTO_TEST_CASE(TestRsaSignAndVerify) {
+    const std::vector<Object::Ptr> records = makeRecords(8);
+    JwsSigner signer(JwsKey::rsa(rsaKey()));
+    JwsSigner verifier(JwsKey::rsa(rsaPublicKey()));
+    JwsSigner hmac(JwsKey::hmac("secret"));
+
+    std::string token;
+    for (const auto& record : records) {
+        signer.sign(*record, token);
+        const std::size_t second = token.rfind('.');
+        // 256 байт подписи - 342 символа base64url
+        BOOST_CHECK_EQUAL(token.size() - second - 1, 342u);
+        BOOST_CHECK_EQUAL(signer.sign(*record), token);
+        BOOST_CHECK(verifier.verify(token));
+        BOOST_CHECK(verifier.verify(*record, token));
+        BOOST_CHECK(!verifier.verify(tamper(token, second + 1, token.size())));
+        BOOST_CHECK(!verifier.verify(tamper(token, token.find('.') + 1, second)));
+        BOOST_CHECK(!hmac.verify(token));
+        BOOST_CHECK(!verifier.verify(hmac.sign(*record)));
+    }
+    BOOST_CHECK_THROW(verifier.sign(*records[0], token), Poco::Exception);
+}
+
+// Пакет в нескольких потоках даёт те же токены, что и один JwsSigner, и
+// переиспользуется между пакетами разного размера
+BOOST_AUTO_TEST_CASE(TestBatchMatchesSingleSigner) {
+    const std::vector<Object::Ptr> records = makeRecords(300);
+    const JwsKey key = JwsKey::hmac("batch secret");
+    JwsSigner single(key);
+    std::vector<std::string> expected;
+    for (const auto& record : records) {
+        expected.push_back(single.sign(*record));
+    }
+
+    for (unsigned threads : {1u, 3u, 8u}) {
+        BOOST_TEST_CONTEXT("threads " << threads) {
+            JwsBatchSigner batch(key, threads);
+            BOOST_CHECK_EQUAL(batch.getThreads(), threads);
+            std::vector<std::string> tokens;
+            std::vector<char> results;
+
+            const std::vector<Object::Ptr> few(records.begin(), records.begin() + 5);
+            batch.sign(few, tokens);
+            BOOST_CHECK(std::equal(tokens.begin(), tokens.end(), expected.begin()));
+
+            batch.sign(records, tokens);
+            BOOST_CHECK(tokens == expected);
+
+            batch.verify(records, tokens, results);
+            BOOST_CHECK(std::all_of(results.begin(), results.end(), [](char ok) { return ok != 0; }));
+
+            tokens[123] = tamper(tokens[123], tokens[123].rfind('.') + 1, tokens[123].size());
+            batch.verify(tokens, results);
+            BOOST_CHECK_EQUAL(std::count(results.begin(), results.end(), 0), 1);
+            BOOST_CHECK_EQUAL(results[123], 0);
+
+            batch.sign({}, tokens);
+            BOOST_CHECK(tokens.empty());
+            BOOST_CHECK_THROW(batch.verify(few, expected, results), Poco::InvalidArgumentException);
+        }
+    }
+}
+
+// Пакет RS256 проверяется открытым ключом; ошибка ключа в потоке пула
+// доходит до вызывающего
+BOOST_AUTO_TEST_CASE(TestRsaBatch) {
+    const std::vector<Object::Ptr> records = makeRecords(40);
+    JwsBatchSigner signer(JwsKey::rsa(rsaKey()), 4);
+    JwsBatchSigner verifier(JwsKey::rsa(rsaPublicKey()), 4);
+
+    std::vector<std::string> tokens;
+    std::vector<char> results;
+    signer.sign(records, tokens);
+    verifier.verify(records, tokens, results);
+    BOOST_CHECK_EQUAL(std::count(results.begin(), results.end(), 1), 40);
+
+    std::vector<std::string> failed;
+    BOOST_CHECK_THROW(verifier.sign(records, failed), Poco::Exception);
+    // После ошибки пул пригоден для следующего пакета
+    verifier.verify(tokens, results);
+    BOOST_CHECK_EQUAL(std::count(results.begin(), results.end(), 1), 40);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
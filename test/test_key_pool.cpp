@@ -0,0 +1,89 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "key_pool.h"
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using pocotest::KeyPool;
+using pocotest::KeyPoolStats;
+
+BOOST_AUTO_TEST_SUITE(KeyPoolTests)
+
+// Равные ключи - один и тот же указатель, независимо от источника строки
+BOOST_AUTO_TEST_CASE(TestInternSharesStorage) {
+    KeyPool pool;
+    const std::string first = "key_1";
+    const std::string second = std::string("key_") + "1";
+
+    const std::string_view a = pool.intern(first);
+    const std::string_view b = pool.intern(second);
+    BOOST_CHECK_EQUAL(a, "key_1");
+    BOOST_CHECK_EQUAL(a.data(), b.data());
+    BOOST_CHECK(a.data() != first.data());
+    BOOST_CHECK(pool.intern("key_2").data() != a.data());
+    BOOST_CHECK_EQUAL(pool.find("key_1").data(), a.data());
+    BOOST_CHECK(pool.find("key_3").data() == nullptr);
+    BOOST_CHECK(pool.intern("").data() == nullptr);
+    BOOST_CHECK_EQUAL(pool.size(), 2u);
+
+    // Выданные string_view не перемещаются при росте пула
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 5000; ++i) {
+        views.push_back(pool.intern("field_" + std::to_string(i) + std::string(i % 50, 'x')));
+    }
+    for (int i = 0; i < 5000; ++i) {
+        BOOST_REQUIRE_EQUAL(views[i], "field_" + std::to_string(i) + std::string(i % 50, 'x'));
+    }
+    BOOST_CHECK_EQUAL(a, "key_1");
+}
+
+BOOST_AUTO_TEST_CASE(TestLimitsAndStats) {
+    KeyPool pool(3, 8);
+    BOOST_CHECK(pool.intern("a").data() != nullptr);
+    BOOST_CHECK(pool.intern("toolongkey").data() == nullptr);
+    BOOST_CHECK(pool.intern("b").data() != nullptr);
+    BOOST_CHECK(pool.intern("c").data() != nullptr);
+    BOOST_CHECK(pool.intern("d").data() == nullptr);
+    BOOST_CHECK(pool.intern("a").data() != nullptr);
+    BOOST_CHECK(pool.intern("abc").data() == nullptr);
+
+    const KeyPoolStats stats = pool.stats();
+    BOOST_CHECK_EQUAL(stats.keys, 3u);
+    BOOST_CHECK_EQUAL(stats.bytes, 3u);
+    BOOST_CHECK_EQUAL(stats.misses, 3u);
+    BOOST_CHECK_EQUAL(stats.hits, 1u);
+    BOOST_CHECK_EQUAL(stats.rejected, 3u);
+    BOOST_CHECK_EQUAL(stats.savedBytes, 1u);
+}
+
+// Один пул на несколько потоков: каждый ключ попадает в пул один раз
+BOOST_AUTO_TEST_CASE(TestConcurrentIntern) {
+    KeyPool pool;
+    std::vector<std::vector<std::string_view>> seen(4);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                seen[t].push_back(pool.intern("key_" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(pool.size(), 1000u);
+    for (std::size_t t = 1; t < seen.size(); ++t) {
+        for (int i = 0; i < 1000; ++i) {
+            BOOST_REQUIRE_EQUAL(seen[t][i].data(), seen[0][i].data());
+        }
+    }
+    const KeyPoolStats stats = pool.stats();
+    BOOST_CHECK_EQUAL(stats.misses, 1000u);
+    BOOST_CHECK_EQUAL(stats.hits, 3000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,264 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Dynamic/Struct.h>
+
+#include "msgpack.h"
+#include "json_cases.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::MsgPackReader;
+using pocotest::MsgPackWriter;
+using pocotest::condensed;
+
+namespace {
+
+std::string packed(const Poco::Dynamic::Var& value, int options = 0) {
+    std::string out;
+    pocotest::packTo(value, out, options);
+    return out;
+}
+
+std::string bytes(std::initializer_list<unsigned> values) {
+    std::string out;
+    for (unsigned value : values) {
+        out += static_cast<char>(value);
+    }
+    return out;
+}
+
+std::uint64_t bitsOf(double value) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(MsgPackTests)
+
+// Дерево после MessagePack совпадает с исходным, как после текста
+BOOST_AUTO_TEST_CASE(TestRoundTripMatchesJson) {
+    std::vector<std::string> documents = {
+        "{}",
+        "[]",
+        "null",
+        "42",
+        "\"top level\"",
+        R"({"company": "Poco", "active": true, "count": 42, "ratio": 0.5, "none": null})",
+        R"([1, -2, 3.25, "four", false, null, [], {}, [[[]]]])",
+        R"({"menu": {"id": "file", "menuitem": [{"value": "New"}, {"value": "Open", "extra": [1, [2, [3]]]}]}})",
+        R"({"max_int64": 9223372036854775807, "min_int64": -9223372036854775808, "big": 18446744073709551615})",
+        R"({"exp": [1e10, 1E-5, -2.5e+3, 0.0, -0, 1.7976931348623157e308, 5e-324]})",
+    };
+    // Строки со спецсимволами и Unicode, массивы и объекты на границах форм
+    // fix/16/32 бит
+    Array::Ptr strings = new Array();
+    for (const auto& text : pocotest::escapeTestStrings()) {
+        strings->add(text);
+    }
+    strings->add(std::string(31, 'a'));
+    strings->add(std::string(32, 'b'));
+    strings->add(std::string(255, 'c'));
+    strings->add(std::string(256, 'd'));
+    strings->add(std::string(70000, 'e'));
+    documents.push_back(condensed(strings));
+    for (int size : {15, 16, 65535, 65536}) {
+        Array::Ptr array = new Array();
+        Object::Ptr object = new Object();
+        for (int i = 0; i < size; ++i) {
+            array->add(i);
+            object->set("k" + std::to_string(i), i);
+        }
+        documents.push_back(condensed(array));
+        documents.push_back(condensed(object));
+    }
+
+    MsgPackReader reader;
+    for (const auto& json : documents) {
+        BOOST_TEST_CONTEXT("JSON: " << json.substr(0, 80)) {
+            Parser parser;
+            const Poco::Dynamic::Var tree = parser.parse(json);
+            const std::string encoded = packed(tree);
+            const Poco::Dynamic::Var decoded = reader.parse(encoded);
+            BOOST_CHECK_EQUAL(condensed(decoded), condensed(tree));
+            BOOST_CHECK_EQUAL(MsgPackReader::skip(encoded.data(), encoded.size()), encoded.size());
+        }
+    }
+}
+
+// Целые - в самой короткой форме и с теми же типами, что у Parser;
+// double и float32 - без потерь, включая nan, inf и -0
+BOOST_AUTO_TEST_CASE(TestNumericLimits) {
+    const std::vector<std::pair<Poco::Dynamic::Var, std::string>> encodings = {
+        {Poco::Int64(0), bytes({0x00})},
+        {Poco::Int64(127), bytes({0x7f})},
+        {Poco::Int64(128), bytes({0xcc, 0x80})},
+        {Poco::Int64(-1), bytes({0xff})},
+        {Poco::Int64(-32), bytes({0xe0})},
+        {Poco::Int64(-33), bytes({0xd0, 0xdf})},
+        {Poco::Int64(65536), bytes({0xce, 0x00, 0x01, 0x00, 0x00})},
+        {std::numeric_limits<Poco::Int64>::min(), bytes({0xd3, 0x80, 0, 0, 0, 0, 0, 0, 0})},
+        {std::numeric_limits<Poco::UInt64>::max(), bytes({0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff})},
+        {true, bytes({0xc3})},
+        {Poco::Dynamic::Var(), bytes({0xc0})},
+        {1.0, bytes({0xcb, 0x3f, 0xf0, 0, 0, 0, 0, 0, 0})},
+        {0.25f, bytes({0xca, 0x3e, 0x80, 0, 0})},
+    };
+    for (const auto& entry : encodings) {
+        BOOST_CHECK(packed(entry.first) == entry.second);
+    }
+
+    MsgPackReader reader;
+    const std::vector<Poco::Int64> signedValues = {
+        0, 1, -1, 127, 128, -32, -33, 255, 256, -128, -129, 32767, 32768, -32768, -32769,
+        65535, 65536, 2147483647LL, 2147483648LL, -2147483648LL, -2147483649LL,
+        std::numeric_limits<Poco::Int64>::max(), std::numeric_limits<Poco::Int64>::min(),
+    };
+    for (Poco::Int64 value : signedValues) {
+        const Poco::Dynamic::Var decoded = reader.parse(packed(value));
+        BOOST_REQUIRE(decoded.type() == typeid(Poco::Int64));
+        BOOST_CHECK_EQUAL(decoded.extract<Poco::Int64>(), value);
+        // int и unsigned кодируются так же, как Int64
+        if (value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max()) {
+            BOOST_CHECK(packed(static_cast<int>(value)) == packed(value));
+        }
+    }
+    const Poco::Dynamic::Var big = reader.parse(packed(std::numeric_limits<Poco::UInt64>::max()));
+    BOOST_REQUIRE(big.type() == typeid(Poco::UInt64));
+    BOOST_CHECK_EQUAL(big.extract<Poco::UInt64>(), std::numeric_limits<Poco::UInt64>::max());
+    BOOST_CHECK(reader.parse(packed(Poco::UInt64(5))).type() == typeid(Poco::Int64));
+
+    using limits = std::numeric_limits<double>;
+    for (double value : {0.0, -0.0, 0.1, limits::max(), limits::lowest(), limits::min(), limits::denorm_min(),
+                         limits::epsilon(), limits::infinity(), -limits::infinity()}) {
+        const Poco::Dynamic::Var decoded = reader.parse(packed(value));
+        BOOST_REQUIRE(decoded.type() == typeid(double));
+        BOOST_CHECK_EQUAL(bitsOf(decoded.extract<double>()), bitsOf(value));
+    }
+    BOOST_CHECK(std::isnan(reader.parse(packed(limits::quiet_NaN())).extract<double>()));
+    BOOST_CHECK_EQUAL(reader.parse(packed(0.25f)).extract<double>(), 0.25);
+}
+
+// С JSON_PRESERVE_KEY_ORDER ключи пишутся в порядке вставки и так же
+// восстанавливаются ParseHandler с сохранением порядка
+BOOST_AUTO_TEST_CASE(TestPreserveKeyOrder) {
+    Object::Ptr ordered = new Object(Poco::JSON_PRESERVE_KEY_ORDER);
+    for (const char* key : {"zeta", "alpha", "mid", "beta"}) {
+        ordered->set(key, std::string(key));
+    }
+    MsgPackReader reader(new ParseHandler(true));
+    const Object::Ptr decoded = reader.parse(packed(ordered, Poco::JSON_PRESERVE_KEY_ORDER)).extract<Object::Ptr>();
+    BOOST_CHECK(decoded->getNames() == ordered->getNames());
+
+    // Без опции - в порядке ключей std::map, как у Stringifier
+    const Object::Ptr sorted = reader.parse(packed(ordered)).extract<Object::Ptr>();
+    const std::vector<std::string> expected = {"alpha", "beta", "mid", "zeta"};
+    BOOST_CHECK(sorted->getNames() == expected);
+}
+
+// Dynamic::Struct и std::vector<Var> пишутся как map и array, а не строкой
+BOOST_AUTO_TEST_CASE(TestDynamicStructAndVector) {
+    Poco::DynamicStruct inner;
+    inner["v"] = 1;
+    Poco::DynamicStruct record;
+    record["name"] = std::string("x");
+    record["inner"] = inner;
+    record["list"] = std::vector<Poco::Dynamic::Var>{Poco::Int64(1), std::string("two"), Poco::Dynamic::Var()};
+
+    Object::Ptr innerObject = new Object();
+    innerObject->set("v", 1);
+    Object::Ptr expected = new Object();
+    expected->set("name", "x");
+    expected->set("inner", innerObject);
+    Array::Ptr list = new Array();
+    list->add(1);
+    list->add("two");
+    list->add(Poco::Dynamic::Var());
+    expected->set("list", list);
+    BOOST_CHECK(packed(record) == packed(expected));
+
+    MsgPackReader reader;
+    BOOST_CHECK_EQUAL(condensed(reader.parse(packed(record))), R"({"inner":{"v":1},"list":[1,"two",null],"name":"x"})");
+    BOOST_CHECK(packed(std::vector<Poco::Dynamic::Var>{}) == bytes({0x90}));
+}
+
+// Испорченный вход отвергается до выделения памяти под заявленную длину
+BOOST_AUTO_TEST_CASE(TestRejectsMalformed) {
+    Object::Ptr object = new Object();
+    object->set("name", "value");
+    Array::Ptr array = new Array();
+    array->add(1);
+    array->add(std::string(300, 'x'));
+    array->add(-1.5);
+    object->set("list", array);
+    const std::string valid = packed(object);
+
+    MsgPackReader reader;
+    for (std::size_t size = 0; size < valid.size(); ++size) {
+        BOOST_CHECK_THROW(reader.parse(valid.data(), size), JSONException);
+        BOOST_CHECK_THROW(MsgPackReader::skip(valid.data(), size), JSONException);
+    }
+    BOOST_CHECK_THROW(reader.parse(valid + '\x00'), JSONException);
+    BOOST_CHECK_THROW(reader.parse(bytes({0xc1})), JSONException);
+    BOOST_CHECK_THROW(reader.parse(bytes({0xd4, 0x01, 0x00})), JSONException);
+    BOOST_CHECK_THROW(reader.parse(bytes({0x81, 0x01, 0x02})), JSONException);
+    BOOST_CHECK_THROW(reader.parse(bytes({0xdd, 0xff, 0xff, 0xff, 0xff, 0x00})), JSONException);
+    BOOST_CHECK_THROW(reader.parse(bytes({0xdb, 0x7f, 0xff, 0xff, 0xff, 0x61})), JSONException);
+
+    // Ограничение глубины, как у JsonReader::setDepth
+    std::string nested(100, static_cast<char>(0x91));
+    nested += static_cast<char>(0xc0);
+    BOOST_CHECK_NO_THROW(reader.parse(nested));
+    reader.setDepth(50);
+    BOOST_CHECK_THROW(reader.parse(nested), JSONException);
+    reader.setDepth(100);
+    BOOST_CHECK_NO_THROW(reader.parse(nested));
+}
+
+// skip() возвращает размер каждого значения в потоке подряд записанных
+BOOST_AUTO_TEST_CASE(TestSkipConcatenated) {
+    Object::Ptr record = new Object();
+    record->set("id", 7);
+    record->set("payload", std::string(1000, 'p'));
+    const std::vector<Poco::Dynamic::Var> values = {
+        Poco::Dynamic::Var(record), Poco::Dynamic::Var(std::string("text")), Poco::Dynamic::Var(3.5),
+        Poco::Dynamic::Var(), Poco::Dynamic::Var(std::numeric_limits<Poco::Int64>::min()),
+    };
+    std::string stream;
+    std::vector<std::size_t> sizes;
+    MsgPackWriter writer;
+    for (const auto& value : values) {
+        const std::size_t before = stream.size();
+        writer.write(value, stream);
+        sizes.push_back(stream.size() - before);
+    }
+
+    MsgPackReader reader;
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const std::size_t size = MsgPackReader::skip(stream.data() + offset, stream.size() - offset);
+        BOOST_CHECK_EQUAL(size, sizes[i]);
+        BOOST_CHECK_EQUAL(condensed(reader.parse(stream.data() + offset, size)), condensed(values[i]));
+        offset += size;
+    }
+    BOOST_CHECK_EQUAL(offset, stream.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
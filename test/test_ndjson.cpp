@@ -0,0 +1,199 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/JSON/JSONException.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Exception.h>
+#include <Poco/TemporaryFile.h>
+
+#include "ndjson_reader.h"
+#include "json_cases.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::NdjsonReader;
+using pocotest::NdjsonStats;
+using pocotest::condensed;
+
+namespace {
+
+// records строк вида {"id": N, ...}; каждая пятая - массив, каждая седьмая
+// пустая
+std::string generateLines(std::size_t records) {
+    std::string data;
+    for (std::size_t i = 0; i < records; ++i) {
+        if (i % 7 == 3) {
+            data += "\n";
+        }
+        if (i % 5 == 0) {
+            data += "[" + std::to_string(i) + ", \"line\", null]\n";
+        } else {
+            data += R"({"id": )" + std::to_string(i) + R"(, "name": "record é )" + std::to_string(i)
+                + R"(", "tags": ["a", "b"], "ok": true})" + "\n";
+        }
+    }
+    return data;
+}
+
+// Эталон: getline + новый Parser на каждую непустую строку
+std::vector<std::string> parseSequentially(const std::string& data) {
+    std::vector<std::string> result;
+    std::istringstream in(data);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.find_first_not_of(" \t") == std::string::npos) {
+            continue;
+        }
+        Parser parser;
+        result.push_back(condensed(parser.parse(line)));
+    }
+    return result;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(NdjsonTests)
+
+// Отрезки покрывают вход целиком и не разрывают строки
+BOOST_AUTO_TEST_CASE(TestSplitLines) {
+    const std::string data = generateLines(100);
+    for (std::size_t parts = 1; parts <= 16; ++parts) {
+        const std::vector<std::string_view> chunks = pocotest::splitLines(data, parts);
+        BOOST_CHECK_LE(chunks.size(), parts);
+
+        std::string joined;
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            BOOST_CHECK(!chunks[i].empty());
+            if (i + 1 < chunks.size()) {
+                BOOST_CHECK_EQUAL(chunks[i].back(), '\n');
+            }
+            joined.append(chunks[i].data(), chunks[i].size());
+        }
+        BOOST_CHECK(joined == data);
+    }
+
+    BOOST_CHECK(pocotest::splitLines("", 4).empty());
+    BOOST_CHECK_EQUAL(pocotest::splitLines("{}", 4).size(), 1u);
+    BOOST_CHECK_EQUAL(pocotest::splitLines("{}\n[]", 8).size(), 2u);
+}
+
+// Результаты в порядке строк при любом числе потоков
+BOOST_AUTO_TEST_CASE(TestOrderedResults) {
+    const std::string data = generateLines(500);
+    const std::vector<std::string> expected = parseSequentially(data);
+
+    for (unsigned threads : {1u, 2u, 3u, 4u, 8u, 64u}) {
+        NdjsonReader reader(threads);
+        const std::vector<Poco::Dynamic::Var> records = reader.parse(data);
+        BOOST_REQUIRE_EQUAL(records.size(), expected.size());
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            BOOST_CHECK_EQUAL(condensed(records[i]), expected[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestStatistics) {
+    const std::size_t records = 500;
+    const std::string data = generateLines(records);
+
+    NdjsonReader single(1);
+    const NdjsonStats expected = single.stats(data);
+    BOOST_CHECK_EQUAL(expected.records, records);
+    BOOST_CHECK_EQUAL(expected.blankLines, (records + 3) / 7);
+    BOOST_CHECK_EQUAL(expected.bytes, data.size());
+    BOOST_CHECK_EQUAL(expected.objects, records - records / 5);
+    BOOST_CHECK_EQUAL(expected.members, expected.objects * 4);
+
+    for (unsigned threads : {2u, 4u, 7u}) {
+        NdjsonReader reader(threads);
+        const NdjsonStats stats = reader.stats(data);
+        BOOST_CHECK_EQUAL(stats.records, expected.records);
+        BOOST_CHECK_EQUAL(stats.blankLines, expected.blankLines);
+        BOOST_CHECK_EQUAL(stats.bytes, expected.bytes);
+        BOOST_CHECK_EQUAL(stats.maxRecordBytes, expected.maxRecordBytes);
+        BOOST_CHECK_EQUAL(stats.objects, expected.objects);
+        BOOST_CHECK_EQUAL(stats.members, expected.members);
+    }
+}
+
+// CRLF, пробельные строки и отсутствие '\n' в конце
+BOOST_AUTO_TEST_CASE(TestLineEndings) {
+    const std::string data = "{\"a\": 1}\r\n  \t\r\n\r\n[1, 2]\r\n\"last\"";
+    NdjsonReader reader(2);
+    const std::vector<Poco::Dynamic::Var> records = reader.parse(data);
+    BOOST_REQUIRE_EQUAL(records.size(), 3u);
+    BOOST_CHECK_EQUAL(condensed(records[0]), R"({"a":1})");
+    BOOST_CHECK_EQUAL(condensed(records[1]), "[1,2]");
+    BOOST_CHECK_EQUAL(condensed(records[2]), R"("last")");
+
+    const NdjsonStats stats = reader.stats(data);
+    BOOST_CHECK_EQUAL(stats.records, 3u);
+    BOOST_CHECK_EQUAL(stats.blankLines, 2u);
+    BOOST_CHECK_EQUAL(stats.maxRecordBytes, 8u);
+
+    BOOST_CHECK(reader.parse("").empty());
+    BOOST_CHECK(reader.parse("\n\n").empty());
+}
+
+// Номер первой некорректной строки не зависит от числа потоков
+BOOST_AUTO_TEST_CASE(TestErrorReportsLine) {
+    std::string data = generateLines(300);
+    std::size_t line = 1;
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < 200; ++i) {
+        pos = data.find('\n', pos) + 1;
+        ++line;
+    }
+    data.insert(pos, "{\"broken\": }\n");
+    // Ошибка и в более поздней строке: сообщается первая
+    data += "[1,]\n";
+
+    for (unsigned threads : {1u, 2u, 3u, 8u}) {
+        NdjsonReader reader(threads);
+        try {
+            reader.parse(data);
+            BOOST_FAIL("Expected JSONException");
+        } catch (const JSONException& e) {
+            BOOST_CHECK_MESSAGE(e.message().find("Line " + std::to_string(line)) == 0, e.message());
+        }
+        BOOST_CHECK_THROW(reader.stats(data), JSONException);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestParseFile) {
+    const std::string data = generateLines(200);
+    Poco::TemporaryFile file;
+    {
+        std::ofstream out(file.path(), std::ios::binary);
+        out << data;
+    }
+
+    NdjsonReader reader(4);
+    const std::vector<Poco::Dynamic::Var> records = reader.parseFile(file.path());
+    const std::vector<std::string> expected = parseSequentially(data);
+    BOOST_REQUIRE_EQUAL(records.size(), expected.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        BOOST_CHECK_EQUAL(condensed(records[i]), expected[i]);
+    }
+    BOOST_CHECK_EQUAL(reader.statsFile(file.path()).records, 200u);
+
+    Poco::TemporaryFile empty;
+    empty.createFile();
+    BOOST_CHECK(reader.parseFile(empty.path()).empty());
+    BOOST_CHECK_EQUAL(reader.statsFile(empty.path()).records, 0u);
+
+    BOOST_CHECK_THROW(reader.parseFile(file.path() + ".missing"), Poco::FileNotFoundException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Query.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/Exception.h>
+
+#include "query_plan.h"
+#include "json_cases.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::QueryPlan;
+using pocotest::QueryPlanCache;
+
+namespace {
+
+// Пустой Var (значение не найдено) отличается от null
+std::string shown(const Poco::Dynamic::Var& value) {
+    return value.isEmpty() ? "<empty>" : pocotest::condensed(value);
+}
+
+Poco::Dynamic::Var parse(const std::string& json) {
+    Parser parser;
+    return parser.parse(json);
+}
+
+const char* const routingDocument = R"({
+    "service": "billing",
+    "version": 3,
+    "route": {"region": "eu", "zone": "eu-1", "weights": [10, 20, 70]},
+    "items": [
+        {"id": 1, "name": "first", "tags": ["a", "b"]},
+        {"id": 2, "name": "second", "tags": []},
+        {"id": 3, "name": "third", "tags": ["c"], "nested": {"deep": [[1, 2], [3, 4]]}}
+    ],
+    "matrix": [[1, 2, 3], [4, 5, 6]],
+    "flags": {"beta": true, "limit": null},
+    "weird.key": 1,
+    "*": "star"
+})";
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(QueryPlanTests)
+
+// Без подстановок план даёт то же, что Query::find, включая особенности Poco
+BOOST_AUTO_TEST_CASE(TestPlanMatchesQuery) {
+    const std::vector<Poco::Dynamic::Var> roots = {
+        parse(routingDocument),
+        parse(R"([{"id": 1}, [10, 20], "text", null])"),
+    };
+    const std::vector<std::string> paths = {
+        "", "service", "version", "route", "route.region", "route.weights", "route.weights[2]",
+        "route.weights[3]", "items[0].name", "items[2].nested.deep[1][0]", "items[2].tags[0]",
+        "items[1].tags[0]", "items[5].name", "matrix[1][2]", "matrix[1]", "matrix[0][9]",
+        "flags.beta", "flags.limit", "flags.limit.x", "missing", "missing.deeper[0]",
+        "service.length", "route[0]", "route[0].zone", "items.name", "[0]", "[1][1]", "[2]", "[0].id",
+        "route..zone", ".service", "service.", "items[x]", "items[0]x[1]", "items[[0].id",
+        "items[0]tags", "weird.key", "weird",
+    };
+    for (const auto& root : roots) {
+        Query query(root);
+        for (const auto& path : paths) {
+            const QueryPlan plan(path);
+            BOOST_CHECK(!plan.hasWildcards());
+            BOOST_CHECK_MESSAGE(shown(plan.find(root)) == shown(query.find(path)), "path: " << path);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestTypedLookups) {
+    const Poco::Dynamic::Var root = parse(routingDocument);
+    Query query(root);
+
+    BOOST_CHECK_EQUAL(QueryPlan("service").findValue(root, ""), "billing");
+    BOOST_CHECK_EQUAL(QueryPlan("missing").findValue(root, "default"), "default");
+    BOOST_CHECK_EQUAL(QueryPlan("version").findValue<int>(root, -1), 3);
+    BOOST_CHECK_EQUAL(QueryPlan("route.weights[1]").findValue<int>(root, -1), 20);
+    BOOST_CHECK_EQUAL(QueryPlan("route").findValue<int>(root, -1), -1);
+    BOOST_CHECK_EQUAL(QueryPlan("flags.beta").findValue<bool>(root, false), true);
+
+    Object::Ptr route = QueryPlan("route").findObject(root);
+    BOOST_REQUIRE(!route.isNull());
+    BOOST_CHECK_EQUAL(route->getValue<std::string>("zone"), "eu-1");
+    BOOST_CHECK(QueryPlan("service").findObject(root).isNull());
+
+    Array::Ptr weights = QueryPlan("route.weights").findArray(root);
+    BOOST_REQUIRE(!weights.isNull());
+    BOOST_CHECK_EQUAL(weights->size(), 3u);
+    BOOST_CHECK(QueryPlan("route").findArray(root).isNull());
+
+    // Корень - Object по значению, как принимает и Query
+    const Object byValue = *root.extract<Object::Ptr>();
+    BOOST_CHECK_EQUAL(QueryPlan("items[2].name").findValue(byValue, ""), "third");
+    BOOST_CHECK_EQUAL(QueryPlan("items[2].name").findValue(byValue, ""), query.findValue("items[2].name", ""));
+}
+
+BOOST_AUTO_TEST_CASE(TestWildcards) {
+    const Poco::Dynamic::Var root = parse(routingDocument);
+    std::vector<Poco::Dynamic::Var> matches;
+
+    const QueryPlan names("items[*].name");
+    BOOST_CHECK(names.hasWildcards());
+    BOOST_CHECK_EQUAL(names.findAll(root, matches), 3u);
+    BOOST_REQUIRE_EQUAL(matches.size(), 3u);
+    BOOST_CHECK_EQUAL(matches[0].convert<std::string>(), "first");
+    BOOST_CHECK_EQUAL(matches[2].convert<std::string>(), "third");
+    BOOST_CHECK_EQUAL(names.find(root).convert<std::string>(), "first");
+
+    // Пустые совпадения (нет ключа, null) не попадают в результат
+    matches.clear();
+    BOOST_CHECK_EQUAL(QueryPlan("items[*].tags[0]").findAll(root, matches), 2u);
+    matches.clear();
+    BOOST_CHECK_EQUAL(QueryPlan("items[*].nested.deep[*][1]").findAll(root, matches), 2u);
+    BOOST_CHECK_EQUAL(shown(matches[0]), "2");
+    BOOST_CHECK_EQUAL(shown(matches[1]), "4");
+
+    matches.clear();
+    BOOST_CHECK_EQUAL(QueryPlan("matrix[*][*]").findAll(root, matches), 6u);
+    BOOST_CHECK_EQUAL(shown(matches[5]), "6");
+
+    // "*" - все значения объекта в порядке обхода Object
+    matches.clear();
+    BOOST_CHECK_EQUAL(QueryPlan("route.*").findAll(root, matches), 3u);
+    matches.clear();
+    BOOST_CHECK_EQUAL(QueryPlan("flags.*").findAll(root, matches), 1u);
+    matches.clear();
+    BOOST_CHECK_EQUAL(QueryPlan("*.region").findAll(root, matches), 1u);
+    BOOST_CHECK_EQUAL(shown(matches[0]), R"("eu")");
+
+    BOOST_CHECK(QueryPlan("items[*].missing").find(root).isEmpty());
+    matches.clear();
+    BOOST_CHECK_EQUAL(QueryPlan("service[*]").findAll(root, matches), 1u);
+
+    // Без подстановок findAll даёт не больше одного значения
+    matches.clear();
+    BOOST_CHECK_EQUAL(QueryPlan("route.zone").findAll(root, matches), 1u);
+    BOOST_CHECK_EQUAL(QueryPlan("route.none").findAll(root, matches), 0u);
+}
+
+// Один план на множество документов
+BOOST_AUTO_TEST_CASE(TestPlanReusedAcrossDocuments) {
+    const QueryPlan region("route.region");
+    const QueryPlan firstTag("items[0].tags[0]");
+    for (int i = 0; i < 100; ++i) {
+        const std::string json = R"({"route": {"region": "r)" + std::to_string(i)
+            + R"("}, "items": [{"tags": [)" + std::to_string(i * 2) + "]}]}";
+        const Poco::Dynamic::Var root = parse(json);
+        BOOST_CHECK_EQUAL(region.findValue(root, ""), "r" + std::to_string(i));
+        BOOST_CHECK_EQUAL(firstTag.findValue<int>(root, -1), i * 2);
+        BOOST_CHECK_EQUAL(region.findValue(root, ""), Query(root).findValue("route.region", ""));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestPlanCache) {
+    QueryPlanCache cache;
+    const QueryPlanCache::PlanPtr first = cache.get("route.region");
+    BOOST_CHECK(cache.get("route.region") == first);
+    BOOST_CHECK(cache.get("route.zone") != first);
+    BOOST_CHECK_EQUAL(cache.size(), 2u);
+    BOOST_CHECK_EQUAL(first->path(), "route.region");
+
+    // Планы из кеша - общие для всех потоков
+    const Poco::Dynamic::Var root = parse(routingDocument);
+    std::vector<std::thread> threads;
+    std::vector<std::string> results(4);
+    for (std::size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 100; ++i) {
+                results[t] = cache.get("items[" + std::to_string(i % 3) + "].name")->findValue(root, "");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& result : results) {
+        BOOST_CHECK_EQUAL(result, "first");
+    }
+    BOOST_CHECK_EQUAL(cache.size(), 5u);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
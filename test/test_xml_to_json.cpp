@@ -0,0 +1,189 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <Poco/DOM/DOMParser.h>
+#include <Poco/DOM/Document.h>
+#include <Poco/SAX/XMLReader.h>
+#include <Poco/JSON/Parser.h>
+#include <Poco/JSON/ParseHandler.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/AutoPtr.h>
+#include <Poco/Exception.h>
+
+#include "bench_corpus.h"
+#include "xml_to_json.h"
+#include "json_cases.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Poco::JSON;
+using pocotest::XmlToJson;
+using pocotest::condensed;
+
+namespace {
+
+// XML и ожидаемый JsonML
+const std::vector<std::pair<std::string, std::string>>& knownDocuments() {
+    static const std::vector<std::pair<std::string, std::string>> cases = {
+        {"<a/>", R"(["a"])"},
+        {"<a z=\"1\" b=\"2\"/>", R"(["a",{"z":"1","b":"2"}])"},
+        {"<a>text</a>", R"(["a","text"])"},
+        {"<a>one<b>two</b>three<c/></a>", R"(["a","one",["b","two"],"three",["c"]])"},
+        {"<a>\n  <b>x</b>\n  <c> y </c>\n</a>", R"(["a",["b","x"],["c"," y "]])"},
+        {"<a>  <b/>  text  </a>", R"(["a",["b"],"  text  "])"},
+        {"<a t=\"&lt;&amp;&quot;\">&lt;tag&gt; &amp; &#65;&#x42; &#233;</a>",
+         "[\"a\",{\"t\":\"<&\\\"\"},\"<tag> & AB \xC3\xA9\"]"},
+        {"<a>x<![CDATA[<y>&]]><!-- comment -->z<?pi data?>w</a>", R"(["a","x<y>&zw"])"},
+        {"<a>\"q\" back\\slash&#9;tab&#10;nl</a>", R"(["a","\"q\" back\\slash\ttab\nnl"])"},
+        {"<g:item xmlns:g=\"urn:g\" g:attr=\"v\"><g:x/></g:item>",
+         R"(["g:item",{"xmlns:g":"urn:g","g:attr":"v"},["g:x"]])"},
+        {"<?xml version=\"1.0\"?>\n<!-- before -->\n<a k=\"значение\">😀 é</a>\n",
+         R"(["a",{"k":"значение"},"😀 é"])"},
+        {"<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><a>caf\xE9</a>", "[\"a\",\"caf\xC3\xA9\"]"},
+    };
+    return cases;
+}
+
+const std::vector<std::string>& malformedDocuments() {
+    static const std::vector<std::string> cases = {
+        "", "text", "<a>", "<a></b>", "<a x='1' x='2'/>", "<a/><b/>", "<a>&undefined;</a>", "<a x=1/>",
+    };
+    return cases;
+}
+
+// Эталонный путь: DOM -> дерево Poco::JSON -> Stringifier
+std::string convertWithDom(const std::string& xml, bool preserveWhitespace = false) {
+    Poco::XML::DOMParser parser;
+    parser.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACES, false);
+    const Poco::AutoPtr<Poco::XML::Document> document = parser.parseString(xml);
+    return condensed(pocotest::domToJsonML(*document->documentElement(), preserveWhitespace));
+}
+
+std::string toXml(const std::string& json) {
+    Parser parser(new ParseHandler(true));
+    std::string xml;
+    pocotest::jsonmlToXml(parser.parse(json), xml);
+    return xml;
+}
+
+std::string makeFeed(std::size_t items) {
+    std::mt19937 rng(20250101u);
+    return bench::makeXmlFeed(rng, items);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(XmlToJsonTests)
+
+// Потоковый обработчик и эталонный путь через DOM дают ожидаемый JsonML
+BOOST_AUTO_TEST_CASE(TestKnownDocuments) {
+    XmlToJson converter;
+    std::string json;
+    for (const auto& [xml, expected] : knownDocuments()) {
+        BOOST_TEST_CONTEXT("XML: " << xml) {
+            converter.convert(xml, json);
+            BOOST_CHECK_EQUAL(json, expected);
+            BOOST_CHECK_EQUAL(convertWithDom(xml), expected);
+        }
+    }
+}
+
+// С preserveWhitespace пробельные узлы сохраняются, в том числе
+// разделённые комментарием
+BOOST_AUTO_TEST_CASE(TestPreserveWhitespace) {
+    const std::string xml = "<a>\n  <b>x</b>\n  <!-- c -->\t<c> y </c>\n</a>";
+    const std::string expected = R"(["a","\n  ",["b","x"],"\n  \t",["c"," y "],"\n"])";
+    XmlToJson converter(true);
+    std::string json;
+    converter.convert(xml, json);
+    BOOST_CHECK_EQUAL(json, expected);
+    BOOST_CHECK_EQUAL(convertWithDom(xml, true), expected);
+}
+
+// Сгенерированный фид: поток и DOM совпадают побайтно
+BOOST_AUTO_TEST_CASE(TestFeedMatchesDomPath) {
+    const std::string xml = makeFeed(200);
+    XmlToJson converter;
+    std::string json;
+    converter.convert(xml, json);
+    BOOST_CHECK_EQUAL(json, convertWithDom(xml));
+    BOOST_CHECK_GT(converter.elements(), 200u * 6u);
+
+    // Результат - корректный JSON
+    Parser parser;
+    BOOST_CHECK_EQUAL(parser.parse(json).extract<Array::Ptr>()->size(), 1u + 1u + 200u);
+}
+
+// XML -> JSON -> XML -> JSON не меняет JSON; канонический документ
+// восстанавливается побайтно
+BOOST_AUTO_TEST_CASE(TestRoundTrip) {
+    XmlToJson converter;
+    std::string json;
+    std::string again;
+    std::vector<std::string> documents;
+    for (const auto& known : knownDocuments()) {
+        documents.push_back(known.first);
+    }
+    documents.push_back(makeFeed(50));
+
+    for (const auto& xml : documents) {
+        BOOST_TEST_CONTEXT("XML: " << xml.substr(0, 80)) {
+            converter.convert(xml, json);
+            const std::string restored = toXml(json);
+            converter.convert(restored, again);
+            BOOST_CHECK_EQUAL(again, json);
+        }
+    }
+
+    const std::string canonical =
+        "<a x=\"1\" y=\"&lt;&quot;&#10;&#9;\">t &amp; u &lt;&gt;<b/><c>v&#13;</c><g:d xmlns:g=\"urn:g\"/></a>";
+    converter.convert(canonical, json);
+    BOOST_CHECK_EQUAL(toXml(json), canonical);
+
+    BOOST_CHECK_THROW(toXml(R"({"a": 1})"), Poco::DataFormatException);
+    BOOST_CHECK_THROW(toXml("[]"), Poco::DataFormatException);
+    BOOST_CHECK_THROW(toXml("[1]"), Poco::DataFormatException);
+    BOOST_CHECK_THROW(toXml(R"(["a", {"b": 1}, [2]])"), Poco::DataFormatException);
+}
+
+// Из потока в поток: тот же результат, что из памяти, а буфер не растёт
+// вместе с документом
+BOOST_AUTO_TEST_CASE(TestStreamMatchesMemory) {
+    const std::string xml = makeFeed(2000);
+    XmlToJson converter;
+    std::string expected;
+    converter.convert(xml, expected);
+    const std::size_t elements = converter.elements();
+
+    converter.setFlushSize(4096);
+    std::istringstream in(xml);
+    std::ostringstream out;
+    converter.convert(in, out);
+    BOOST_CHECK(out.str() == expected);
+    BOOST_CHECK_EQUAL(converter.elements(), elements);
+    BOOST_CHECK_GT(expected.size(), 1024u * 1024u);
+    BOOST_CHECK_LT(converter.bufferCapacity(), 128u * 1024u);
+}
+
+// Ошибки XML - исключения Poco; преобразователь остаётся пригодным
+BOOST_AUTO_TEST_CASE(TestMalformedXml) {
+    XmlToJson converter;
+    std::string json;
+    for (const auto& xml : malformedDocuments()) {
+        BOOST_TEST_CONTEXT("XML: " << xml) {
+            BOOST_CHECK_THROW(converter.convert(xml, json), Poco::Exception);
+            std::istringstream in(xml);
+            std::ostringstream out;
+            BOOST_CHECK_THROW(converter.convert(in, out), Poco::Exception);
+
+            converter.convert(std::string_view("<ok a=\"1\">after</ok>"), json);
+            BOOST_CHECK_EQUAL(json, R"(["ok",{"a":"1"},"after"])");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,425 @@
+#ifndef POCO_TEST_APP_XML_TO_JSON_H
+#define POCO_TEST_APP_XML_TO_JSON_H
+
+// Потоковое преобразование XML в JSON без DOM и без промежуточного дерева
+// Poco::JSON.
+//
+// Раскладка - JsonML: элемент - массив ["имя", {атрибуты}, дети...], где
+// объект атрибутов есть, только если атрибуты есть, а дети - строки (текст)
+// и такие же массивы. Она не зависит от того, повторяется ли элемент, так
+// что каждый элемент пишется сразу по событию SAX, и сохраняет порядок
+// атрибутов и смешанное содержимое: обратное преобразование (jsonmlToXml)
+// восстанавливает документ с точностью до пробельных узлов, комментариев,
+// инструкций обработки и лексических деталей (CDATA, ссылки на сущности).
+//
+// XmlJsonHandler - ContentHandler для Poco::XML::SAXParser, который пишет
+// JSON прямо в буфер через экранирование JsonWriter (json_writer.h):
+// память - этот буфер, счётчик глубины и пробелы в начале текстового узла,
+// пока неизвестно, состоит ли он из одних пробелов. Текст экранируется
+// частями, как его отдаёт expat, поэтому даже очень длинный текстовый узел
+// не копируется целиком. XmlToJson разбирает документ из памяти в строку
+// или из потока в поток: во втором случае буфер сбрасывается в выходной
+// поток каждые getFlushSize() байт, и память не зависит от размера входа.
+//
+// Пространства имён не обрабатываются: имена пишутся как в документе (с
+// префиксом), объявления xmlns остаются обычными атрибутами. Текстовые узлы
+// из одних пробелов (отступы) по умолчанию пропускаются; соседние участки
+// текста, CDATA и текст по обе стороны комментария или инструкции
+// обработки сливаются в одну строку. Ошибки XML - исключения SAXParser
+// (Poco::XML::SAXParseException).
+//
+// domToJsonML - та же раскладка через DOM и дерево Poco::JSON: эталон для
+// тестов и точка сравнения в бенчмарке.
+
+#include "json_writer.h"
+
+#include <Poco/SAX/ContentHandler.h>
+#include <Poco/SAX/Attributes.h>
+#include <Poco/SAX/InputSource.h>
+#include <Poco/SAX/SAXParser.h>
+#include <Poco/SAX/XMLReader.h>
+#include <Poco/DOM/Attr.h>
+#include <Poco/DOM/CharacterData.h>
+#include <Poco/DOM/Element.h>
+#include <Poco/DOM/NamedNodeMap.h>
+#include <Poco/DOM/Node.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/AutoPtr.h>
+#include <Poco/FileStream.h>
+#include <Poco/Exception.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+namespace pocotest {
+
+namespace detail {
+
+inline bool isXmlSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool isXmlSpace(std::string_view text) {
+    return std::all_of(text.begin(), text.end(), [](char c) { return isXmlSpace(c); });
+}
+
+} // namespace detail
+
+// Обработчик событий SAX, пишущий JsonML в строку
+class XmlJsonHandler : public Poco::XML::ContentHandler {
+public:
+    explicit XmlJsonHandler(bool preserveWhitespace = false)
+        : preserveWhitespace_(preserveWhitespace) {
+    }
+
+    // Буфер, в конец которого дописывается JSON; сбрасывать его по мере
+    // заполнения - дело вызывающего (XmlToJson)
+    void setOutput(std::string* out) {
+        out_ = out;
+    }
+
+    bool getPreserveWhitespace() const {
+        return preserveWhitespace_;
+    }
+
+    // Число элементов и наибольшая глубина последнего документа
+    std::size_t elements() const {
+        return elements_;
+    }
+
+    std::size_t maxDepth() const {
+        return maxDepth_;
+    }
+
+    std::size_t pendingCapacity() const {
+        return pendingSpace_.capacity();
+    }
+
+    void setDocumentLocator(const Poco::XML::Locator*) override {}
+
+    void startDocument() override {
+        depth_ = 0;
+        maxDepth_ = 0;
+        elements_ = 0;
+        textOpen_ = false;
+        pendingSpace_.clear();
+    }
+
+    void endDocument() override {}
+
+    void startElement(const Poco::XML::XMLString&, const Poco::XML::XMLString& localName,
+                      const Poco::XML::XMLString& qname, const Poco::XML::Attributes& attributes) override {
+        closeText();
+        std::string& out = *out_;
+        if (depth_ != 0) {
+            out += ',';
+        }
+        out += '[';
+        writer_.writeString(qname.empty() ? localName : qname, out);
+        const int count = attributes.getLength();
+        if (count > 0) {
+            out += ",{";
+            for (int i = 0; i < count; ++i) {
+                if (i != 0) {
+                    out += ',';
+                }
+                const Poco::XML::XMLString& name = attributes.getQName(i);
+                writer_.writeString(name.empty() ? attributes.getLocalName(i) : name, out);
+                out += ':';
+                writer_.writeString(attributes.getValue(i), out);
+            }
+            out += '}';
+        }
+        ++elements_;
+        maxDepth_ = std::max(maxDepth_, ++depth_);
+    }
+
+    void endElement(const Poco::XML::XMLString&, const Poco::XML::XMLString&,
+                    const Poco::XML::XMLString&) override {
+        closeText();
+        *out_ += ']';
+        --depth_;
+    }
+
+    void characters(const Poco::XML::XMLChar ch[], int start, int length) override {
+        if (depth_ == 0) {
+            return;
+        }
+        const std::string_view text(ch + start, static_cast<std::size_t>(length));
+        if (!textOpen_) {
+            // Пробелы в начале узла ждут первого непробельного символа: узел
+            // из одних пробелов не пишется вовсе
+            if (!preserveWhitespace_ && detail::isXmlSpace(text)) {
+                pendingSpace_.append(text);
+                return;
+            }
+            *out_ += ",\"";
+            textOpen_ = true;
+            writer_.writeString(pendingSpace_, *out_, false);
+            pendingSpace_.clear();
+        }
+        writer_.writeString(text, *out_, false);
+    }
+
+    void ignorableWhitespace(const Poco::XML::XMLChar ch[], int start, int length) override {
+        characters(ch, start, length);
+    }
+
+    void processingInstruction(const Poco::XML::XMLString&, const Poco::XML::XMLString&) override {}
+    void startPrefixMapping(const Poco::XML::XMLString&, const Poco::XML::XMLString&) override {}
+    void endPrefixMapping(const Poco::XML::XMLString&) override {}
+    void skippedEntity(const Poco::XML::XMLString&) override {}
+
+private:
+    void closeText() {
+        if (textOpen_) {
+            *out_ += '"';
+            textOpen_ = false;
+        }
+        pendingSpace_.clear();
+    }
+
+    JsonWriter writer_;
+    bool preserveWhitespace_;
+    std::string* out_ = nullptr;
+    std::size_t depth_ = 0;
+    std::size_t maxDepth_ = 0;
+    std::size_t elements_ = 0;
+    bool textOpen_ = false;
+    std::string pendingSpace_;
+};
+
+// XmlJsonHandler, который после события SAX сбрасывает буфер в поток, как
+// только в нём накопилось не меньше limit байт
+class XmlJsonFlushingHandler : public XmlJsonHandler {
+public:
+    XmlJsonFlushingHandler(bool preserveWhitespace, std::string& buffer, std::ostream& out, std::size_t limit)
+        : XmlJsonHandler(preserveWhitespace)
+        , buffer_(buffer)
+        , out_(out)
+        , limit_(limit) {
+        setOutput(&buffer_);
+    }
+
+    void endElement(const Poco::XML::XMLString& uri, const Poco::XML::XMLString& localName,
+                    const Poco::XML::XMLString& qname) override {
+        XmlJsonHandler::endElement(uri, localName, qname);
+        flushIfFull();
+    }
+
+    void characters(const Poco::XML::XMLChar ch[], int start, int length) override {
+        XmlJsonHandler::characters(ch, start, length);
+        flushIfFull();
+    }
+
+    void flush() {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+        if (!out_) {
+            throw Poco::WriteFileException("Error writing JSON stream");
+        }
+    }
+
+private:
+    void flushIfFull() {
+        if (buffer_.size() >= limit_) {
+            flush();
+        }
+    }
+
+    std::string& buffer_;
+    std::ostream& out_;
+    std::size_t limit_;
+};
+
+class XmlToJson {
+public:
+    static constexpr std::size_t DEFAULT_FLUSH_SIZE = 64 * 1024;
+
+    explicit XmlToJson(bool preserveWhitespace = false)
+        : handler_(preserveWhitespace) {
+        parser_.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACES, false);
+        parser_.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACE_PREFIXES, false);
+    }
+
+    XmlToJson(const XmlToJson&) = delete;
+    XmlToJson& operator=(const XmlToJson&) = delete;
+
+    // Сколько байт JSON копится перед записью в выходной поток
+    void setFlushSize(std::size_t size) {
+        flushSize_ = std::max<std::size_t>(size, 1);
+    }
+
+    std::size_t getFlushSize() const {
+        return flushSize_;
+    }
+
+    // Преобразует документ из памяти в out, заменяя прежнее содержимое;
+    // ёмкость out сохраняется между документами
+    void convert(const char* xml, std::size_t size, std::string& out) {
+        out.clear();
+        handler_.setOutput(&out);
+        parser_.setContentHandler(&handler_);
+        parser_.parseMemoryNP(xml, size);
+        elements_ = handler_.elements();
+    }
+
+    void convert(std::string_view xml, std::string& out) {
+        convert(xml.data(), xml.size(), out);
+    }
+
+    // Читает XML из in блоками и пишет JSON в out порциями по
+    // getFlushSize() байт
+    void convert(std::istream& in, std::ostream& out) {
+        XmlJsonFlushingHandler handler(handler_.getPreserveWhitespace(), buffer_, out, flushSize_);
+        buffer_.clear();
+        buffer_.reserve(flushSize_);
+        parser_.setContentHandler(&handler);
+        Poco::XML::InputSource source(in);
+        parser_.parse(&source);
+        handler.flush();
+        elements_ = handler.elements();
+    }
+
+    void convertFile(const std::string& path, std::ostream& out) {
+        Poco::FileInputStream in(path);
+        convert(in, out);
+    }
+
+    // Число элементов последнего документа
+    std::size_t elements() const {
+        return elements_;
+    }
+
+    // Память, удерживаемая между документами при потоковом преобразовании
+    std::size_t bufferCapacity() const {
+        return buffer_.capacity();
+    }
+
+private:
+    XmlJsonHandler handler_;
+    Poco::XML::SAXParser parser_;
+    std::string buffer_;
+    std::size_t flushSize_ = DEFAULT_FLUSH_SIZE;
+    std::size_t elements_ = 0;
+};
+
+namespace detail {
+
+inline void addText(Poco::JSON::Array& element, std::string& text, bool preserveWhitespace) {
+    if (!text.empty() && (preserveWhitespace || !isXmlSpace(text))) {
+        element.add(text);
+    }
+    text.clear();
+}
+
+inline void escapeXml(std::string_view text, bool attribute, std::string& out) {
+    for (char c : text) {
+        switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += attribute ? "&quot;" : "\""; break;
+            // Перевод строки и табуляция в атрибуте и \r везде иначе
+            // нормализуются при разборе
+            case '\t': out += attribute ? "&#9;" : "\t"; break;
+            case '\n': out += attribute ? "&#10;" : "\n"; break;
+            case '\r': out += "&#13;"; break;
+            default: out += c; break;
+        }
+    }
+}
+
+} // namespace detail
+
+// JsonML элемента DOM по тем же правилам, что XmlJsonHandler: атрибуты в
+// порядке документа, соседние текст и CDATA (в том числе разделённые
+// комментарием) - одна строка
+inline Poco::JSON::Array::Ptr domToJsonML(const Poco::XML::Element& element, bool preserveWhitespace = false) {
+    Poco::JSON::Array::Ptr result = new Poco::JSON::Array();
+    result->add(element.tagName());
+
+    const Poco::AutoPtr<Poco::XML::NamedNodeMap> attributes = element.attributes();
+    if (attributes->length() > 0) {
+        Poco::JSON::Object::Ptr object = new Poco::JSON::Object(Poco::JSON_PRESERVE_KEY_ORDER);
+        for (unsigned long i = 0; i < attributes->length(); ++i) {
+            const auto* attribute = static_cast<const Poco::XML::Attr*>(attributes->item(i));
+            object->set(attribute->nodeName(), attribute->getValue());
+        }
+        result->add(object);
+    }
+
+    std::string text;
+    for (const Poco::XML::Node* child = element.firstChild(); child != nullptr; child = child->nextSibling()) {
+        switch (child->nodeType()) {
+            case Poco::XML::Node::ELEMENT_NODE:
+                detail::addText(*result, text, preserveWhitespace);
+                result->add(domToJsonML(*static_cast<const Poco::XML::Element*>(child), preserveWhitespace));
+                break;
+            case Poco::XML::Node::TEXT_NODE:
+            case Poco::XML::Node::CDATA_SECTION_NODE:
+                text += static_cast<const Poco::XML::CharacterData*>(child)->data();
+                break;
+            default:
+                break;
+        }
+    }
+    detail::addText(*result, text, preserveWhitespace);
+    return result;
+}
+
+// Обратное преобразование: дописывает в out XML элемента JsonML. Объект
+// атрибутов обходится в порядке getNames(): для исходного порядка JSON
+// разбирается с ParseHandler(true). Элемент без детей пишется как <a/>
+inline void jsonmlToXml(const Poco::Dynamic::Var& value, std::string& out) {
+    if (value.type() != typeid(Poco::JSON::Array::Ptr)) {
+        throw Poco::DataFormatException("JsonML element must be an array");
+    }
+    const Poco::JSON::Array& element = *value.extract<Poco::JSON::Array::Ptr>();
+    if (element.size() == 0 || !element.get(0).isString()) {
+        throw Poco::DataFormatException("JsonML element must start with a tag name");
+    }
+    const std::string name = element.get(0).extract<std::string>();
+    out += '<';
+    out += name;
+
+    std::size_t i = 1;
+    if (element.size() > 1 && element.isObject(1)) {
+        const Poco::JSON::Object::Ptr attributes = element.getObject(1);
+        for (const auto& key : attributes->getNames()) {
+            out += ' ';
+            out += key;
+            out += "=\"";
+            detail::escapeXml(attributes->get(key).convert<std::string>(), true, out);
+            out += '"';
+        }
+        i = 2;
+    }
+    if (i == element.size()) {
+        out += "/>";
+        return;
+    }
+    out += '>';
+    for (; i < element.size(); ++i) {
+        const Poco::Dynamic::Var child = element.get(static_cast<unsigned>(i));
+        if (child.type() == typeid(Poco::JSON::Array::Ptr)) {
+            jsonmlToXml(child, out);
+        } else {
+            detail::escapeXml(child.convert<std::string>(), false, out);
+        }
+    }
+    out += "</";
+    out += name;
+    out += '>';
+}
+
+} // namespace pocotest
+
+#endif // POCO_TEST_APP_XML_TO_JSON_H